@@ -23,6 +23,7 @@
 #include "../core/filesystem/filesystem.hpp"
 #include "../core/filesystem/resource_manager.hpp"
 #include "../core/filesystem/package_manager.hpp"
+#include "../core/update_jobs.hpp"
 #include "../core/global_basic.hpp"
 
 using namespace std;
@@ -262,6 +263,12 @@ bool cAudio::Play_Sound(fs::path filename, int res_id /* = -1 */, int volume /*
         return 0;
     }
 
+    // played in the serial merge of a parallel update
+    if (cUpdate_Jobs::Is_Recording()) {
+        cUpdate_Jobs::Defer(std::bind(&cAudio::Play_Sound, this, filename, res_id, volume, loops));
+        return 1;
+    }
+
     // not available
     if (!File_Exists(filename)) {
         // add sound directory
@@ -413,6 +413,11 @@ bool cRandom_Sound::Is_Update_Valid()
     return 1;
 }
 
+bool cRandom_Sound::Can_Be_Dormant(void) const
+{
+    return 0;
+}
+
 bool cRandom_Sound::Is_Draw_Valid(void)
 {
     // if editor not enabled
@@ -84,6 +84,8 @@ namespace TSC {
         virtual bool Is_Update_Valid();
         // if draw is valid for the current state and position
         virtual bool Is_Draw_Valid(void);
+        // needs to be updated to fade out when the camera moves away
+        virtual bool Can_Be_Dormant(void) const;
 
         // if camera went out of range
         void Event_Out_Of_Range(void) const;
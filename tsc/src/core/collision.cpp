@@ -104,13 +104,156 @@ cObjectCollision* cObjectCollisionType::Find_First(const SpriteType type)
     return *std::find_if(objects.begin(), objects.end(), std::bind2nd(check_if_sprite_type(), type));
 }
 
+/* *** *** *** *** *** *** *** Buffers *** *** *** *** *** *** *** *** *** *** */
+
+/* released lists ready for reuse
+ * every thread has its own as collision checks also run in parallel updates
+*/
+template<class T>
+class cReleased_Lists {
+public:
+    ~cReleased_Lists(void)
+    {
+        for (typename vector<T*>::iterator itr = m_lists.begin(); itr != m_lists.end(); ++itr) {
+            delete *itr;
+        }
+    }
+
+    T* Acquire(void)
+    {
+        if (m_lists.empty()) {
+            return new T();
+        }
+
+        T* list = m_lists.back();
+        m_lists.pop_back();
+        return list;
+    }
+
+    void Release(T* list)
+    {
+        m_lists.push_back(list);
+    }
+
+private:
+    vector<T*> m_lists;
+};
+
+static thread_local cReleased_Lists<cObjectCollisionType> released_collision_lists;
+static thread_local cReleased_Lists<vector<cSprite*> > released_sprite_lists;
+
+cObjectCollisionType_Buffer::cObjectCollisionType_Buffer(void)
+{
+    m_list = released_collision_lists.Acquire();
+}
+
+cObjectCollisionType_Buffer::~cObjectCollisionType_Buffer(void)
+{
+    m_list->Delete_All();
+    released_collision_lists.Release(m_list);
+}
+
+cSprite_List_Buffer::cSprite_List_Buffer(void)
+{
+    m_list = released_sprite_lists.Acquire();
+}
+
+cSprite_List_Buffer::~cSprite_List_Buffer(void)
+{
+    m_list->clear();
+    released_sprite_lists.Release(m_list);
+}
+
 /* *** *** *** *** *** *** *** cObjectCollision *** *** *** *** *** *** *** *** *** *** */
 
+/* Released collision records
+ * the pointer to the next released record is stored in the record memory itself
+ * every thread has its own as records are also created in parallel updates
+ * a record can be released by another thread than the one creating it
+*/
+class cReleased_Collisions {
+public:
+    cReleased_Collisions(void)
+    {
+        m_first = NULL;
+        m_count = 0;
+    }
+
+    ~cReleased_Collisions(void)
+    {
+        while (m_first) {
+            void* ptr = m_first;
+            m_first = *static_cast<void**>(ptr);
+            ::operator delete(ptr);
+        }
+    }
+
+    void* Acquire(void)
+    {
+        if (!m_first) {
+            return NULL;
+        }
+
+        void* ptr = m_first;
+        m_first = *static_cast<void**>(ptr);
+        m_count--;
+        return ptr;
+    }
+
+    bool Release(void* ptr)
+    {
+        // more released records are given back to the system
+        if (m_count >= m_max) {
+            return 0;
+        }
+
+        *static_cast<void**>(ptr) = m_first;
+        m_first = ptr;
+        m_count++;
+        return 1;
+    }
+
+private:
+    static const unsigned int m_max = 4096;
+
+    void* m_first;
+    unsigned int m_count;
+};
+
+static thread_local cReleased_Collisions released_collisions;
+
+void* cObjectCollision::operator new(size_t size)
+{
+    if (size == sizeof(cObjectCollision)) {
+        void* ptr = released_collisions.Acquire();
+
+        if (ptr) {
+            return ptr;
+        }
+    }
+
+    return ::operator new(size);
+}
+
+void cObjectCollision::operator delete(void* ptr, size_t size)
+{
+    if (!ptr) {
+        return;
+    }
+
+    if (size == sizeof(cObjectCollision) && released_collisions.Release(ptr)) {
+        return;
+    }
+
+    ::operator delete(ptr);
+}
+
 cObjectCollision::cObjectCollision(void)
 {
     m_valid_type = COL_VTYPE_NOT_VALID;
     m_received = 0;
     m_obj = NULL;
+    m_check_obj = NULL;
     m_number = 0;
     m_direction = DIR_UNDEFINED;
     m_array = ARRAY_UNDEFINED;
@@ -241,6 +384,70 @@ ObjectDirection Get_Collision_Direction(const cSprite* base, const cSprite* col)
     }
 }
 
+/* Clip the movement fraction range [entry, exit] to the part in which
+ * the given ranges touch on one axis
+*/
+static bool Col_Box_Swept_Axis(float pos, float size, float move, float col_pos, float col_size, float& entry, float& exit)
+{
+    // movement offsets in which the ranges touch
+    const float offset_min = col_pos - (pos + size);
+    const float offset_max = (col_pos + col_size) - pos;
+
+    // not moving on this axis
+    if (Is_Float_Equal(move, 0.0f)) {
+        return offset_min <= 0.0f && offset_max >= 0.0f;
+    }
+
+    float time_min = offset_min / move;
+    float time_max = offset_max / move;
+
+    if (time_min > time_max) {
+        std::swap(time_min, time_max);
+    }
+
+    if (time_min > entry) {
+        entry = time_min;
+    }
+    if (time_max < exit) {
+        exit = time_max;
+    }
+
+    return entry <= exit;
+}
+
+bool Col_Box_Swept(const GL_rect& rect, float move_x, float move_y, const GL_rect& col_rect, float& time_entry, float& time_exit, bool* entry_x /* = NULL */)
+{
+    float x_entry = 0.0f;
+    float x_exit = 1.0f;
+
+    if (!Col_Box_Swept_Axis(rect.m_x, rect.m_w, move_x, col_rect.m_x, col_rect.m_w, x_entry, x_exit)) {
+        return 0;
+    }
+
+    float y_entry = 0.0f;
+    float y_exit = 1.0f;
+
+    if (!Col_Box_Swept_Axis(rect.m_y, rect.m_h, move_y, col_rect.m_y, col_rect.m_h, y_entry, y_exit)) {
+        return 0;
+    }
+
+    const float entry = (x_entry > y_entry) ? (x_entry) : (y_entry);
+    const float exit = (x_exit < y_exit) ? (x_exit) : (y_exit);
+
+    if (entry > exit) {
+        return 0;
+    }
+
+    // the vertical axis if both start touching at the same time
+    if (entry_x) {
+        *entry_x = x_entry > y_entry;
+    }
+
+    time_entry = entry;
+    time_exit = exit;
+    return 1;
+}
+
 // from SDL_collide ( Copyright (C) 2005 Amir Taaki ) - MIT License
 bool Col_Circle(float x1, float y1, float r1, float x2, float y2, float r2, int offset)
 {
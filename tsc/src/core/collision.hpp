@@ -35,6 +35,13 @@ namespace TSC {
         cObjectCollision(void);
         ~cObjectCollision(void);
 
+        /* Allocate from the released collision records if possible
+         * collision records are created and deleted many times each frame
+        */
+        static void* operator new(size_t size);
+        // Release to the reusable collision records
+        static void operator delete(void* ptr, size_t size);
+
         /* Set the collision direction
          * base - the base sprite
          * col - the colliding sprite
@@ -51,6 +58,10 @@ namespace TSC {
 
         // the object colliding with (only use it in the same frame for now !)
         cSprite* m_obj;
+        /* the object found by the collision check
+         * this is the collision proxy if m_obj is a merged tile
+        */
+        cSprite* m_check_obj;
         // colliding object number
         int m_number;
 
@@ -88,6 +99,69 @@ namespace TSC {
         cObjectCollision* Find_First(const SpriteType type);
     };
 
+    /* *** *** *** *** *** *** *** cObjectCollisionType_Buffer *** *** *** *** *** *** *** *** *** *** */
+
+    /* Reusable collision list for the lifetime of this object
+     * The list is taken from a stack of released lists and given back with
+     * its collisions deleted but its capacity kept, so collision checks
+     * don't allocate after the first frames. Nested checks (e.g. a
+     * collision handler moving another sprite) get their own list.
+    */
+    class cObjectCollisionType_Buffer {
+    public:
+        cObjectCollisionType_Buffer(void);
+        ~cObjectCollisionType_Buffer(void);
+
+        inline cObjectCollisionType& operator*(void) const
+        {
+            return *m_list;
+        }
+        inline cObjectCollisionType* operator->(void) const
+        {
+            return m_list;
+        }
+        inline operator cObjectCollisionType* (void) const
+        {
+            return m_list;
+        }
+
+    private:
+        // not copyable
+        cObjectCollisionType_Buffer(const cObjectCollisionType_Buffer&);
+        cObjectCollisionType_Buffer& operator=(const cObjectCollisionType_Buffer&);
+
+        cObjectCollisionType* m_list;
+    };
+
+    /* *** *** *** *** *** *** *** cSprite_List_Buffer *** *** *** *** *** *** *** *** *** *** */
+
+    // Reusable sprite list for the lifetime of this object, see cObjectCollisionType_Buffer
+    class cSprite_List_Buffer {
+    public:
+        cSprite_List_Buffer(void);
+        ~cSprite_List_Buffer(void);
+
+        inline vector<cSprite*>& operator*(void) const
+        {
+            return *m_list;
+        }
+        inline vector<cSprite*>* operator->(void) const
+        {
+            return m_list;
+        }
+        inline operator vector<cSprite*>* (void) const
+        {
+            return m_list;
+        }
+
+    private:
+        // not copyable
+        cSprite_List_Buffer(const cSprite_List_Buffer&);
+        cSprite_List_Buffer& operator=(const cSprite_List_Buffer&);
+
+        vector<cSprite*>* m_list;
+    };
+
     /* *** *** *** *** *** *** *** functions *** *** *** *** *** *** *** *** *** *** */
 
     /* Returns the collision direction
@@ -180,6 +254,18 @@ namespace TSC {
         return 1;
     };
 
+    /*
+     * Swept bounding box collision test
+     * Checks if rect touches col_rect while it is moved by move_x and move_y
+     * touching edges count as a collision like in GL_rect::Intersects()
+     *
+     * Parameters:
+     * time_entry, time_exit - set to the range of the movement (0 to 1) in which they touch
+     * (time_entry is 0 if they already touch at the start)
+     * entry_x - if given set to true if the horizontal axis is the last to start touching
+    */
+    bool Col_Box_Swept(const GL_rect& rect, float move_x, float move_y, const GL_rect& col_rect, float& time_entry, float& time_exit, bool* entry_x = NULL);
+
     /*
      * tests whether 2 circles intersect
      *
@@ -139,11 +139,15 @@ void cEditor_Item_Object::Init(cSprite* sprite)
     // get scale
     preview_scale = pVideo->Get_Scale(sprite_obj->m_start_image, static_cast<float>(pPreferences->m_editor_item_image_size) * 2.0f, static_cast<float>(pPreferences->m_editor_item_image_size));
 
+    const cGL_Surface* image = sprite_obj->m_start_image;
+    // the image may only be a part of an atlas page
+    const CEGUI::Size texture_size(image->m_tex_w / (image->m_tex_x2 - image->m_tex_x1), image->m_tex_h / (image->m_tex_y2 - image->m_tex_y1));
+
     // create CEGUI link
-    cEditor_CEGUI_Texture* texture = new cEditor_CEGUI_Texture(*pGuiRenderer, sprite_obj->m_start_image->m_image, CEGUI::Size(sprite_obj->m_start_image->m_tex_w, sprite_obj->m_start_image->m_tex_h));
+    cEditor_CEGUI_Texture* texture = new cEditor_CEGUI_Texture(*pGuiRenderer, image->m_image, texture_size);
     CEGUI::String imageset_name = "editor_item " + list_text->getText() + " " + CEGUI::PropertyHelper::uintToString(m_parent->getItemCount());
     m_image = &CEGUI::ImagesetManager::getSingleton().create(imageset_name, *texture);
-    m_image->defineImage("default", CEGUI::Point(0, 0), texture->getSize(), CEGUI::Point(0, 0));
+    m_image->defineImage("default", CEGUI::Point(image->m_tex_x1 * texture_size.d_width, image->m_tex_y1 * texture_size.d_height), CEGUI::Size(image->m_tex_w, image->m_tex_h), CEGUI::Point(0, 0));
 }
 
 CEGUI::Size cEditor_Item_Object::getPixelSize(void) const
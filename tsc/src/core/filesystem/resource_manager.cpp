@@ -259,6 +259,16 @@ fs::path cResource_Manager::Get_Game_Scripting(std::string script)
     return Get_Game_Scripting_Directory() / utf8_to_path(script);
 }
 
+fs::path cResource_Manager::Get_Game_Particles_Directory()
+{
+    return m_paths.game_data_dir / utf8_to_path(GAME_PARTICLES_DIR);
+}
+
+fs::path cResource_Manager::Get_Game_Particles(std::string particles)
+{
+    return Get_Game_Particles_Directory() / utf8_to_path(particles);
+}
+
 fs::path cResource_Manager::Get_Game_Icon_Directory()
 {
     return m_paths.game_data_dir / utf8_to_path(GAME_ICON_DIR);
@@ -68,6 +68,7 @@ namespace TSC {
         boost::filesystem::path Get_Game_Music_Directory();
         boost::filesystem::path Get_Game_Editor_Directory();
         boost::filesystem::path Get_Game_Scripting_Directory();
+        boost::filesystem::path Get_Game_Particles_Directory();
         boost::filesystem::path Get_Game_Icon_Directory();
 
         // CEGUI data paths
@@ -88,6 +89,7 @@ namespace TSC {
         boost::filesystem::path Get_Game_Music(std::string music);
         boost::filesystem::path Get_Game_Editor(std::string editor);
         boost::filesystem::path Get_Game_Scripting(std::string script);
+        boost::filesystem::path Get_Game_Particles(std::string particles);
         boost::filesystem::path Get_Game_Icon(std::string icon);
 
         // Get the various directories in the user’s data directory
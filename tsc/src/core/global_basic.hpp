@@ -22,11 +22,6 @@
 #define _WIN32_IE 0x0500
 #endif
 
-/* uncomment to enable experimental rendering in a thread
-* still randomly crashes because gl functions are called while the render thread is active
-*/
-//#define TSC_RENDER_THREAD_TEST
-
 /* *** *** *** *** *** *** *** Debugging *** *** *** *** *** *** *** *** *** *** */
 
 #if defined(_MSC_VER) && defined(_DEBUG)
@@ -48,6 +43,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <climits>
+#include <cfloat>
+#include <cstring>
+#include <cstdint>
 #include <cctype>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -63,11 +61,16 @@
 #include <math.h>
 #include <functional>
 #include <set>
+#include <queue>
 #include <algorithm>
 #include <stdexcept>
+#include <exception>
+#include <atomic>
 #include <map>
+#include <unordered_map>
 #include <utility>
 #include <iomanip>
+#include <typeinfo>
 
 // TSC build configuration header
 #include "config.hpp"
@@ -77,6 +80,9 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/convenience.hpp>
 #include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/tss.hpp>
 #include <boost/chrono.hpp>
 #include <boost/system/error_code.hpp>
 
@@ -84,6 +90,10 @@
 #include <glibmm.h>
 #include <libxml++/libxml++.h>
 
+// GLEW
+// Must be included before any other OpenGL header
+#include <GL/glew.h>
+
 // CEGUI
 // Must be included before X11, which have #defines such as
 // None, True, and False that screw CEGUI declarations.
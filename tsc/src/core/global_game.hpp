@@ -164,6 +164,7 @@ namespace TSC {
 #define GAME_SCHEMA_DIR "schema"
 #define GAME_TRANSLATION_DIR "translations"
 #define GAME_SCRIPTING_DIR "scripting"
+#define GAME_PARTICLES_DIR "particles"
 // GUI
 #define GUI_SCHEME_DIR "gui/schemes"
 #define GUI_IMAGESET_DIR "gui/imagesets"
@@ -254,6 +255,7 @@ namespace TSC {
         TYPE_ANIMATION = 61,
         TYPE_PARTICLE_EMITTER = 65,
         TYPE_PATH = 63,
+        TYPE_COLLISION_PROXY = 74,
         // HUD
         TYPE_HUD_POINTS = 12,
         TYPE_HUD_TIME = 13,
@@ -405,6 +407,7 @@ namespace TSC {
 
     class cCamera;
     class cCircle_Request;
+    class cCollision_Proxy;
     class cEditor_Object_Settings_Item;
     class cGL_Surface;
     class cGradient_Request;
@@ -428,7 +431,10 @@ namespace TSC {
     class cSize_Float;
     class cSize_Int;
     class cSprite_Manager;
+    class cStatic_Geometry;
     class cSurface_Request;
+    class cTexture_Atlas;
+    class cUpdate_Jobs;
     class cSprite;
     class cBackground_Manager;
     class cWorld_Sprite_Manager;
@@ -23,6 +23,7 @@
 #include "../level/level.hpp"
 #include "../gui/menu.hpp"
 #include "../core/framerate.hpp"
+#include "../core/update_jobs.hpp"
 #include "../video/font.hpp"
 #include "../user/preferences.hpp"
 #include "../audio/sound_manager.hpp"
@@ -37,6 +38,9 @@
 #include "../user/savegame/savegame.hpp"
 #include "../input/keyboard.hpp"
 #include "../video/renderer.hpp"
+#include "../video/texture_atlas.hpp"
+#include "../video/particle_budget.hpp"
+#include "../video/particle_presets.hpp"
 #include "../core/i18n.hpp"
 #include "../gui/generic.hpp"
 
@@ -203,11 +207,7 @@ int main(int argc, char** argv)
             Draw_Game();
 
             // render
-#ifdef TSC_RENDER_THREAD_TEST
-            pVideo->Render(1);
-#else
-            pVideo->Render();
-#endif
+            pVideo->Render(pPreferences->m_video_render_thread);
 
             // update speedfactor
             pFramerate->Update();
@@ -239,9 +239,15 @@ void Init_Game(void)
     pAudio = new cAudio();
     pFont = new cFont_Manager();
     pFramerate = new cFramerate();
+    pUpdate_Jobs = new cUpdate_Jobs();
+    pParticle_Budget = new cParticle_Budget();
+    pGL_State = new cGL_State();
+    pSurface_Shader = new cSurface_Shader();
+    pParticle_Shader = new cParticle_Shader();
     pRenderer = new cRenderQueue(200);
     pRenderer_current = new cRenderQueue(200);
     pImage_Manager = new cImage_Manager();
+    pTexture_Atlas = new cTexture_Atlas();
     pSound_Manager = new cSound_Manager();
     pSettingsParser = new cImage_Settings_Parser();
 
@@ -297,6 +303,10 @@ void Init_Game(void)
     // initialize image cache
     pVideo->Init_Image_Cache(0, 1);
 
+    debug_print("Loading particle presets\n");
+    pParticle_Preset_Manager = new cParticle_Preset_Manager();
+    pParticle_Preset_Manager->Load(pResource_Manager->Get_Game_Particles("presets.xml"));
+
     // Init Stage 3 - game classes
     // note : set any sprite manager as it is set again on game mode switch
     pHud_Manager = new cHud_Manager(pActive_Level->m_sprite_manager);
@@ -334,6 +344,11 @@ void Exit_Game(void)
         pPreferences->Save();
     }
 
+    // everything below may use opengl
+    if (pVideo) {
+        pVideo->Render_Thread_Stop();
+    }
+
     pLevel_Manager->Unload();
     pMenuCore->m_handler->m_level->Unload();
 
@@ -417,6 +432,12 @@ void Exit_Game(void)
         pMenuCore = NULL;
     }
 
+    // after the animation managers gave their emitters back
+    if (pParticle_Preset_Manager) {
+        delete pParticle_Preset_Manager;
+        pParticle_Preset_Manager = NULL;
+    }
+
     if (pRenderer) {
         delete pRenderer;
         pRenderer = NULL;
@@ -427,6 +448,21 @@ void Exit_Game(void)
         pRenderer_current = NULL;
     }
 
+    if (pParticle_Shader) {
+        delete pParticle_Shader;
+        pParticle_Shader = NULL;
+    }
+
+    if (pSurface_Shader) {
+        delete pSurface_Shader;
+        pSurface_Shader = NULL;
+    }
+
+    if (pGL_State) {
+        delete pGL_State;
+        pGL_State = NULL;
+    }
+
     if (pGuiSystem) {
         CEGUI::ResourceProvider* rp = pGuiSystem->getResourceProvider();
         CEGUI::Logger* logger = CEGUI::Logger::getSingletonPtr();
@@ -441,6 +477,11 @@ void Exit_Game(void)
         pGuiRenderer = NULL;
     }
 
+    if (pTexture_Atlas) {
+        delete pTexture_Atlas;
+        pTexture_Atlas = NULL;
+    }
+
     if (pVideo) {
         delete pVideo;
         pVideo = NULL;
@@ -456,6 +497,16 @@ void Exit_Game(void)
         pSettingsParser = NULL;
     }
 
+    if (pUpdate_Jobs) {
+        delete pUpdate_Jobs;
+        pUpdate_Jobs = NULL;
+    }
+
+    if (pParticle_Budget) {
+        delete pParticle_Budget;
+        pParticle_Budget = NULL;
+    }
+
     if (pFont) {
         delete pFont;
         pFont = NULL;
@@ -618,6 +669,7 @@ void Update_Game(void)
 
     // performance measuring
     pFramerate->m_perf_last_ticks = TSC_GetTicks();
+    pParticle_Budget->Begin_Frame();
 
     // ## update
     if (Game_Mode == MODE_LEVEL) {
@@ -665,6 +717,8 @@ void Draw_Game(void)
 
     // update performance timer
     pFramerate->m_perf_timer[PERF_DRAW_MOUSE]->Update();
+    // the particle quality follows the update and draw time
+    pParticle_Budget->End_Frame();
 }
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -0,0 +1,591 @@
+/***************************************************************************
+ * spatial_hash.cpp  -  Uniform grid for sprite collision and drawing queries
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/spatial_hash.hpp"
+#include "../objects/sprite.hpp"
+
+namespace TSC {
+
+/* *** *** *** *** *** *** cSpatial_Hash *** *** *** *** *** *** *** *** *** *** *** */
+
+// order sort
+struct spatial_entry_order_sort {
+    template<class T> bool operator()(const T* a, const T* b) const
+    {
+        return a->m_order < b->m_order;
+    }
+};
+
+// static entry center sort along one axis
+struct spatial_entry_center_sort {
+    spatial_entry_center_sort(bool vertical)
+        : m_vertical(vertical) {}
+
+    template<class T> bool operator()(const T* a, const T* b) const
+    {
+        if (m_vertical) {
+            return a->m_bounds.m_y1 + a->m_bounds.m_y2 < b->m_bounds.m_y1 + b->m_bounds.m_y2;
+        }
+
+        return a->m_bounds.m_x1 + a->m_bounds.m_x2 < b->m_bounds.m_x1 + b->m_bounds.m_x2;
+    }
+
+    bool m_vertical;
+};
+
+// maximum entries in a static tree leaf
+static const size_t static_leaf_size = 4;
+
+// Convert a coordinate into a cell index clamped to the int range
+static int Get_Cell_Index(float pos, float cell_size)
+{
+    float cell = floorf(pos / cell_size);
+
+    // also catches NaN
+    if (!(cell > static_cast<float>(INT_MIN / 2))) {
+        return INT_MIN / 2;
+    }
+    if (cell > static_cast<float>(INT_MAX / 2)) {
+        return INT_MAX / 2;
+    }
+
+    return static_cast<int>(cell);
+}
+
+cSpatial_Hash::cSpatial_Hash(float cell_size /* = 256.0f */, bool draw_bounds /* = 0 */)
+    : m_cell_size(cell_size), m_draw_bounds(draw_bounds)
+{
+    m_query_counter = 0;
+}
+
+cSpatial_Hash::~cSpatial_Hash(void)
+{
+    Clear();
+}
+
+void cSpatial_Hash::Insert(cSprite* sprite, unsigned long order)
+{
+    if (!sprite) {
+        return;
+    }
+
+    // already registered
+    if (Is_Registered(sprite)) {
+        Set_Order(sprite, order);
+        Update(sprite);
+        return;
+    }
+
+    Entry& entry = m_entries[sprite];
+    entry.m_sprite = sprite;
+    entry.m_order = order;
+    entry.m_in_cells = 0;
+    entry.m_large = 0;
+    entry.m_static = 0;
+    entry.m_static_index = 0;
+    entry.m_static_leaf = -1;
+    entry.m_query_stamp = m_query_counter;
+
+    if (!sprite->m_auto_destroy) {
+        entry.m_range = Get_Cell_Range(Get_Sprite_Bounds(sprite));
+        Link_Cells(&entry);
+    }
+}
+
+void cSpatial_Hash::Remove(const cSprite* sprite)
+{
+    Entry_Map::iterator itr = m_entries.find(sprite);
+
+    // not registered
+    if (itr == m_entries.end()) {
+        return;
+    }
+
+    Entry* entry = &itr->second;
+
+    // keep the static tree valid
+    if (entry->m_static) {
+        m_static_entries[entry->m_static_index] = NULL;
+        Refit_Static(entry);
+    }
+
+    Unlink_Cells(entry);
+    m_entries.erase(itr);
+}
+
+bool cSpatial_Hash::Update(const cSprite* sprite)
+{
+    Entry_Map::iterator itr = m_entries.find(sprite);
+
+    // not registered
+    if (itr == m_entries.end()) {
+        return 0;
+    }
+
+    Entry* entry = &itr->second;
+
+    // baked sprite moved
+    if (entry->m_static) {
+        Bounds bounds = Get_Sprite_Bounds(sprite);
+
+        if (bounds.m_x1 != entry->m_bounds.m_x1 || bounds.m_y1 != entry->m_bounds.m_y1 || bounds.m_x2 != entry->m_bounds.m_x2 || bounds.m_y2 != entry->m_bounds.m_y2) {
+            entry->m_bounds = bounds;
+            Refit_Static(entry);
+        }
+
+        return 1;
+    }
+
+    // destroyed sprites never collide
+    if (sprite->m_auto_destroy) {
+        Unlink_Cells(entry);
+        return 1;
+    }
+
+    Cell_Range range = Get_Cell_Range(Get_Sprite_Bounds(sprite));
+
+    // still in the same cells
+    if (entry->m_in_cells && range == entry->m_range) {
+        return 1;
+    }
+
+    Unlink_Cells(entry);
+    entry->m_range = range;
+    Link_Cells(entry);
+
+    return 1;
+}
+
+void cSpatial_Hash::Set_Order(const cSprite* sprite, unsigned long order)
+{
+    Entry_Map::iterator itr = m_entries.find(sprite);
+
+    if (itr != m_entries.end()) {
+        itr->second.m_order = order;
+    }
+}
+
+unsigned long cSpatial_Hash::Get_Order(const cSprite* sprite) const
+{
+    Entry_Map::const_iterator itr = m_entries.find(sprite);
+
+    if (itr == m_entries.end()) {
+        return 0;
+    }
+
+    return itr->second.m_order;
+}
+
+bool cSpatial_Hash::Is_Registered(const cSprite* sprite) const
+{
+    return m_entries.find(sprite) != m_entries.end();
+}
+
+void cSpatial_Hash::Clear(void)
+{
+    m_entries.clear();
+    m_cells.clear();
+    m_large_entries.clear();
+    m_static_entries.clear();
+    m_static_nodes.clear();
+    m_query_entries.clear();
+}
+
+void cSpatial_Hash::Bake_Static(const vector<cSprite*>& sprites)
+{
+    // previously baked sprites become dynamic
+    for (Entry_List::iterator itr = m_static_entries.begin(); itr != m_static_entries.end(); ++itr) {
+        if (*itr) {
+            Unbake_Entry(*itr);
+        }
+    }
+
+    m_static_entries.clear();
+    m_static_nodes.clear();
+
+    for (vector<cSprite*>::const_iterator itr = sprites.begin(); itr != sprites.end(); ++itr) {
+        Entry_Map::iterator entry_itr = m_entries.find(*itr);
+
+        // not registered
+        if (entry_itr == m_entries.end()) {
+            continue;
+        }
+
+        Entry* entry = &entry_itr->second;
+
+        // already added
+        if (entry->m_static) {
+            continue;
+        }
+
+        Unlink_Cells(entry);
+        entry->m_static = 1;
+        entry->m_bounds = Get_Sprite_Bounds(entry->m_sprite);
+        m_static_entries.push_back(entry);
+    }
+
+    if (m_static_entries.empty()) {
+        return;
+    }
+
+    // a binary tree has less than two nodes per leaf
+    m_static_nodes.reserve((m_static_entries.size() / static_leaf_size + 1) * 2);
+    Build_Static_Node(0, m_static_entries.size(), -1);
+}
+
+void cSpatial_Hash::Get_Candidates(vector<cSprite*>& candidates, const GL_rect& rect) const
+{
+    Bounds bounds;
+    bounds.m_x1 = std::min(rect.m_x, rect.m_x + rect.m_w);
+    bounds.m_y1 = std::min(rect.m_y, rect.m_y + rect.m_h);
+    bounds.m_x2 = std::max(rect.m_x, rect.m_x + rect.m_w);
+    bounds.m_y2 = std::max(rect.m_y, rect.m_y + rect.m_h);
+
+    Collect(candidates, bounds);
+}
+
+void cSpatial_Hash::Get_Candidates(vector<cSprite*>& candidates, const GL_Circle& circle) const
+{
+    /* Col_Circle() allows a distance of 1 between the circles and
+     * the sprite bounds already contain the approximated sprite circle
+    */
+    float radius = fabs(circle.Get_Radius()) + 1.0f;
+
+    Bounds bounds;
+    bounds.m_x1 = circle.Get_X() - radius;
+    bounds.m_y1 = circle.Get_Y() - radius;
+    bounds.m_x2 = circle.Get_X() + radius;
+    bounds.m_y2 = circle.Get_Y() + radius;
+
+    Collect(candidates, bounds);
+}
+
+cSpatial_Hash::Cell_Range cSpatial_Hash::Get_Cell_Range(const Bounds& bounds) const
+{
+    Cell_Range range;
+
+    range.m_x1 = Get_Cell_Index(bounds.m_x1, m_cell_size);
+    range.m_y1 = Get_Cell_Index(bounds.m_y1, m_cell_size);
+    range.m_x2 = Get_Cell_Index(bounds.m_x2, m_cell_size);
+    range.m_y2 = Get_Cell_Index(bounds.m_y2, m_cell_size);
+
+    return range;
+}
+
+cSpatial_Hash::Bounds cSpatial_Hash::Get_Sprite_Bounds(const cSprite* sprite) const
+{
+    Bounds bounds;
+
+    if (m_draw_bounds) {
+        GL_rect draw_rect;
+
+        // can draw anywhere and ends up in the large list
+        if (!sprite->Get_Draw_Rect(draw_rect)) {
+            bounds.m_x1 = -FLT_MAX;
+            bounds.m_y1 = -FLT_MAX;
+            bounds.m_x2 = FLT_MAX;
+            bounds.m_y2 = FLT_MAX;
+
+            return bounds;
+        }
+
+        bounds.m_x1 = std::min(draw_rect.m_x, draw_rect.m_x + draw_rect.m_w);
+        bounds.m_y1 = std::min(draw_rect.m_y, draw_rect.m_y + draw_rect.m_h);
+        bounds.m_x2 = std::max(draw_rect.m_x, draw_rect.m_x + draw_rect.m_w);
+        bounds.m_y2 = std::max(draw_rect.m_y, draw_rect.m_y + draw_rect.m_h);
+
+        return bounds;
+    }
+
+    const GL_rect& rect = sprite->m_col_rect;
+
+    // circle used by Col_Circle() for rects
+    float radius = fabs(rect.m_w + rect.m_h) / 4;
+    float middle_x = rect.m_x + rect.m_w / 2;
+    float middle_y = rect.m_y + rect.m_h / 2;
+
+    bounds.m_x1 = std::min(std::min(rect.m_x, rect.m_x + rect.m_w), middle_x - radius);
+    bounds.m_y1 = std::min(std::min(rect.m_y, rect.m_y + rect.m_h), middle_y - radius);
+    bounds.m_x2 = std::max(std::max(rect.m_x, rect.m_x + rect.m_w), middle_x + radius);
+    bounds.m_y2 = std::max(std::max(rect.m_y, rect.m_y + rect.m_h), middle_y + radius);
+
+    return bounds;
+}
+
+void cSpatial_Hash::Link_Cells(Entry* entry)
+{
+    if (entry->m_in_cells) {
+        return;
+    }
+
+    const Cell_Range& range = entry->m_range;
+
+    // huge sprites are checked on every query
+    if (range.Get_Count() > m_max_entry_cells) {
+        m_large_entries.push_back(entry);
+        entry->m_large = 1;
+    }
+    else {
+        for (int x = range.m_x1; x <= range.m_x2; x++) {
+            for (int y = range.m_y1; y <= range.m_y2; y++) {
+                m_cells[Get_Cell_Key(x, y)].push_back(entry);
+            }
+        }
+
+        entry->m_large = 0;
+    }
+
+    entry->m_in_cells = 1;
+}
+
+void cSpatial_Hash::Unlink_Cells(Entry* entry)
+{
+    if (!entry->m_in_cells) {
+        return;
+    }
+
+    const Cell_Range& range = entry->m_range;
+
+    if (entry->m_large) {
+        Entry_List::iterator itr = std::find(m_large_entries.begin(), m_large_entries.end(), entry);
+
+        if (itr != m_large_entries.end()) {
+            m_large_entries.erase(itr);
+        }
+
+        entry->m_large = 0;
+        entry->m_in_cells = 0;
+        return;
+    }
+
+    for (int x = range.m_x1; x <= range.m_x2; x++) {
+        for (int y = range.m_y1; y <= range.m_y2; y++) {
+            Cell_Map::iterator cell_itr = m_cells.find(Get_Cell_Key(x, y));
+
+            // should not happen
+            if (cell_itr == m_cells.end()) {
+                continue;
+            }
+
+            Entry_List& cell = cell_itr->second;
+            Entry_List::iterator itr = std::find(cell.begin(), cell.end(), entry);
+
+            if (itr != cell.end()) {
+                // order inside a cell does not matter
+                *itr = cell.back();
+                cell.pop_back();
+            }
+
+            if (cell.empty()) {
+                m_cells.erase(cell_itr);
+            }
+        }
+    }
+
+    entry->m_in_cells = 0;
+}
+
+void cSpatial_Hash::Collect(vector<cSprite*>& candidates, const Bounds& bounds) const
+{
+    Cell_Range range = Get_Cell_Range(bounds);
+
+    m_query_counter++;
+    m_query_entries.clear();
+
+    // less cells used than requested
+    if (range.Get_Count() > m_cells.size()) {
+        for (Cell_Map::const_iterator cell_itr = m_cells.begin(); cell_itr != m_cells.end(); ++cell_itr) {
+            if (range.Contains(Get_Cell_Key_X(cell_itr->first), Get_Cell_Key_Y(cell_itr->first))) {
+                Collect_Cell(cell_itr->second);
+            }
+        }
+    }
+    else {
+        for (int x = range.m_x1; x <= range.m_x2; x++) {
+            for (int y = range.m_y1; y <= range.m_y2; y++) {
+                Cell_Map::const_iterator cell_itr = m_cells.find(Get_Cell_Key(x, y));
+
+                // empty cell
+                if (cell_itr == m_cells.end()) {
+                    continue;
+                }
+
+                Collect_Cell(cell_itr->second);
+            }
+        }
+    }
+
+    Collect_Cell(m_large_entries);
+    Collect_Static(bounds);
+
+    // same order as the objects array
+    std::sort(m_query_entries.begin(), m_query_entries.end(), spatial_entry_order_sort());
+
+    for (Entry_List::const_iterator itr = m_query_entries.begin(); itr != m_query_entries.end(); ++itr) {
+        candidates.push_back((*itr)->m_sprite);
+    }
+}
+
+void cSpatial_Hash::Collect_Cell(const Entry_List& cell) const
+{
+    for (Entry_List::const_iterator itr = cell.begin(); itr != cell.end(); ++itr) {
+        Entry* entry = (*itr);
+
+        // already found in another cell
+        if (entry->m_query_stamp == m_query_counter) {
+            continue;
+        }
+
+        entry->m_query_stamp = m_query_counter;
+        m_query_entries.push_back(entry);
+    }
+}
+
+void cSpatial_Hash::Collect_Static(const Bounds& bounds) const
+{
+    if (m_static_nodes.empty()) {
+        return;
+    }
+
+    // nodes left to check
+    vector<int>& stack = m_static_stack;
+    stack.clear();
+    stack.push_back(0);
+
+    while (!stack.empty()) {
+        const Static_Node& node = m_static_nodes[stack.back()];
+        stack.pop_back();
+
+        if (!node.m_bounds.Intersects(bounds)) {
+            continue;
+        }
+
+        // leaf
+        if (node.m_count) {
+            for (size_t i = node.m_first; i < node.m_first + node.m_count; i++) {
+                Entry* entry = m_static_entries[i];
+
+                // removed
+                if (!entry || !entry->m_bounds.Intersects(bounds)) {
+                    continue;
+                }
+
+                entry->m_query_stamp = m_query_counter;
+                m_query_entries.push_back(entry);
+            }
+        }
+        else {
+            stack.push_back(node.m_left);
+            stack.push_back(node.m_right);
+        }
+    }
+}
+
+int cSpatial_Hash::Build_Static_Node(size_t first, size_t last, int parent)
+{
+    int index = static_cast<int>(m_static_nodes.size());
+    m_static_nodes.push_back(Static_Node());
+
+    Static_Node node;
+    node.m_parent = parent;
+    node.m_left = -1;
+    node.m_right = -1;
+    node.m_first = first;
+    node.m_count = 0;
+    node.m_bounds = m_static_entries[first]->m_bounds;
+
+    for (size_t i = first + 1; i < last; i++) {
+        node.m_bounds.Add(m_static_entries[i]->m_bounds);
+    }
+
+    // leaf
+    if (last - first <= static_leaf_size) {
+        node.m_count = last - first;
+
+        for (size_t i = first; i < last; i++) {
+            m_static_entries[i]->m_static_index = i;
+            m_static_entries[i]->m_static_leaf = index;
+        }
+    }
+    // split at the median of the longer axis
+    else {
+        size_t middle = first + (last - first) / 2;
+        bool vertical = node.m_bounds.m_y2 - node.m_bounds.m_y1 > node.m_bounds.m_x2 - node.m_bounds.m_x1;
+
+        std::nth_element(m_static_entries.begin() + first, m_static_entries.begin() + middle, m_static_entries.begin() + last, spatial_entry_center_sort(vertical));
+
+        node.m_left = Build_Static_Node(first, middle, index);
+        node.m_right = Build_Static_Node(middle, last, index);
+    }
+
+    m_static_nodes[index] = node;
+
+    return index;
+}
+
+void cSpatial_Hash::Refit_Static(Entry* entry)
+{
+    int index = entry->m_static_leaf;
+
+    if (index < 0) {
+        return;
+    }
+
+    // leaf
+    Static_Node& leaf = m_static_nodes[index];
+    bool found = 0;
+
+    for (size_t i = leaf.m_first; i < leaf.m_first + leaf.m_count; i++) {
+        if (!m_static_entries[i]) {
+            continue;
+        }
+
+        if (!found) {
+            leaf.m_bounds = m_static_entries[i]->m_bounds;
+            found = 1;
+        }
+        else {
+            leaf.m_bounds.Add(m_static_entries[i]->m_bounds);
+        }
+    }
+
+    // parents
+    index = leaf.m_parent;
+
+    while (index >= 0) {
+        Static_Node& node = m_static_nodes[index];
+
+        node.m_bounds = m_static_nodes[node.m_left].m_bounds;
+        node.m_bounds.Add(m_static_nodes[node.m_right].m_bounds);
+
+        index = node.m_parent;
+    }
+}
+
+void cSpatial_Hash::Unbake_Entry(Entry* entry)
+{
+    entry->m_static = 0;
+    entry->m_static_index = 0;
+    entry->m_static_leaf = -1;
+
+    if (!entry->m_sprite->m_auto_destroy) {
+        entry->m_range = Get_Cell_Range(Get_Sprite_Bounds(entry->m_sprite));
+        Link_Cells(entry);
+    }
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
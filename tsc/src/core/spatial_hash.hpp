@@ -0,0 +1,246 @@
+/***************************************************************************
+ * spatial_hash.h  -  Uniform grid for sprite collision and drawing queries
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_SPATIAL_HASH_HPP
+#define TSC_SPATIAL_HASH_HPP
+
+#include "../core/global_basic.hpp"
+#include "../core/global_game.hpp"
+#include "../core/math/rect.hpp"
+#include "../core/math/circle.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** cSpatial_Hash *** *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Uniform grid over the collision rects of the sprites of a
+     * sprite manager. Every registered sprite is stored in each
+     * cell its bounds touch, so a query only has to look at the
+     * sprites of the cells it overlaps instead of at all sprites.
+     *
+     * Sprites that never move can be baked into an immutable bounding
+     * volume hierarchy instead. It is built once per level and only
+     * refitted if a baked sprite still moves (e.g. in the editor), so
+     * the cells only hold the few dynamic sprites.
+     *
+     * With draw bounds the rects sprites are drawn in are used instead
+     * of the collision rects, to find the sprites visible on the screen.
+     *
+     * Queries only return candidates, the caller still has to do the
+     * exact intersection test. Candidates are returned in ascending
+     * order, which the sprite manager keeps equal to the position in
+     * its objects array so the results match a linear scan.
+     */
+    class cSpatial_Hash {
+    public:
+        cSpatial_Hash(float cell_size = 256.0f, bool draw_bounds = 0);
+        ~cSpatial_Hash(void);
+
+        // Register the sprite with the given order
+        void Insert(cSprite* sprite, unsigned long order);
+        // Unregister the sprite
+        void Remove(const cSprite* sprite);
+        /* Move the sprite into the cells matching its current collision rect
+         * returns false and does nothing if the sprite is not registered
+         * destroyed sprites are removed from all cells but stay registered
+        */
+        bool Update(const cSprite* sprite);
+        // Set the order of a registered sprite
+        void Set_Order(const cSprite* sprite, unsigned long order);
+        // Return the order of a registered sprite or 0 if not registered
+        unsigned long Get_Order(const cSprite* sprite) const;
+        // Return true if the sprite is registered
+        bool Is_Registered(const cSprite* sprite) const;
+        // Unregister all sprites
+        void Clear(void);
+
+        /* Move the given registered sprites into the static tree and rebuild it
+         * previously baked sprites not in the list become dynamic again
+        */
+        void Bake_Static(const vector<cSprite*>& sprites);
+        // Return the number of baked sprites
+        inline size_t Get_Static_Count(void) const
+        {
+            return m_static_entries.size();
+        }
+
+        /* Add all sprites of the cells overlapping the given rect
+         * each sprite is only added once and in ascending order
+        */
+        void Get_Candidates(vector<cSprite*>& candidates, const GL_rect& rect) const;
+        /* Add all sprites of the cells overlapping the given circle
+         * also finds sprites only touched by the circle approximation of Col_Circle()
+        */
+        void Get_Candidates(vector<cSprite*>& candidates, const GL_Circle& circle) const;
+
+        // Return the number of registered sprites
+        inline size_t size(void) const
+        {
+            return m_entries.size();
+        }
+
+        // size of one cell in pixels
+        const float m_cell_size;
+        // if the draw rects are used instead of the collision rects
+        const bool m_draw_bounds;
+
+    private:
+        // float bounds
+        struct Bounds {
+            float m_x1;
+            float m_y1;
+            float m_x2;
+            float m_y2;
+
+            // Return true if the bounds touch
+            inline bool Intersects(const Bounds& b) const
+            {
+                return !(b.m_x2 < m_x1 || b.m_x1 > m_x2 || b.m_y2 < m_y1 || b.m_y1 > m_y2);
+            }
+            // Grow to include the given bounds
+            inline void Add(const Bounds& b)
+            {
+                m_x1 = std::min(m_x1, b.m_x1);
+                m_y1 = std::min(m_y1, b.m_y1);
+                m_x2 = std::max(m_x2, b.m_x2);
+                m_y2 = std::max(m_y2, b.m_y2);
+            }
+        };
+
+        // cell index range
+        struct Cell_Range {
+            int m_x1;
+            int m_y1;
+            int m_x2;
+            int m_y2;
+
+            inline bool operator == (const Cell_Range& r) const
+            {
+                return m_x1 == r.m_x1 && m_y1 == r.m_y1 && m_x2 == r.m_x2 && m_y2 == r.m_y2;
+            }
+            // Return the number of cells
+            inline double Get_Count(void) const
+            {
+                return (static_cast<double>(m_x2) - m_x1 + 1) * (static_cast<double>(m_y2) - m_y1 + 1);
+            }
+            // Return true if the given cell is included
+            inline bool Contains(int x, int y) const
+            {
+                return x >= m_x1 && x <= m_x2 && y >= m_y1 && y <= m_y2;
+            }
+        };
+
+        // registered sprite
+        struct Entry {
+            cSprite* m_sprite;
+            unsigned long m_order;
+            // cells this sprite is currently in
+            Cell_Range m_range;
+            // if the sprite is in any cell
+            bool m_in_cells;
+            // if the sprite covers too many cells and is kept in the large list instead
+            bool m_large;
+            // if the sprite is baked into the static tree
+            bool m_static;
+            // position in the static entries list
+            size_t m_static_index;
+            // static tree leaf node holding this entry
+            int m_static_leaf;
+            // bounds when baked
+            Bounds m_bounds;
+            // last query which returned this entry
+            mutable unsigned int m_query_stamp;
+        };
+
+        typedef vector<Entry*> Entry_List;
+        typedef std::unordered_map<const cSprite*, Entry> Entry_Map;
+        typedef std::unordered_map<uint64_t, Entry_List> Cell_Map;
+
+        // static tree node
+        struct Static_Node {
+            Bounds m_bounds;
+            int m_parent;
+            // child nodes if not a leaf
+            int m_left;
+            int m_right;
+            // static entries range if a leaf
+            size_t m_first;
+            size_t m_count;
+        };
+        typedef vector<Static_Node> Static_Node_List;
+
+        // Return the cell range of the given bounds
+        Cell_Range Get_Cell_Range(const Bounds& bounds) const;
+        /* Return the bounds of the sprite
+         * this covers the collision rect and the circle Col_Circle() approximates it with
+         * or the draw rect if using draw bounds
+        */
+        Bounds Get_Sprite_Bounds(const cSprite* sprite) const;
+        // Add or remove the entry from the cells of its range
+        void Link_Cells(Entry* entry);
+        void Unlink_Cells(Entry* entry);
+        // Collect the entries overlapping the given bounds into the candidates list
+        void Collect(vector<cSprite*>& candidates, const Bounds& bounds) const;
+        // Add the entries of the given cell to the query buffer
+        void Collect_Cell(const Entry_List& cell) const;
+        // Add the entries of the static tree overlapping the given bounds to the query buffer
+        void Collect_Static(const Bounds& bounds) const;
+
+        // Build the static tree node for the given static entries range and return its index
+        int Build_Static_Node(size_t first, size_t last, int parent);
+        // Recalculate the bounds of the leaf holding the entry and all its parents
+        void Refit_Static(Entry* entry);
+        // Make a baked entry dynamic again
+        void Unbake_Entry(Entry* entry);
+
+        // Return the key for the given cell
+        static inline uint64_t Get_Cell_Key(int x, int y)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+        }
+        // Return the cell position of the given key
+        static inline int Get_Cell_Key_X(uint64_t key)
+        {
+            return static_cast<int>(static_cast<uint32_t>(key >> 32));
+        }
+        static inline int Get_Cell_Key_Y(uint64_t key)
+        {
+            return static_cast<int>(static_cast<uint32_t>(key));
+        }
+
+        // sprites covering more cells than this are not stored in cells
+        static const int m_max_entry_cells = 1024;
+
+        Entry_Map m_entries;
+        Cell_Map m_cells;
+        // entries too large for the cells
+        Entry_List m_large_entries;
+        // baked entries, NULL if removed after baking
+        Entry_List m_static_entries;
+        // static tree nodes with the root first
+        Static_Node_List m_static_nodes;
+        // query stamp counter for duplicate detection
+        mutable unsigned int m_query_counter;
+        // reused query buffer
+        mutable Entry_List m_query_entries;
+        // reused static tree traversal stack
+        mutable vector<int> m_static_stack;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
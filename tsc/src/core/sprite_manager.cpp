@@ -21,19 +21,30 @@
 #include "../overworld/world_player.hpp"
 #include "../enemies/enemy.hpp"
 #include "../core/global_basic.hpp"
+#include "../core/framerate.hpp"
+#include "../core/update_jobs.hpp"
+#include "../video/static_geometry.hpp"
 
 using namespace std;
 
 namespace TSC {
 
+// time between the updates of the active objects
+static const float activity_update_interval = speedfactor_fps * 0.25f;
+
 /* *** *** *** *** *** *** cSprite_Manager *** *** *** *** *** *** *** *** *** *** *** */
 
 cSprite_Manager::cSprite_Manager(unsigned int reserve_items /* = 2000 */, unsigned int zpos_items /* = 100 */)
-    : cObject_Manager<cSprite>()
+    : cObject_Manager<cSprite>(), m_draw_hash(256.0f, 1)
 {
     objects.reserve(reserve_items);
 
     m_max_uid_mark = 1; // UID 0 is reserved for the player
+    m_uid_used.assign(1, true);
+    m_next_spatial_order = 0;
+    m_activity_enabled = 0;
+    m_activity_time = 0.0f;
+    m_static_geometry = NULL;
     m_z_pos_data.assign(zpos_items, 0.0f);
     m_z_pos_data_editor.assign(zpos_items,0.0f);
 }
@@ -41,6 +52,11 @@ cSprite_Manager::cSprite_Manager(unsigned int reserve_items /* = 2000 */, unsign
 cSprite_Manager::~cSprite_Manager(void)
 {
     Delete_All();
+
+    if (m_static_geometry) {
+        delete m_static_geometry;
+        m_static_geometry = NULL;
+    }
 }
 
 void cSprite_Manager::Add(cSprite* sprite)
@@ -50,6 +66,8 @@ void cSprite_Manager::Add(cSprite* sprite)
         return;
     }
 
+    sprite->m_dormant = 0;
+
     // Ensure sprites of the same layer get slightly different Z
     // coordinates. See method docs in sprite_manager.hpp for more
     //information.
@@ -58,47 +76,151 @@ void cSprite_Manager::Add(cSprite* sprite)
     /* If the sprite already has a UID set, we accept it as-is. This is
      * usually the case when loading a level from the XML file. Otherwise
      * we generate a unique id. */
-    if (sprite->m_uid <= 0) { // No UID set
-        sprite->m_uid = Generate_UID();
-    }
-    else { // UID set
-        // Ensure the pool knows about new maximum UIDs
-        if (sprite->m_uid >= m_max_uid_mark) {
-            // Allocate till our new mark
-            Allocate_UIDs(sprite->m_uid + 1);
-        }
+    Take_UID(sprite);
 
-//#ifdef _DEBUG
-//        // This slows down performance, so only check this in debug mode
-//        if (Is_UID_In_Use(sprite->m_uid))
-//            std::cerr << "Warning : UID collision : UID " << sprite->m_uid << " is already in use." << std::endl;
-//#endif
+    // Check if an destroyed object can be replaced
+    while (!m_free_slots.empty()) {
+        const unsigned long order = m_free_slots.top().first;
+        cSprite* obj = m_free_slots.top().second;
+        m_free_slots.pop();
 
-        // Mark the sprite’s UID as taken
-        m_uid_pool.erase(sprite->m_uid);
-    }
+        int slot = Get_Slot(obj, order);
 
-    // Check if an destroyed object can be replaced
-    for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
-        // get object pointer
-        cSprite* obj = (*itr);
+        // deleted or reordered since destroyed
+        if (slot < 0) {
+            continue;
+        }
 
-        // if destroy is set
-        if (obj->m_auto_destroy) {
-            // set new object
-            *itr = sprite;
+        // set new object
+        objects[slot] = sprite;
+        sprite->m_slot = slot;
+        obj->m_slot = -1;
+
+        // take over the array position in the spatial hash
+        Split_Collision_Proxy(obj);
+        m_spatial_hash.Remove(obj);
+        m_spatial_hash.Insert(sprite, order);
+        m_draw_hash.Remove(obj);
+        m_draw_hash.Insert(sprite, order);
+        Replace_Active(obj, sprite);
+
+        if (m_static_geometry) {
+            m_static_geometry->Remove(obj);
+            m_static_geometry->Insert(sprite);
+        }
 
-            // Release old sprite’s UID by putting it back into the UID pool
-            m_uid_pool.insert(obj->m_uid);
+        // Release old sprite’s UID by putting it back into the UID pool
+        Release_UID(obj);
 
-            // delete old
-            delete obj;
+        // delete old
+        delete obj;
 
-            return;
+        // added already destroyed
+        if (sprite->m_auto_destroy) {
+            Free_Slot(sprite);
         }
+
+        return;
     }
 
     cObject_Manager<cSprite>::Add(sprite);
+    sprite->m_slot = static_cast<int>(objects.size()) - 1;
+    m_spatial_hash.Insert(sprite, m_next_spatial_order);
+    m_draw_hash.Insert(sprite, m_next_spatial_order);
+    m_next_spatial_order++;
+
+    if (m_static_geometry) {
+        m_static_geometry->Insert(sprite);
+    }
+
+    if (m_activity_enabled) {
+        m_active_objects.push_back(sprite);
+    }
+
+    // added already destroyed
+    if (sprite->m_auto_destroy) {
+        Free_Slot(sprite);
+    }
+}
+
+void cSprite_Manager::Free_Slot(cSprite* obj)
+{
+    // not managed by us
+    if (!m_draw_hash.Is_Registered(obj)) {
+        return;
+    }
+
+    m_free_slots.push(Free_Slot_Entry(m_draw_hash.Get_Order(obj), obj));
+}
+
+int cSprite_Manager::Get_Slot(const cSprite* obj, unsigned long order) const
+{
+    // the order changed or the object was deleted
+    if (!m_draw_hash.Is_Registered(obj) || m_draw_hash.Get_Order(obj) != order || !obj->m_auto_destroy) {
+        return -1;
+    }
+
+    // not in the array
+    if (obj->m_slot < 0 || static_cast<size_t>(obj->m_slot) >= objects.size() || objects[obj->m_slot] != obj) {
+        return -1;
+    }
+
+    return obj->m_slot;
+}
+
+void cSprite_Manager::Update_Slots(size_t first)
+{
+    for (size_t i = first; i < objects.size(); i++) {
+        objects[i]->m_slot = static_cast<int>(i);
+    }
+}
+
+bool cSprite_Manager::Delete(size_t array_num, bool delete_data /* = 1 */)
+{
+    if (array_num >= objects.size()) {
+        return 0;
+    }
+
+    return Delete(objects[array_num], delete_data);
+}
+
+bool cSprite_Manager::Delete(cSprite* obj, bool delete_data /* = 1 */)
+{
+    // empty object
+    if (!obj) {
+        return 0;
+    }
+
+    // the array order of the other objects stays the same
+    Split_Collision_Proxy(obj);
+    m_spatial_hash.Remove(obj);
+    m_draw_hash.Remove(obj);
+    Replace_Active(obj, NULL);
+    obj->m_dormant = 0;
+
+    if (m_static_geometry) {
+        m_static_geometry->Remove(obj);
+    }
+
+    // the UID stays taken as the object may be added again
+    Release_UID(obj, 0);
+
+    // not in the array
+    if (obj->m_slot < 0 || static_cast<size_t>(obj->m_slot) >= objects.size() || objects[obj->m_slot] != obj) {
+        return cObject_Manager<cSprite>::Delete(obj, delete_data);
+    }
+
+    const size_t slot = obj->m_slot;
+    obj->m_slot = -1;
+    objects.erase(objects.begin() + slot);
+    // the following objects moved one position up
+    Update_Slots(slot);
+
+    if (delete_data) {
+        delete obj;
+    }
+
+    return 1;
 }
 
 cSprite* cSprite_Manager::Copy(unsigned int identifier)
@@ -177,9 +299,13 @@ void cSprite_Manager::Move_To_Front(cSprite* sprite)
     objects.erase(itr);
     objects.front() = sprite;
     objects.insert(objects.begin() + 1, first);
+    Update_Spatial_Order();
+    // the collision properties may have changed
+    Rebuild_Collision_Proxy(sprite);
 
     // make it the first z position
     sprite->m_pos_z = Get_First(sprite->m_type)->m_pos_z - cSprite::m_pos_z_delta;
+    Update_Static_Geometry(sprite);
 }
 
 void cSprite_Manager::Move_To_Back(cSprite* sprite)
@@ -208,9 +334,13 @@ void cSprite_Manager::Move_To_Back(cSprite* sprite)
     objects.erase(itr);
     objects.back() = sprite;
     objects.insert(objects.end() - 1, last);
+    Update_Spatial_Order();
+    // the collision properties may have changed
+    Rebuild_Collision_Proxy(sprite);
 
     // make it the last z position
     Ensure_Different_Z(sprite);
+    Update_Static_Geometry(sprite);
 }
 
 void cSprite_Manager::Delete_All(bool delayed /* = 0 */)
@@ -232,6 +362,7 @@ void cSprite_Manager::Delete_All(bool delayed /* = 0 */)
             cSprite* obj = (*itr);
 
             if (obj->m_disallow_managed_delete) {
+                obj->m_slot = -1;
                 itr = objects.erase(itr);
             }
             // increment
@@ -241,10 +372,26 @@ void cSprite_Manager::Delete_All(bool delayed /* = 0 */)
         }
 
         cObject_Manager<cSprite>::Delete_All();
+
+        Delete_Collision_Proxies(0);
+        m_spatial_hash.Clear();
+        m_draw_hash.Clear();
+        m_next_spatial_order = 0;
+
+        if (m_static_geometry) {
+            m_static_geometry->Clear();
+        }
+
+        m_active_objects.clear();
+        m_uid_objects.clear();
+        m_free_slots = Free_Slot_List();
     }
 
-    // Empty the UID pool, we have no sprites anymore
-    m_uid_pool.clear();
+    /* Empty the UID pool, we have no sprites anymore
+     * delayed destroyed sprites still give their UID back when replaced
+     */
+    m_uid_pool = UID_Pool();
+    m_uid_used.assign(m_uid_used.size(), true);
 
     // clear z position data
     std::fill(m_z_pos_data.begin(), m_z_pos_data.end(), 0.0f);
@@ -316,11 +463,12 @@ cSprite* cSprite_Manager::Get_from_Position(int start_pos_x, int start_pos_y, co
 
 cSprite* cSprite_Manager::Get_by_UID(int uid) const
 {
-    for (cSprite_List::const_iterator itr = objects.begin(); itr != objects.end(); ++itr) {
-        if ((*itr)->m_uid == uid)
-            return *itr;
-    }
-    return NULL;
+    UID_Map::const_iterator itr = m_uid_objects.find(uid);
+
+    if (itr == m_uid_objects.end())
+        return NULL;
+
+    return itr->second;
 }
 
 void cSprite_Manager::Get_Objects_sorted(cSprite_List& new_objects, bool editor_sort /* = 0 */, bool with_player /* = 0 */) const
@@ -344,8 +492,18 @@ void cSprite_Manager::Get_Objects_sorted(cSprite_List& new_objects, bool editor_
 
 void cSprite_Manager::Get_Colliding_Objects(cSprite_List& col_objects, const GL_rect& rect, bool with_player /* = 0 */, const cSprite* exclude_sprite /* = NULL */) const
 {
+    // get the objects of the overlapping cells
+    size_t first = col_objects.size();
+
+    {
+        cUpdate_Jobs::Query_Lock lock;
+        m_spatial_hash.Get_Candidates(col_objects, rect);
+    }
+
     // Check objects
-    for (cSprite_List::const_iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+    cSprite_List::iterator last = col_objects.begin() + first;
+
+    for (cSprite_List::iterator itr = col_objects.begin() + first; itr != col_objects.end(); ++itr) {
         // get object pointer
         cSprite* obj = (*itr);
 
@@ -359,9 +517,11 @@ void cSprite_Manager::Get_Colliding_Objects(cSprite_List& col_objects, const GL_
             continue;
         }
 
-        col_objects.push_back(obj);
+        *last++ = obj;
     }
 
+    col_objects.erase(last, col_objects.end());
+
     if (with_player && pActive_Player != exclude_sprite) {
         if (rect.Intersects(pActive_Player->m_col_rect)) {
             col_objects.push_back(pActive_Player);
@@ -371,8 +531,18 @@ void cSprite_Manager::Get_Colliding_Objects(cSprite_List& col_objects, const GL_
 
 void cSprite_Manager::Get_Colliding_Objects(cSprite_List& col_objects, const GL_Circle& circle, bool with_player /* = 0 */, const cSprite* exclude_sprite /* = NULL */) const
 {
+    // get the objects of the overlapping cells
+    size_t first = col_objects.size();
+
+    {
+        cUpdate_Jobs::Query_Lock lock;
+        m_spatial_hash.Get_Candidates(col_objects, circle);
+    }
+
     // Check objects
-    for (cSprite_List::const_iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+    cSprite_List::iterator last = col_objects.begin() + first;
+
+    for (cSprite_List::iterator itr = col_objects.begin() + first; itr != col_objects.end(); ++itr) {
         // get object pointer
         cSprite* obj = (*itr);
 
@@ -386,9 +556,11 @@ void cSprite_Manager::Get_Colliding_Objects(cSprite_List& col_objects, const GL_
             continue;
         }
 
-        col_objects.push_back(obj);
+        *last++ = obj;
     }
 
+    col_objects.erase(last, col_objects.end());
+
     if (with_player && pActive_Player != exclude_sprite) {
         if (circle.Intersects(pActive_Player->m_col_rect)) {
             col_objects.push_back(pActive_Player);
@@ -396,10 +568,309 @@ void cSprite_Manager::Get_Colliding_Objects(cSprite_List& col_objects, const GL_
     }
 }
 
-void cSprite_Manager::Handle_Collision_Items(void)
+void cSprite_Manager::Get_Visible_Objects(cSprite_List& visible_objects) const
+{
+    m_draw_hash.Get_Candidates(visible_objects, GL_rect(pActive_Camera->m_x, pActive_Camera->m_y, static_cast<float>(game_res_w), static_cast<float>(game_res_h)));
+
+    // the editor also draws the active object if not on the screen
+    if (editor_enabled && pMouseCursor->m_active_object && m_draw_hash.Is_Registered(pMouseCursor->m_active_object)) {
+        cSprite* active_object = pMouseCursor->m_active_object;
+
+        if (std::find(visible_objects.begin(), visible_objects.end(), active_object) == visible_objects.end()) {
+            visible_objects.push_back(active_object);
+        }
+    }
+}
+
+void cSprite_Manager::Update_Items(bool parallel /* = 0 */)
 {
+    if (parallel && pUpdate_Jobs && pUpdate_Jobs->Get_Thread_Count() > 1) {
+        // dormant objects are skipped
+        const cSprite_List& items = m_activity_enabled ? m_active_objects : objects;
+
+        /* consecutive objects allowing it are updated together
+         * any other object is updated alone after them
+         * so every object still sees the ones before it updated
+        */
+        for (size_t i = 0; i < items.size(); i++) {
+            cSprite* obj = items[i];
+
+            if (obj->Can_Update_Parallel()) {
+                m_parallel_objects.push_back(obj);
+                continue;
+            }
+
+            Update_Parallel_Objects();
+            obj->Update();
+        }
+
+        Update_Parallel_Objects();
+        return;
+    }
+
+    if (m_activity_enabled) {
+        // the list can grow while updating
+        for (size_t i = 0; i < m_active_objects.size(); i++) {
+            m_active_objects[i]->Update();
+        }
+        return;
+    }
+
     for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
-        cSprite* obj = (*itr);
+        (*itr)->Update();
+    }
+}
+
+void cSprite_Manager::Update_Items_Valid_Draw(void)
+{
+    m_visible_objects.clear();
+    Get_Visible_Objects(m_visible_objects);
+
+    for (cSprite_List::iterator itr = m_visible_objects.begin(); itr != m_visible_objects.end(); ++itr) {
+        (*itr)->Update_Valid_Draw();
+    }
+}
+
+void cSprite_Manager::Draw_Items(void)
+{
+    m_visible_objects.clear();
+    Get_Visible_Objects(m_visible_objects);
+
+    if (m_static_geometry && m_static_geometry->Is_Enabled()) {
+        // the other objects are drawn on their own
+        m_dynamic_objects.clear();
+        m_dynamic_z.clear();
+
+        for (cSprite_List::iterator itr = m_visible_objects.begin(); itr != m_visible_objects.end(); ++itr) {
+            cSprite* obj = (*itr);
+
+            if (m_static_geometry->Is_Cached(obj)) {
+                continue;
+            }
+
+            m_dynamic_objects.push_back(obj);
+            m_dynamic_z.push_back((editor_enabled && obj->m_editor_pos_z > 0.0f) ? obj->m_editor_pos_z : obj->m_pos_z);
+        }
+
+        // the chunks are split around them
+        std::sort(m_dynamic_z.begin(), m_dynamic_z.end());
+        m_static_geometry->Draw(GL_rect(pActive_Camera->m_x, pActive_Camera->m_y, static_cast<float>(game_res_w), static_cast<float>(game_res_h)), m_dynamic_z);
+
+        for (cSprite_List::iterator itr = m_dynamic_objects.begin(); itr != m_dynamic_objects.end(); ++itr) {
+            (*itr)->Draw();
+        }
+
+        return;
+    }
+
+    for (cSprite_List::iterator itr = m_visible_objects.begin(); itr != m_visible_objects.end(); ++itr) {
+        (*itr)->Draw();
+    }
+}
+
+void cSprite_Manager::Enable_Static_Geometry(void)
+{
+    // already enabled
+    if (m_static_geometry) {
+        return;
+    }
+
+    m_static_geometry = new cStatic_Geometry();
+
+    for (cSprite_List::const_iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+        m_static_geometry->Insert(*itr);
+    }
+}
+
+void cSprite_Manager::Update_Static_Geometry(const cSprite* sprite)
+{
+    // not managed by us
+    if (!m_static_geometry || !m_draw_hash.Is_Registered(sprite)) {
+        return;
+    }
+
+    m_static_geometry->Update(sprite);
+}
+
+void cSprite_Manager::Bake_Static_Collision(void)
+{
+    // merge again from the current tiles
+    Delete_Collision_Proxies();
+
+    cSprite_List static_objects;
+    static_objects.reserve(objects.size());
+
+    for (cSprite_List::const_iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+        if ((*itr)->Is_Static_Collision()) {
+            static_objects.push_back(*itr);
+        }
+    }
+
+    // tiles are drawn one by one
+    m_draw_hash.Bake_Static(static_objects);
+
+    Create_Collision_Proxies(static_objects);
+    m_spatial_hash.Bake_Static(static_objects);
+
+    debug_print("Baked %u of %u objects into the static collision tree with %u collision proxies\n", static_cast<unsigned int>(m_spatial_hash.Get_Static_Count()), static_cast<unsigned int>(objects.size()), static_cast<unsigned int>(m_collision_proxies.size()));
+}
+
+void cSprite_Manager::Create_Collision_Proxies(cSprite_List& static_objects)
+{
+    const size_t first_proxy = m_collision_proxies.size();
+    cSprite_List tiles;
+
+    for (cSprite_List::const_iterator itr = static_objects.begin(); itr != static_objects.end(); ++itr) {
+        if (cCollision_Proxy::Is_Mergeable(*itr)) {
+            tiles.push_back(*itr);
+        }
+    }
+
+    // merge touching tiles in the same row
+    std::sort(tiles.begin(), tiles.end(), cCollision_Proxy::row_sort());
+
+    cCollision_Proxy_List rows;
+
+    for (cSprite_List::iterator itr = tiles.begin(); itr != tiles.end(); ++itr) {
+        cSprite* tile = (*itr);
+        cCollision_Proxy* row = rows.empty() ? NULL : rows.back();
+
+        if (row && cCollision_Proxy::Is_Same_Type(row, tile) && Is_Float_Equal(row->m_col_rect.m_y, tile->m_col_rect.m_y) && Is_Float_Equal(row->m_col_rect.m_h, tile->m_col_rect.m_h) &&
+                tile->m_col_rect.m_x <= row->m_col_rect.m_x + row->m_col_rect.m_w + 0.01f) {
+            row->Add_Tile(tile, m_spatial_hash.Get_Order(tile));
+        }
+        else {
+            rows.push_back(new cCollision_Proxy(this, tile, m_spatial_hash.Get_Order(tile)));
+        }
+    }
+
+    /* merge massive rows on top of each other with the same width
+     * others only in rows as their top edge is used (e.g. halfmassive)
+    */
+    std::sort(rows.begin(), rows.end(), cCollision_Proxy::column_sort());
+
+    cCollision_Proxy_List proxies;
+
+    for (cCollision_Proxy_List::iterator itr = rows.begin(); itr != rows.end(); ++itr) {
+        cCollision_Proxy* row = (*itr);
+        cCollision_Proxy* column = proxies.empty() ? NULL : proxies.back();
+
+        if (column && row->m_massive_type == MASS_MASSIVE && cCollision_Proxy::Is_Same_Type(column, row) && Is_Float_Equal(column->m_col_rect.m_x, row->m_col_rect.m_x) && Is_Float_Equal(column->m_col_rect.m_w, row->m_col_rect.m_w) &&
+                row->m_col_rect.m_y <= column->m_col_rect.m_y + column->m_col_rect.m_h + 0.01f) {
+            column->Add_Tiles(row);
+            delete row;
+        }
+        else {
+            proxies.push_back(row);
+        }
+    }
+
+    // replace the merged tiles
+    for (cCollision_Proxy_List::iterator itr = proxies.begin(); itr != proxies.end(); ++itr) {
+        cCollision_Proxy* proxy = (*itr);
+
+        // nothing merged
+        if (proxy->m_tiles.size() < 2) {
+            delete proxy;
+            continue;
+        }
+
+        for (cSprite_List::iterator tile_itr = proxy->m_tiles.begin(); tile_itr != proxy->m_tiles.end(); ++tile_itr) {
+            m_spatial_hash.Remove(*tile_itr);
+            m_collision_proxy_tiles[*tile_itr] = proxy;
+        }
+
+        m_spatial_hash.Insert(proxy, proxy->Get_Order());
+        m_collision_proxies.push_back(proxy);
+    }
+
+    cSprite_List::iterator last = static_objects.begin();
+
+    for (cSprite_List::iterator itr = static_objects.begin(); itr != static_objects.end(); ++itr) {
+        if (m_collision_proxy_tiles.find(*itr) == m_collision_proxy_tiles.end()) {
+            *last++ = *itr;
+        }
+    }
+
+    static_objects.erase(last, static_objects.end());
+    static_objects.insert(static_objects.end(), m_collision_proxies.begin() + first_proxy, m_collision_proxies.end());
+}
+
+void cSprite_Manager::Rebuild_Collision_Proxy(const cSprite* tile)
+{
+    Collision_Proxy_Map::iterator proxy_itr = m_collision_proxy_tiles.find(tile);
+
+    // not merged
+    if (proxy_itr == m_collision_proxy_tiles.end()) {
+        return;
+    }
+
+    const cSprite_List tiles = proxy_itr->second->m_tiles;
+
+    Split_Collision_Proxy(tile);
+
+    // merge the tiles again which still can be
+    cSprite_List static_objects;
+
+    for (cSprite_List::const_iterator itr = tiles.begin(); itr != tiles.end(); ++itr) {
+        if ((*itr)->Is_Static_Collision()) {
+            static_objects.push_back(*itr);
+        }
+    }
+
+    Create_Collision_Proxies(static_objects);
+}
+
+void cSprite_Manager::Split_Collision_Proxy(const cSprite* tile)
+{
+    Collision_Proxy_Map::iterator proxy_itr = m_collision_proxy_tiles.find(tile);
+
+    // not merged
+    if (proxy_itr == m_collision_proxy_tiles.end()) {
+        return;
+    }
+
+    cCollision_Proxy* proxy = proxy_itr->second;
+
+    m_spatial_hash.Remove(proxy);
+
+    for (size_t i = 0; i < proxy->m_tiles.size(); i++) {
+        m_collision_proxy_tiles.erase(proxy->m_tiles[i]);
+        m_spatial_hash.Insert(proxy->m_tiles[i], proxy->m_tile_orders[i]);
+    }
+
+    m_collision_proxies.erase(std::find(m_collision_proxies.begin(), m_collision_proxies.end(), proxy));
+    delete proxy;
+}
+
+void cSprite_Manager::Delete_Collision_Proxies(bool restore_tiles /* = 1 */)
+{
+    for (cCollision_Proxy_List::iterator itr = m_collision_proxies.begin(); itr != m_collision_proxies.end(); ++itr) {
+        cCollision_Proxy* proxy = (*itr);
+
+        if (restore_tiles) {
+            m_spatial_hash.Remove(proxy);
+
+            for (size_t i = 0; i < proxy->m_tiles.size(); i++) {
+                m_spatial_hash.Insert(proxy->m_tiles[i], proxy->m_tile_orders[i]);
+            }
+        }
+
+        delete proxy;
+    }
+
+    m_collision_proxies.clear();
+    m_collision_proxy_tiles.clear();
+}
+
+void cSprite_Manager::Handle_Collision_Items(void)
+{
+    // dormant objects are skipped
+    const cSprite_List& items = m_activity_enabled ? m_active_objects : objects;
+
+    // woken objects are appended while handling
+    for (size_t i = 0; i < items.size(); i++) {
+        cSprite* obj = items[i];
 
         // invalid
         if (obj->m_auto_destroy) {
@@ -418,6 +889,146 @@ void cSprite_Manager::Handle_Collision_Items(void)
     }
 }
 
+void cSprite_Manager::Update_Activity(const GL_rect& rect)
+{
+    if (!m_activity_enabled) {
+        m_activity_enabled = 1;
+        // update now
+        m_activity_time = activity_update_interval;
+    }
+    else {
+        m_activity_time += pFramerate->m_speed_factor;
+    }
+
+    if (m_activity_time < activity_update_interval) {
+        return;
+    }
+
+    const float elapsed = m_activity_time;
+    m_activity_time = 0.0f;
+
+    m_active_objects.clear();
+
+    for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+        cSprite* obj = (*itr);
+
+        // recently woken up
+        if (obj->m_wake_counter > 0.0f) {
+            obj->m_wake_counter -= elapsed;
+        }
+
+        obj->m_dormant = obj->m_wake_counter <= 0.0f && !rect.Intersects(obj->m_rect) && !obj->Is_In_Range() && obj->Can_Be_Dormant();
+
+        if (!obj->m_dormant) {
+            m_active_objects.push_back(obj);
+        }
+    }
+}
+
+void cSprite_Manager::Wake_All(void)
+{
+    if (!m_activity_enabled) {
+        return;
+    }
+
+    m_activity_enabled = 0;
+
+    for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+        (*itr)->m_dormant = 0;
+    }
+
+    m_active_objects.clear();
+}
+
+void cSprite_Manager::Wake(cSprite* obj)
+{
+    if (!obj->m_dormant) {
+        return;
+    }
+
+    obj->m_dormant = 0;
+    m_active_objects.push_back(obj);
+}
+
+void cSprite_Manager::Replace_Active(cSprite* obj, cSprite* new_obj)
+{
+    if (!m_activity_enabled) {
+        return;
+    }
+
+    // dormant objects are not in the list
+    if (obj->m_dormant) {
+        if (new_obj) {
+            m_active_objects.push_back(new_obj);
+        }
+
+        return;
+    }
+
+    cSprite_List::iterator itr = std::find(m_active_objects.begin(), m_active_objects.end(), obj);
+
+    if (itr == m_active_objects.end()) {
+        return;
+    }
+
+    if (new_obj) {
+        *itr = new_obj;
+    }
+    else {
+        m_active_objects.erase(itr);
+    }
+}
+
+void cSprite_Manager::Update_Parallel_Objects(void)
+{
+    if (m_parallel_objects.empty()) {
+        return;
+    }
+
+    try {
+        pUpdate_Jobs->Update(m_parallel_objects);
+    }
+    catch (...) {
+        m_parallel_objects.clear();
+        throw;
+    }
+
+    m_parallel_objects.clear();
+}
+
+void cSprite_Manager::Update_Spatial_Order(void)
+{
+    unsigned long order = 0;
+    // the free slots are sorted by the order
+    m_free_slots = Free_Slot_List();
+
+    for (cSprite_List::const_iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+        m_spatial_hash.Set_Order(*itr, order);
+        m_draw_hash.Set_Order(*itr, order);
+        // the order is the array position
+        (*itr)->m_slot = static_cast<int>(order);
+
+        if ((*itr)->m_auto_destroy) {
+            m_free_slots.push(Free_Slot_Entry(order, *itr));
+        }
+
+        order++;
+    }
+
+    m_next_spatial_order = order;
+
+    // merged tiles are only in the draw hash
+    for (cCollision_Proxy_List::iterator itr = m_collision_proxies.begin(); itr != m_collision_proxies.end(); ++itr) {
+        cCollision_Proxy* proxy = (*itr);
+
+        for (size_t i = 0; i < proxy->m_tiles.size(); i++) {
+            proxy->m_tile_orders[i] = m_draw_hash.Get_Order(proxy->m_tiles[i]);
+        }
+
+        m_spatial_hash.Set_Order(proxy, proxy->Get_Order());
+    }
+}
+
 unsigned int cSprite_Manager::Get_Size_Array(const ArrayType sprite_array)
 {
     unsigned int count = 0;
@@ -431,13 +1042,13 @@ unsigned int cSprite_Manager::Get_Size_Array(const ArrayType sprite_array)
     return count;
 }
 
-/* The member m_uid_pool contains a list of all those UIDs that
- * are *not* currently in use, sorted from the smallest to
- * the greatest (not necessarily without gaps, as destroyed
- * sprites give their UID back into the pool). This allows
- * use to quickly find the next free UID without much searching
- * by just picking the very first element from m_uid_pool,
- * which, as said, is always sorted and stays so.
+/* The member m_uid_pool contains all those UIDs that are *not*
+ * currently in use, with the smallest on top (not necessarily
+ * without gaps, as destroyed sprites give their UID back into
+ * the pool). This allows use to quickly find the next free UID
+ * without much searching by just picking the top element from
+ * m_uid_pool. UIDs taken directly by Add() stay in the pool, so
+ * the m_uid_used bitset decides if a picked UID is really free.
  *
  * However, at the level start this would mean that m_uid_pool
  * must contain infinitely many numbers reaching from 1 to ∞. Well,
@@ -449,14 +1060,20 @@ unsigned int cSprite_Manager::Get_Size_Array(const ArrayType sprite_array)
  * highest possible UID in m_max_uid_mark. */
 int cSprite_Manager::Generate_UID()
 {
-    // Allocate 10 new UIDs if the pool is empty
-    if (m_uid_pool.empty())
-        Allocate_UIDs(m_max_uid_mark + 10);
-
-    // Pool is not empty, return the first available UID.
-    std::set<int>::const_iterator iter = m_uid_pool.begin();
-    m_uid_pool.erase(iter);
-    return *iter;
+    while (1) {
+        // Allocate 10 new UIDs if the pool is empty
+        if (m_uid_pool.empty())
+            Allocate_UIDs(m_max_uid_mark + 10);
+
+        // Pool is not empty, take the first available UID.
+        int uid = m_uid_pool.top();
+        m_uid_pool.pop();
+
+        if (!m_uid_used[uid]) {
+            m_uid_used[uid] = true;
+            return uid;
+        }
+    }
 }
 
 // We need `long', because we must check an `int' overflow (see below)
@@ -473,29 +1090,69 @@ void cSprite_Manager::Allocate_UIDs(long new_max_uid_mark)
         throw(std::range_error("Too many sprites, unable to generate further UIDs!"));
 
     // Actually allocate the numbers for the UID pool
+    m_uid_used.resize(new_max_uid_mark, false);
+
     for (int i = m_max_uid_mark; i < static_cast<int>(new_max_uid_mark); i++) // new_max_uid_mark is guaranteed to be < INT_MAX
-        m_uid_pool.insert(i);
+        m_uid_pool.push(i);
 
     // Remember the new maximum. Note that by checking INT_MAX, we have
     // ensured the values fits into an int.
     m_max_uid_mark = static_cast<int>(new_max_uid_mark);
 }
 
-bool cSprite_Manager::Is_UID_In_Use(int uid)
+bool cSprite_Manager::Is_UID_In_Use(int uid) const
 {
     // The "invalid UID" always is in use
-    if (uid == 0)
+    if (uid <= 0)
         return true;
 
-    // If the UID is in the pool, it is free. If it is greater or equal to
-    // the pool border marker, it is free. Otherwise, it is in use.
+    // If the UID is greater or equal to the pool border marker, it
+    // is free. Otherwise the bitset knows.
     if (uid >= m_max_uid_mark)
         return false;
 
-    if (m_uid_pool.find(uid) == m_uid_pool.end())
-        return true;
+    return m_uid_used[uid];
+}
+
+void cSprite_Manager::Take_UID(cSprite* obj)
+{
+    if (obj->m_uid <= 0) { // No UID set
+        obj->m_uid = Generate_UID();
+    }
+    else { // UID set
+        // Ensure the pool knows about new maximum UIDs
+        if (obj->m_uid >= m_max_uid_mark) {
+            // Allocate till our new mark
+            Allocate_UIDs(obj->m_uid + 1);
+        }
 
-    return false;
+//#ifdef _DEBUG
+//        // This slows down performance, so only check this in debug mode
+//        if (Is_UID_In_Use(obj->m_uid))
+//            std::cerr << "Warning : UID collision : UID " << obj->m_uid << " is already in use." << std::endl;
+//#endif
+
+        // Mark the sprite’s UID as taken
+        m_uid_used[obj->m_uid] = true;
+    }
+
+    m_uid_objects[obj->m_uid] = obj;
+}
+
+void cSprite_Manager::Release_UID(const cSprite* obj, bool give_back /* = 1 */)
+{
+    UID_Map::iterator itr = m_uid_objects.find(obj->m_uid);
+
+    // Not ours anymore, e.g. a level loaded after Delete_All() reused it
+    if (itr == m_uid_objects.end() || itr->second != obj)
+        return;
+
+    m_uid_objects.erase(itr);
+
+    if (give_back && obj->m_uid > 0 && obj->m_uid < m_max_uid_mark) {
+        m_uid_used[obj->m_uid] = false;
+        m_uid_pool.push(obj->m_uid);
+    }
 }
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
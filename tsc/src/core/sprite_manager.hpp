@@ -19,7 +19,9 @@
 
 #include "../core/global_game.hpp"
 #include "../core/obj_manager.hpp"
+#include "../core/spatial_hash.hpp"
 #include "../objects/movingsprite.hpp"
+#include "../objects/collision_proxy.hpp"
 
 namespace TSC {
 
@@ -33,8 +35,18 @@ namespace TSC {
         /* Add a sprite
          * If the sprite has m_uid set to something greater than 0,
          * it will not be touched, otherwise it is assigned a free UID.
+         * The array slot of the first destroyed object is reused if available.
          */
         virtual void Add(cSprite* sprite);
+        /* Remember the array slot of the given destroyed object for reuse by Add()
+         * called by cSprite::Destroy(), does nothing if the object is not managed by us
+         */
+        void Free_Slot(cSprite* obj);
+
+        // Delete the object from given array number
+        virtual bool Delete(size_t array_num, bool delete_data = 1);
+        // Delete the given object
+        virtual bool Delete(cSprite* obj, bool delete_data = 1);
 
         // Return a sprite copy
         cSprite* Copy(unsigned int identifier);
@@ -81,38 +93,97 @@ namespace TSC {
         void Get_Colliding_Objects(cSprite_List& col_objects, const GL_rect& rect, bool with_player = 0, const cSprite* exclude_sprite = NULL) const;
         void Get_Colliding_Objects(cSprite_List& col_objects, const GL_Circle& circle, bool with_player = 0, const cSprite* exclude_sprite = NULL) const;
 
-        // Update items drawing validation
-        inline void Update_Items_Valid_Draw(void)
+        /* Bake all objects which never move into the static collision tree
+         * touching tiles with the same collision properties are merged into collision proxies
+         * should be called once after loading a level
+        */
+        void Bake_Static_Collision(void);
+
+        /* Get the objects which could be visible on the screen
+         * in the same order as the objects array
+        */
+        void Get_Visible_Objects(cSprite_List& visible_objects) const;
+
+        /* Update the spatial hash cells of the given sprite
+         * must be called if the collision or draw rect of a managed sprite changed
+         * a merged tile rebuilds its collision proxy
+         * does nothing if the sprite is not managed by us
+        */
+        inline void Update_Spatial(const cSprite* sprite)
         {
-            for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
-                (*itr)->Update_Valid_Draw();
+            m_draw_hash.Update(sprite);
+
+            if (m_static_geometry) {
+                Update_Static_Geometry(sprite);
             }
-        }
-        // Update items
-        inline void Update_Items(void)
-        {
-            for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
-                (*itr)->Update();
+
+            // merged tiles are not registered
+            if (!m_spatial_hash.Update(sprite) && !m_collision_proxy_tiles.empty()) {
+                Rebuild_Collision_Proxy(sprite);
             }
         }
+
+        /* Draw the static tiles from retained vertex buffers grouped in chunks
+         * used by levels as their tiles only change in the editor
+        */
+        void Enable_Static_Geometry(void);
+        /* Update the static geometry chunk of the given sprite
+         * must be called if the drawing of a managed sprite changed
+         * does nothing if the static geometry is not enabled
+        */
+        void Update_Static_Geometry(const cSprite* sprite);
+
+        /* Update items drawing validation
+         * only the objects visible on the screen are updated
+        */
+        void Update_Items_Valid_Draw(void);
+        /* Update items
+         * if parallel is set objects which allow it are updated on worker threads
+        */
+        void Update_Items(bool parallel = 0);
         // Update_Late items
         inline void Update_Items_Late(void)
         {
-            for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
-                (*itr)->Update_Late();
+            if (m_activity_enabled) {
+                for (size_t i = 0; i < m_active_objects.size(); i++) {
+                    m_active_objects[i]->Update_Late();
+                }
+                return;
             }
-        }
-        // Draw items
-        inline void Draw_Items(void)
-        {
+
             for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
-                (*itr)->Draw();
+                (*itr)->Update_Late();
             }
         }
+        /* Draw items
+         * only the objects visible on the screen are drawn
+        */
+        void Draw_Items(void);
 
         // Create Collision data and Handle the collisions
         void Handle_Collision_Items(void);
 
+        /* Update which objects are active
+         * objects outside the given rect and their camera range become dormant
+         * and are skipped by the update and collision handling until they get near again
+         * the first call enables dormancy for this manager
+        */
+        void Update_Activity(const GL_rect& rect);
+        // Disable dormancy and make all objects active again
+        void Wake_All(void);
+        // Make the given dormant object active again
+        void Wake(cSprite* obj);
+        // Return the number of active objects
+        inline size_t Get_Active_Count(void) const
+        {
+            return m_activity_enabled ? m_active_objects.size() : objects.size();
+        }
+        // Return the number of dormant objects
+        inline size_t Get_Dormant_Count(void) const
+        {
+            return objects.size() - Get_Active_Count();
+        }
+
 
         /* Return the current size
          * of the specified sprite array
@@ -130,7 +201,7 @@ namespace TSC {
         // requested).
         int Generate_UID();
         // Returns true if the given UID already exists, false otherwise.
-        bool Is_UID_In_Use(int uid);
+        bool Is_UID_In_Use(int uid) const;
         // Allocate new UIDs in the pool of available UIDs. The new maximum
         // available uid is `new_max_uid_mark - 1'. This method does nothing
         // if `new_max_uid_mark' is smaller than the current max mark.
@@ -141,12 +212,23 @@ namespace TSC {
         ZposList m_z_pos_data;
         // biggest editor type z position
         ZposList m_z_pos_data_editor;
-        // This set holds the not-yet-used UIDs so we can easily
-        // find the next free one.
-        std::set<int> m_uid_pool;
+        // The object of each UID for fast lookups.
+        typedef std::unordered_map<int, cSprite*> UID_Map;
+        UID_Map m_uid_objects;
+        // Whether each allocated UID is taken, indexed by the UID.
+        vector<bool> m_uid_used;
+        // Allocated or released UIDs with the smallest on top so we can
+        // easily find the next free one. UIDs taken by Add() in the
+        // meantime are not removed but skipped by Generate_UID().
+        typedef std::priority_queue<int, vector<int>, std::greater<int> > UID_Pool;
+        UID_Pool m_uid_pool;
         // The UID pool is filled as needed. This is always the first
         // non-yet allocated UID.
         int m_max_uid_mark;
+        // Collision rects of all objects for fast collision queries
+        cSpatial_Hash m_spatial_hash;
+        // Draw rects of all objects for finding the visible objects
+        cSpatial_Hash m_draw_hash;
 
         // Z position sort
         struct zpos_sort {
@@ -193,6 +275,75 @@ namespace TSC {
          * are ensured to be placed in front of older ones.
          */
         void Ensure_Different_Z(cSprite* sprite);
+        /* Set the spatial hash order of every object to its array
+         * position. Needed after objects changed their position in
+         * the array as query results are sorted by this order.
+         */
+        void Update_Spatial_Order(void);
+
+        /* Merge the mergeable tiles of the given static objects into collision proxies
+         * and replace the merged tiles in the list with the new proxies
+         */
+        void Create_Collision_Proxies(cSprite_List& static_objects);
+        /* Put the tiles of the collision proxy holding the given tile
+         * back into the spatial hash and delete the proxy
+         */
+        void Split_Collision_Proxy(const cSprite* tile);
+        /* Split the collision proxy holding the given tile
+         * and merge its tiles again with their current collision properties
+         */
+        void Rebuild_Collision_Proxy(const cSprite* tile);
+        /* Delete all collision proxies
+         * if restore_tiles is set the merged tiles are put back into the spatial hash
+         */
+        void Delete_Collision_Proxies(bool restore_tiles = 1);
+
+        // Return the array position of the given object or -1 if not available
+        int Get_Slot(const cSprite* obj, unsigned long order) const;
+        // Set the array position of the objects from the given one to the end
+        void Update_Slots(size_t first);
+
+        // Mark the UID of the given object as taken and map it to the object
+        void Take_UID(cSprite* obj);
+        /* Remove the UID mapping of the given object and give the UID back into the pool
+         * does nothing if another object took over the UID
+         */
+        void Release_UID(const cSprite* obj, bool give_back = 1);
+        // Replace the given object in the active objects list
+        void Replace_Active(cSprite* obj, cSprite* new_obj);
+        // Update the collected parallel objects and clear the list
+        void Update_Parallel_Objects(void);
+
+        // spatial hash order for the next appended object
+        unsigned long m_next_spatial_order;
+
+        // if objects can become dormant
+        bool m_activity_enabled;
+        // time since the last activity update
+        float m_activity_time;
+        // objects which are not dormant in array order, woken objects are appended
+        cSprite_List m_active_objects;
+        /* destroyed objects with their spatial order, the first in the array on top
+         * entries of deleted objects or outdated orders are skipped by Add()
+         */
+        typedef std::pair<unsigned long, cSprite*> Free_Slot_Entry;
+        typedef std::priority_queue<Free_Slot_Entry, vector<Free_Slot_Entry>, std::greater<Free_Slot_Entry> > Free_Slot_List;
+        Free_Slot_List m_free_slots;
+        // reused visible objects list for drawing
+        cSprite_List m_visible_objects;
+        // static tiles drawn from chunks or NULL if not enabled
+        cStatic_Geometry* m_static_geometry;
+        // reused visible objects not drawn from the chunks and their sorted z positions
+        cSprite_List m_dynamic_objects;
+        vector<float> m_dynamic_z;
+        // reused list of objects updated together on worker threads
+        cSprite_List m_parallel_objects;
+
+        typedef std::unordered_map<const cSprite*, cCollision_Proxy*> Collision_Proxy_Map;
+        // collision proxies in the spatial hash
+        cCollision_Proxy_List m_collision_proxies;
+        // the collision proxy of each merged tile
+        Collision_Proxy_Map m_collision_proxy_tiles;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -0,0 +1,201 @@
+/***************************************************************************
+ * update_jobs.cpp  -  Parallel sprite updates with a serial command merge
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/update_jobs.hpp"
+#include "../objects/sprite.hpp"
+
+namespace TSC {
+
+/* *** *** *** *** *** *** cUpdate_Jobs *** *** *** *** *** *** *** *** *** *** *** */
+
+// more threads don't help with the few sprites updated per frame
+static const unsigned int max_update_threads = 16;
+
+bool cUpdate_Jobs::m_recording = 0;
+boost::thread_specific_ptr<cUpdate_Jobs::Thread_State> cUpdate_Jobs::m_thread_state(&cUpdate_Jobs::Release_Thread_State);
+boost::mutex cUpdate_Jobs::m_query_mutex;
+
+cUpdate_Jobs::cUpdate_Jobs(void)
+{
+    m_generation = 0;
+    m_pending = 0;
+    m_quit = 0;
+    m_sprites = NULL;
+
+    unsigned int thread_count = boost::thread::hardware_concurrency();
+
+    if (thread_count < 1) {
+        thread_count = 1;
+    }
+    else if (thread_count > max_update_threads) {
+        thread_count = max_update_threads;
+    }
+
+    m_states.resize(thread_count);
+
+    for (unsigned int i = 1; i < thread_count; i++) {
+        m_workers.create_thread(std::bind(&cUpdate_Jobs::Worker_Loop, this, i));
+    }
+}
+
+cUpdate_Jobs::~cUpdate_Jobs(void)
+{
+    {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        m_quit = 1;
+    }
+
+    m_start_cond.notify_all();
+    m_workers.join_all();
+}
+
+void cUpdate_Jobs::Update(const vector<cSprite*>& sprites)
+{
+    // nothing to share
+    if (m_states.size() < 2 || sprites.size() < 2) {
+        for (vector<cSprite*>::const_iterator itr = sprites.begin(); itr != sprites.end(); ++itr) {
+            (*itr)->Update();
+        }
+
+        return;
+    }
+
+    {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        m_sprites = &sprites;
+        m_pending = static_cast<unsigned int>(m_states.size()) - 1;
+        m_recording = 1;
+        m_generation++;
+    }
+
+    m_start_cond.notify_all();
+
+    // the main thread updates the first chunk
+    m_thread_state.reset(&m_states[0]);
+    Run_Chunk(0);
+    m_thread_state.release();
+
+    {
+        boost::unique_lock<boost::mutex> lock(m_mutex);
+
+        while (m_pending > 0) {
+            m_done_cond.wait(lock);
+        }
+
+        m_recording = 0;
+        m_sprites = NULL;
+    }
+
+    /* serial merge
+     * the chunks are in sprite order and every chunk recorded its commands in order
+    */
+    for (Thread_State_List::iterator itr = m_states.begin(); itr != m_states.end(); ++itr) {
+        vector<Command>& commands = itr->m_commands;
+
+        for (vector<Command>::iterator cmd_itr = commands.begin(); cmd_itr != commands.end(); ++cmd_itr) {
+            (*cmd_itr)();
+        }
+
+        commands.clear();
+    }
+
+    if (m_error) {
+        std::exception_ptr error = m_error;
+        m_error = std::exception_ptr();
+        std::rethrow_exception(error);
+    }
+}
+
+void cUpdate_Jobs::Defer(const Command& command)
+{
+    m_thread_state->m_commands.push_back(command);
+}
+
+cUpdate_Jobs::Query_Lock::Query_Lock(void)
+{
+    m_locked = Is_Recording();
+
+    if (m_locked) {
+        m_query_mutex.lock();
+    }
+}
+
+cUpdate_Jobs::Query_Lock::~Query_Lock(void)
+{
+    if (m_locked) {
+        m_query_mutex.unlock();
+    }
+}
+
+void cUpdate_Jobs::Worker_Loop(unsigned int index)
+{
+    m_thread_state.reset(&m_states[index]);
+
+    unsigned int generation = 0;
+
+    while (1) {
+        {
+            boost::unique_lock<boost::mutex> lock(m_mutex);
+
+            while (!m_quit && m_generation == generation) {
+                m_start_cond.wait(lock);
+            }
+
+            if (m_quit) {
+                return;
+            }
+
+            generation = m_generation;
+        }
+
+        Run_Chunk(index);
+
+        {
+            boost::lock_guard<boost::mutex> lock(m_mutex);
+            m_pending--;
+        }
+
+        m_done_cond.notify_one();
+    }
+}
+
+void cUpdate_Jobs::Run_Chunk(unsigned int index)
+{
+    const vector<cSprite*>& sprites = *m_sprites;
+    const size_t thread_count = m_states.size();
+    const size_t first = sprites.size() * index / thread_count;
+    const size_t last = sprites.size() * (index + 1) / thread_count;
+
+    try {
+        for (size_t i = first; i < last; i++) {
+            sprites[i]->Update();
+        }
+    }
+    catch (...) {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+
+        if (!m_error) {
+            m_error = std::current_exception();
+        }
+    }
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+cUpdate_Jobs* pUpdate_Jobs = NULL;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
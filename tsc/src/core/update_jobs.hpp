@@ -0,0 +1,135 @@
+/***************************************************************************
+ * update_jobs.h  -  Parallel sprite updates with a serial command merge
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_UPDATE_JOBS_HPP
+#define TSC_UPDATE_JOBS_HPP
+
+#include "../core/global_basic.hpp"
+#include "../core/global_game.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** cUpdate_Jobs *** *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Runs the Update() of sprites on worker threads
+     *
+     * The sprites are split into one contiguous chunk per thread and the
+     * main thread updates the first chunk itself. While updating in
+     * parallel a sprite may only change itself, everything changing
+     * shared state (the spatial hash, the active objects, sounds, the
+     * rand() sequence) has to be recorded with Defer() instead. The
+     * recorded commands are run afterwards on the main thread in the
+     * order of the sprites, so the result is the same as calling
+     * Update() on one sprite after another.
+     * Sprites whose update could depend on the result of such a command
+     * (searching a ground object, leaving the level) must not allow
+     * updating in parallel. As the spatial hash is not changed while
+     * updating in parallel collision queries can still be run inline
+     * when holding a Query_Lock.
+     */
+    class cUpdate_Jobs {
+    public:
+        typedef std::function<void(void)> Command;
+
+        cUpdate_Jobs(void);
+        ~cUpdate_Jobs(void);
+
+        /* Update the given sprites in parallel and run their deferred commands in order
+         * exceptions thrown by an Update() are rethrown after all threads finished
+        */
+        void Update(const vector<cSprite*>& sprites);
+
+        // Return the number of threads used for updating including the main thread
+        inline unsigned int Get_Thread_Count(void) const
+        {
+            return static_cast<unsigned int>(m_states.size());
+        }
+
+        // Return true if the calling thread is updating a sprite in parallel
+        static inline bool Is_Recording(void)
+        {
+            return m_recording && m_thread_state.get();
+        }
+        /* Record the command to run it in the serial merge
+         * must only be called if Is_Recording() is true
+        */
+        static void Defer(const Command& command);
+
+        /* Serializes the spatial hash queries of a parallel update
+         * they share scratch buffers of the spatial hash
+         * does nothing if not updating in parallel
+        */
+        class Query_Lock {
+        public:
+            Query_Lock(void);
+            ~Query_Lock(void);
+
+        private:
+            bool m_locked;
+        };
+
+    private:
+        // per thread update state
+        struct Thread_State {
+            // commands recorded for the sprites of this chunk in order
+            vector<Command> m_commands;
+        };
+        typedef vector<Thread_State> Thread_State_List;
+
+        // Wait for and run update generations until quitting
+        void Worker_Loop(unsigned int index);
+        // Update the chunk of the given thread
+        void Run_Chunk(unsigned int index);
+        // Thread states are owned by us
+        static void Release_Thread_State(Thread_State* state) {};
+
+        // one state per thread with the main thread first
+        Thread_State_List m_states;
+        boost::thread_group m_workers;
+
+        boost::mutex m_mutex;
+        // signals a new generation or quitting to the workers
+        boost::condition_variable m_start_cond;
+        // signals the main thread if all workers are finished
+        boost::condition_variable m_done_cond;
+        // increased for every parallel update
+        unsigned int m_generation;
+        // workers still updating the current generation
+        unsigned int m_pending;
+        bool m_quit;
+        // the first exception thrown by an update
+        std::exception_ptr m_error;
+
+        // sprites of the current generation
+        const vector<cSprite*>* m_sprites;
+
+        // if a parallel update is running
+        static bool m_recording;
+        // state of the calling thread while it updates a chunk
+        static boost::thread_specific_ptr<Thread_State> m_thread_state;
+        // held by a Query_Lock
+        static boost::mutex m_query_mutex;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// Parallel update jobs
+    extern cUpdate_Jobs* pUpdate_Jobs;
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
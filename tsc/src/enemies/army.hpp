@@ -85,6 +85,8 @@ namespace TSC {
 
         // update
         virtual void Update(void);
+        // standing up queries collisions
+        virtual bool Can_Update_Parallel(void) const;
 
         // Change state to walking if it is shell
         virtual void Stand_Up(void);
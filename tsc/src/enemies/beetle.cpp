@@ -157,6 +157,11 @@ void cBeetle::Update()
     Update_Animation();
 }
 
+bool cBeetle::Can_Update_Parallel(void) const
+{
+    return 0;
+}
+
 void cBeetle::Draw(cSurface_Request* p_request /* = NULL */)
 {
     if (!m_valid_draw)
@@ -45,6 +45,8 @@ namespace TSC {
         virtual cBeetle* Copy() const;
         virtual void Draw(cSurface_Request* p_request = NULL);
         virtual void Update();
+        // picks random directions while updating
+        virtual bool Can_Update_Parallel(void) const;
 
         virtual void Editor_Activate();
 
@@ -155,6 +155,11 @@ void cBeetleBarrage::Update()
     Update_Animation();
 }
 
+bool cBeetleBarrage::Can_Update_Parallel(void) const
+{
+    return 0;
+}
+
 void cBeetleBarrage::Draw(cSurface_Request* p_request /* = NULL */)
 {
     if (!m_valid_draw)
@@ -46,6 +46,8 @@ namespace TSC {
         virtual cBeetleBarrage* Copy() const;
         virtual void Draw(cSurface_Request* p_request = NULL);
         virtual void Update();
+        // spawns beetles while updating
+        virtual bool Can_Update_Parallel(void) const;
 
         virtual void Editor_Activate();
 
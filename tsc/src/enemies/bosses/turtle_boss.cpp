@@ -18,6 +18,7 @@
 #include "../../core/game_core.hpp"
 #include "../../objects/box.hpp"
 #include "../../video/animation.hpp"
+#include "../../video/particle_presets.hpp"
 #include "../../level/level_player.hpp"
 #include "../../level/level.hpp"
 #include "../../gui/hud.hpp"
@@ -536,6 +537,11 @@ void cTurtleBoss::Update(void)
     }
 }
 
+bool cTurtleBoss::Can_Update_Parallel(void) const
+{
+    return 0;
+}
+
 void cTurtleBoss::Stand_Up(void)
 {
     if (m_turtle_state != TURTLEBOSS_SHELL_STAND && m_turtle_state != TURTLEBOSS_SHELL_RUN) {
@@ -545,16 +551,14 @@ void cTurtleBoss::Stand_Up(void)
     // get space needed to stand up
     float move_y = m_image->m_col_h - ((m_walk_start >= 0) ? m_images[m_walk_start].m_image->m_col_h : 0);
 
-    cObjectCollisionType* col_list = Collision_Check_Relative(0.0f, move_y, 0.0f, 0.0f, COLLIDE_ONLY_BLOCKING);
+    cObjectCollisionType_Buffer col_list;
+    Collision_Check_Relative(*col_list, 0.0f, move_y, 0.0f, 0.0f, COLLIDE_ONLY_BLOCKING);
 
     // failed to stand up because something is blocking
     if (!col_list->empty()) {
-        delete col_list;
         return;
     }
 
-    delete col_list;
-
     pAudio->Play_Sound("enemy/boss/turtle/power_up.ogg");
     Col_Move(0.0f, move_y, 1, 1);
     Set_Turtle_Moving_State(TURTLEBOSS_WALK);
@@ -617,17 +621,16 @@ void cTurtleBoss::Throw_Fireballs(unsigned int amount /* = 6 */)
 void cTurtleBoss::Generate_Stars(unsigned int amount /* = 1 */, float particle_scale /* = 0.4f */) const
 {
     // animation
-    cParticle_Emitter* anim = new cParticle_Emitter(m_sprite_manager);
+    cParticle_Emitter* anim = pParticle_Preset_Manager->Create("turtle_boss_stars", m_sprite_manager);
+
+    if (!anim) {
+        return;
+    }
+
     anim->Set_Pos(m_pos_x + (m_col_rect.m_w * 0.5f), m_pos_y + (m_col_rect.m_h * 0.5f));
-    anim->Set_Image(pVideo->Get_Surface("animation/particles/star.png"));
     anim->Set_Quota(amount);
     anim->Set_Pos_Z(m_pos_z + m_pos_z_delta);
-    anim->Set_Const_Rotation_Z(-6.0f, 12.0f);
-    anim->Set_Time_to_Live(1.0f);
-    anim->Set_Speed(1.0f, 4.0f);
     anim->Set_Scale(particle_scale, 0.3f);
-    anim->Set_Color(orange, Color(static_cast<uint8_t>(6), 60, 20, 0));
-    anim->Set_Blending(BLEND_ADD);
     anim->Emit();
     pActive_Animation_Manager->Add(anim);
 }
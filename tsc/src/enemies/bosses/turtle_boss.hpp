@@ -89,6 +89,8 @@ namespace TSC {
 
         // update
         virtual void Update(void);
+        // picks random directions and moves while updating
+        virtual bool Can_Update_Parallel(void) const;
 
         // Change state to walking if it is shell
         void Stand_Up(void);
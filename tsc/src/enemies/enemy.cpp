@@ -17,6 +17,7 @@
 #include "../enemies/enemy.hpp"
 #include "../core/camera.hpp"
 #include "../video/animation.hpp"
+#include "../video/particle_presets.hpp"
 #include "../user/savegame/savegame.hpp"
 #include "../core/game_core.hpp"
 #include "../core/i18n.hpp"
@@ -159,9 +160,9 @@ void cEnemy::Update_Late(void)
 
         // handle collisions manually
         m_massive_type = MASS_MASSIVE;
-        cObjectCollisionType* col_list = Collision_Check(&m_col_rect);
+        cObjectCollisionType_Buffer col_list;
+        Collision_Check(*col_list, m_col_rect);
         Add_Collisions(col_list, 1);
-        delete col_list;
         Handle_Collisions();
         m_massive_type = MASS_PASSIVE;
     }
@@ -330,6 +331,45 @@ std::string cEnemy::Create_Name() const
     return ss.str();
 }
 
+bool cEnemy::Can_Be_Dormant(void) const
+{
+    if (m_dead) {
+        return 0;
+    }
+
+    return cMovingSprite::Can_Be_Dormant();
+}
+
+bool cEnemy::Can_Update_Parallel(void) const
+{
+    // the dying animation plays sounds and disables us
+    if (m_dead) {
+        return 0;
+    }
+
+    // leaving an image can draw a random branch
+    if (Has_Animation_Branches()) {
+        return 0;
+    }
+
+    // the ground object rect is read and could be changing in another thread
+    if (m_ground_object && m_ground_object->m_sprite_array == ARRAY_ENEMY) {
+        return 0;
+    }
+
+    // searching a new ground object needs a collision query
+    if (m_can_be_on_ground && !Is_On_Ground_Object()) {
+        return 0;
+    }
+
+    // a changed image could move us out of the level or off the ground
+    if (!Has_Constant_Collision_Rect()) {
+        return 0;
+    }
+
+    return 1;
+}
+
 bool cEnemy::Is_Update_Valid()
 {
     if (m_dead || m_freeze_counter)
@@ -341,13 +381,11 @@ bool cEnemy::Is_Update_Valid()
 void cEnemy::Ball_Destroy_Animation(const cBall& ball)
 {
     // animation
-    cParticle_Emitter* anim = new cParticle_Emitter(m_sprite_manager);
-    anim->Set_Image(pVideo->Get_Package_Surface("animation/particles/light.png"));
-    anim->Set_Time_to_Live(0.2f, 0.4f);
-    anim->Set_Fading_Alpha(1);
-    anim->Set_Fading_Size(1);
-    anim->Set_Speed(0.5f, 2.2f);
-    anim->Set_Blending(BLEND_DRIVE);
+    cParticle_Emitter* anim = pParticle_Preset_Manager->Create("enemy_ball_destroy", m_sprite_manager);
+
+    if (!anim) {
+        return;
+    }
 
     // enemy rect particle animation
     for (unsigned int w = 0; w < m_col_rect.m_w; w += 15) {
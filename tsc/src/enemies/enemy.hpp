@@ -66,6 +66,12 @@ namespace TSC {
          * use if it is needed that other objects are already updated
         */
         virtual void Update_Late(void);
+        /* if Update() can run on a worker thread
+         * enemies which spawn objects, use rand() or query collisions in their current state don't allow it
+        */
+        virtual bool Can_Update_Parallel(void) const;
+        // the dying animation has to finish to disable us
+        virtual bool Can_Be_Dormant(void) const;
         // update current velocity if needed
         void Update_Velocity(void);
 
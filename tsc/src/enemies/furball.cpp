@@ -502,6 +502,15 @@ void cFurball::Update(void)
     }
 }
 
+bool cFurball::Can_Update_Parallel(void) const
+{
+    if (m_state == STA_RUN) {
+        return 0;
+    }
+
+    return cEnemy::Can_Update_Parallel();
+}
+
 void cFurball::Generate_Smoke(unsigned int amount /* = 1 */, float particle_scale /* = 0.4f */) const
 {
     // animation
@@ -95,6 +95,8 @@ namespace TSC {
 
         // update
         virtual void Update(void);
+        // running spawns particles
+        virtual bool Can_Update_Parallel(void) const;
 
         // Generates Star Particles (only used if boss)
         void Generate_Smoke(unsigned int amount = 1, float particle_scale = 0.4f) const;
@@ -353,6 +353,11 @@ void cGee::Update(void)
     }
 }
 
+bool cGee::Can_Update_Parallel(void) const
+{
+    return 0;
+}
+
 void cGee::Draw(cSurface_Request* request /* = NULL */)
 {
     if (!m_valid_draw) {
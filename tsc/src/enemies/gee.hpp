@@ -72,6 +72,8 @@ namespace TSC {
 
         // update
         virtual void Update(void);
+        // picks random directions and spawns particles while updating
+        virtual bool Can_Update_Parallel(void) const;
         // draw
         virtual void Draw(cSurface_Request* request = NULL);
 
@@ -158,6 +158,24 @@ void cLarry::Update()
     }
 }
 
+bool cLarry::Can_Update_Parallel(void) const
+{
+    if (m_state == STA_RUN) {
+        return 0;
+    }
+
+    return cEnemy::Can_Update_Parallel();
+}
+
+bool cLarry::Can_Be_Dormant(void) const
+{
+    if (m_state == STA_RUN) {
+        return 0;
+    }
+
+    return cEnemy::Can_Be_Dormant();
+}
+
 void cLarry::Update_Normal_Dying()
 {
     // Hide larry behind the explosion clouds
@@ -28,6 +28,10 @@ namespace TSC {
 
         virtual cLarry* Copy() const;
         virtual void Update();
+        // running can explode
+        virtual bool Can_Update_Parallel(void) const;
+        // a lit fuse has to explode
+        virtual bool Can_Be_Dormant(void) const;
         virtual Col_Valid_Type Validate_Collision(cSprite* p_obj);
         virtual void Update_Normal_Dying();
         virtual void Handle_Collision_Massive(cObjectCollision* p_collision);
@@ -321,6 +321,11 @@ void cRokko::Update(void)
     }
 }
 
+bool cRokko::Can_Update_Parallel(void) const
+{
+    return 0;
+}
+
 void cRokko::Draw(cSurface_Request* request /* = NULL */)
 {
     if (!m_valid_draw) {
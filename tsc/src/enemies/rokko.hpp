@@ -74,6 +74,8 @@ namespace TSC {
 
         // update
         virtual void Update(void);
+        // spawns smoke while updating
+        virtual bool Can_Update_Parallel(void) const;
         // draw
         virtual void Draw(cSurface_Request* request = NULL);
 
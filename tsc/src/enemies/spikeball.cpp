@@ -342,6 +342,15 @@ void cSpikeball::Update(void)
     }
 }
 
+bool cSpikeball::Can_Update_Parallel(void) const
+{
+    if (m_state != STA_WALK) {
+        return 0;
+    }
+
+    return cEnemy::Can_Update_Parallel();
+}
+
 void cSpikeball::Update_Velocity_Max(void)
 {
     if (m_state == STA_WALK) {
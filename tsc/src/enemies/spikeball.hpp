@@ -72,6 +72,8 @@ namespace TSC {
 
         // update
         virtual void Update(void);
+        // only walking does not use rand() or spawn particles
+        virtual bool Can_Update_Parallel(void) const;
 
         // update maximum velocity values
         void Update_Velocity_Max(void);
@@ -17,6 +17,7 @@
 #include "../enemies/thromp.hpp"
 #include "../core/game_core.hpp"
 #include "../video/animation.hpp"
+#include "../video/particle_presets.hpp"
 #include "../level/level_player.hpp"
 #include "../level/level.hpp"
 #include "../gui/hud.hpp"
@@ -514,16 +515,15 @@ void cThromp::Generate_Smoke(unsigned int amount /* = 20 */) const
     }
 
     // animation
-    cParticle_Emitter* anim = new cParticle_Emitter(m_sprite_manager);
+    cParticle_Emitter* anim = pParticle_Preset_Manager->Create("thromp_smoke", m_sprite_manager);
+
+    if (!anim) {
+        return;
+    }
+
     anim->Set_Emitter_Rect(smoke_x, smoke_y, smoke_width, smoke_height);
-    anim->Set_Image(pVideo->Get_Package_Surface("animation/particles/smoke.png"));
     anim->Set_Quota(amount);
     anim->Set_Pos_Z(m_pos_z + m_pos_z_delta);
-    anim->Set_Time_to_Live(1, 1);
-    anim->Set_Direction_Range(180, 180);
-    anim->Set_Speed(0.05f, 0.4f);
-    anim->Set_Fading_Alpha(1);
-    anim->Set_Const_Rotation_Z(-2, 4);
     anim->Emit();
     pActive_Animation_Manager->Add(anim);
 }
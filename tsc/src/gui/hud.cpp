@@ -24,6 +24,7 @@
 #include "../core/sprite_manager.hpp"
 #include "../objects/bonusbox.hpp"
 #include "../video/renderer.hpp"
+#include "../video/particle_budget.hpp"
 #include "../core/i18n.hpp"
 #include "../core/filesystem/filesystem.hpp"
 #include "../scripting/events/gold_100_event.hpp"
@@ -692,6 +693,23 @@ void cFpsDisplay::Update(void)
             pFramerate->m_fps_average,
             pFramerate->m_speed_factor);
 
+    // level objects updated this frame
+    if (Game_Mode == MODE_LEVEL && pActive_Level) {
+        sprintf(m_fps_text + strlen(m_fps_text), "\nObjects: active %u dormant %u",
+                static_cast<unsigned int>(pActive_Level->m_sprite_manager->Get_Active_Count()),
+                static_cast<unsigned int>(pActive_Level->m_sprite_manager->Get_Dormant_Count()));
+    }
+
+    // particle budget
+    sprintf(m_fps_text + strlen(m_fps_text), "\nParticles: live %u quality %.2f dropped low %lu normal %lu",
+            pParticle_Budget->Get_Live_Count(),
+            pParticle_Budget->Get_Quality(),
+            pParticle_Budget->Get_Dropped_Count(PARTICLE_PRIORITY_LOW),
+            pParticle_Budget->Get_Dropped_Count(PARTICLE_PRIORITY_NORMAL));
+
+    // OpenGL state changes of the last frame
+    sprintf(m_fps_text + strlen(m_fps_text), "\nGL state changes: issued %u skipped %u", pGL_State->Get_Issued(), pGL_State->Get_Skipped());
+
     Prepare_Text_For_SFML(m_fps_text, cFont_Manager::FONTSIZE_VERYSMALL, white);
 }
 
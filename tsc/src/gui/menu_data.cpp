@@ -2721,6 +2721,7 @@ bool cMenu_Options::Video_Button_Apply_Clicked(const CEGUI::EventArgs& event)
     // draw reinitialization text
     Draw_Static_Text(_("Reinitialization"), &green, NULL, 0);
 
+    pVideo->Render_Finish();
     pGuiSystem->renderGUI();
     pRenderer->Render();
     pVideo->mp_window->display();
@@ -3488,6 +3489,7 @@ void cMenu_Credits::Init_GUI(void)
 void cMenu_Credits::Enter(const GameMode old_mode /* = MODE_NOTHING */)
 {
     // black background because of fade alpha
+    pVideo->Render_Finish();
     glClearColor(0, 0, 0, 1);
 
     if (old_mode == MODE_MENU) {
@@ -3503,6 +3505,7 @@ void cMenu_Credits::Leave(const GameMode next_mode /* = MODE_NOTHING */)
         Menu_Fade(0);
 
         // white background
+        pVideo->Render_Finish();
         glClearColor(1, 1, 1, 1);
     }
 
@@ -106,6 +106,8 @@ cLevel::cLevel(void)
 #endif
 
     m_sprite_manager = new cSprite_Manager();
+    // level tiles only change in the editor
+    m_sprite_manager->Enable_Static_Geometry();
     m_background_manager = new cBackground_Manager();
     m_animation_manager = new cAnimation_Manager();
 
@@ -596,8 +598,17 @@ void cLevel::Update(void)
             (*itr)->Update();
         }
 
+        // objects far away from the camera become dormant
+        if (pPreferences->m_activity_range > 0.0f) {
+            const float range = pPreferences->m_activity_range;
+            m_sprite_manager->Update_Activity(GL_rect(pActive_Camera->m_x - range, pActive_Camera->m_y - range, game_res_w + (range * 2.0f), game_res_h + (range * 2.0f)));
+        }
+        else {
+            m_sprite_manager->Wake_All();
+        }
+
         // objects
-        m_sprite_manager->Update_Items();
+        m_sprite_manager->Update_Items(pPreferences->m_parallel_update);
         // animations
         m_animation_manager->Update();
 
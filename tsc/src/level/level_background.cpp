@@ -18,6 +18,8 @@
 #include "../user/preferences.hpp"
 #include "../core/game_core.hpp"
 #include "../video/gl_surface.hpp"
+#include "../video/renderer.hpp"
+#include "../core/math/utilities.hpp"
 #include "../core/framerate.hpp"
 #include "../core/filesystem/resource_manager.hpp"
 #include "../core/filesystem/package_manager.hpp"
@@ -297,6 +299,10 @@ void cBackground::Draw(void)
             }
         }
 
+        if (Draw_Repeated(posx_final, posy_final)) {
+            return;
+        }
+
         // draw until width is filled
         while (posx_final < game_res_w) {
             // draw horizontal
@@ -320,6 +326,53 @@ void cBackground::Draw(void)
     }
 }
 
+bool cBackground::Draw_Repeated(float posx, float posy)
+{
+    // only the whole texture can be repeated and not a part of an atlas page
+    if (m_image_1->m_atlas || m_image_1->m_tex_x1 != 0.0f || m_image_1->m_tex_y1 != 0.0f || m_image_1->m_tex_x2 != 1.0f || m_image_1->m_tex_y2 != 1.0f) {
+        return 0;
+    }
+    // the tiles are not drawn with the size they are placed with
+    if (m_image_1->m_w != m_image_1->m_start_w || m_image_1->m_h != m_image_1->m_start_h || m_image_1->m_w <= 0.0f || m_image_1->m_h <= 0.0f) {
+        return 0;
+    }
+    // rotated
+    if (m_image_1->m_base_rot_x != 0.0f || m_image_1->m_base_rot_y != 0.0f || m_image_1->m_base_rot_z != 0.0f) {
+        return 0;
+    }
+    // repeating non power of two textures needs OpenGL 2.0
+    if ((Get_Power_of_2(m_image_1->m_tex_w) != m_image_1->m_tex_w || Get_Power_of_2(m_image_1->m_tex_h) != m_image_1->m_tex_h) && !GLEW_VERSION_2_0 && !GLEW_ARB_texture_non_power_of_two) {
+        return 0;
+    }
+
+    cSurface_Request* request = new cSurface_Request();
+    m_image_1->Blit_Data(request);
+    request->m_repeat = 1;
+    request->m_pos_z = m_pos_z;
+
+    // the texture coordinates are scrolled instead of the position
+    request->m_pos_x = 0.0f;
+    request->m_w = static_cast<float>(game_res_w);
+    request->m_tex_x1 = -(posx + m_image_1->m_int_x) / m_image_1->m_w;
+    request->m_tex_x2 = request->m_tex_x1 + (request->m_w / m_image_1->m_w);
+
+    // fill the screen height
+    if (m_type == BG_IMG_ALL) {
+        request->m_pos_y = 0.0f;
+        request->m_h = static_cast<float>(game_res_h);
+        request->m_tex_y1 = -(posy + m_image_1->m_int_y) / m_image_1->m_h;
+        request->m_tex_y2 = request->m_tex_y1 + (request->m_h / m_image_1->m_h);
+    }
+    // one row
+    else {
+        request->m_pos_y += posy;
+    }
+
+    pRenderer->Add(request);
+
+    return 1;
+}
+
 void cBackground::Draw_Gradient(void)
 {
     // no need to draw a gradient if both colors are the same
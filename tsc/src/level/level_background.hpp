@@ -88,6 +88,10 @@ namespace TSC {
         void Draw(void);
         // draw gradient
         void Draw_Gradient(void);
+        /* draw the image as one quad with a repeated texture from the aligned start position
+         * returns false if the texture can not be repeated
+        */
+        bool Draw_Repeated(float posx, float posy);
 
         // Returns the name of the current type
         std::string Get_Type_Name(void) const;
@@ -117,6 +117,11 @@ void cEditor_Level::Disable(bool native_mode /* = 0 */)
         editor_enabled = 0;
     }
 
+    /* moved tiles were already refitted in the static collision tree
+     * but newly placed ones are still dynamic
+    */
+    m_sprite_manager->Bake_Static_Collision();
+
     cEditor::Disable(native_mode);
 }
 
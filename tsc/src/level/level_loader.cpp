@@ -104,6 +104,9 @@ void cLevelLoader::on_end_document()
     // engine version entry not set
     if (mp_level->m_engine_version < 0)
         mp_level->m_engine_version = 0;
+
+    // all tiles are loaded now
+    mp_level->m_sprite_manager->Bake_Static_Collision();
 }
 
 void cLevelLoader::on_start_element(const Glib::ustring& name, const xmlpp::SaxParser::AttributeList& properties)
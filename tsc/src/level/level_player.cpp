@@ -531,6 +531,8 @@ void cLevel_Player::Generate_Feet_Clouds(cParticle_Emitter* anim /* = NULL */)
 
     anim->Set_Emitter_Rect(m_col_rect.m_x, m_col_rect.m_y + m_col_rect.m_h - 2.0f, m_col_rect.m_w);
     anim->Set_Pos_Z(m_pos_z - m_pos_z_delta);
+    // only decoration
+    anim->Set_Priority(PARTICLE_PRIORITY_LOW);
 
     float vel;
 
@@ -22,6 +22,7 @@
 #include "../enemies/spika.hpp"
 #include "../level/level_player.hpp"
 #include "../video/animation.hpp"
+#include "../video/particle_presets.hpp"
 #include "../level/level.hpp"
 #include "../gui/hud.hpp"
 #include "../core/sprite_manager.hpp"
@@ -79,6 +80,8 @@ void cBall::Init(void)
     m_camera_range = 2000;
 
     m_massive_type = MASS_MASSIVE;
+    // fast moving
+    m_col_move_type = COL_MOVE_SWEPT;
 
     m_glim_mod = 0.1f;
     m_glim_counter = 0.0f;
@@ -260,6 +263,11 @@ void cBall::Draw(cSurface_Request* request /* = NULL */)
     cMovingSprite::Draw(request);
 }
 
+bool cBall::Can_Be_Dormant(void) const
+{
+    return 0;
+}
+
 void cBall::Generate_Particles(cParticle_Emitter* anim /* = NULL */) const
 {
     bool create_anim = 0;
@@ -423,19 +431,14 @@ void cBall::Handle_Collision_Massive(cObjectCollision* collision)
             m_vely = -5.0f;
 
             // create animation
-            cParticle_Emitter* anim = new cParticle_Emitter(m_sprite_manager);
-            anim->Set_Pos(m_pos_x + m_col_rect.m_w / 2, m_pos_y + m_col_rect.m_h / 2, 1);
-            anim->Set_Image(pVideo->Get_Package_Surface("animation/particles/cloud.png"));
-            anim->Set_Direction_Range(0, 180);
-            anim->Set_Quota(3);
-            anim->Set_Time_to_Live(0.8f);
-            anim->Set_Pos_Z(m_pos_z + 0.0001f);
-            anim->Set_Color(Color(static_cast<uint8_t>(50), 50, 250));
-            anim->Set_Blending(BLEND_ADD);
-            anim->Set_Speed(0.5f, 0.4f);
-            anim->Set_Scale(0.3f, 0.4f);
-            anim->Emit();
-            pActive_Animation_Manager->Add(anim);
+            cParticle_Emitter* anim = pParticle_Preset_Manager->Create("iceball_bounce", m_sprite_manager);
+
+            if (anim) {
+                anim->Set_Pos(m_pos_x + m_col_rect.m_w / 2, m_pos_y + m_col_rect.m_h / 2, 1);
+                anim->Set_Pos_Z(m_pos_z + 0.0001f);
+                anim->Emit();
+                pActive_Animation_Manager->Add(anim);
+            }
         }
     }
     // other directions
@@ -63,6 +63,8 @@ namespace TSC {
         virtual void Update(void);
         // draw
         virtual void Draw(cSurface_Request* request = NULL);
+        // destroys itself when out of range
+        virtual bool Can_Be_Dormant(void) const;
 
         // Generate the default animation Particles
         void Generate_Particles(cParticle_Emitter* anim = NULL) const;
@@ -357,7 +357,8 @@ void cBaseBox::Check_Collision(ObjectDirection col_direction)
     }
 
     // collision count
-    cObjectCollisionType* col_list = Collision_Check_Relative(check_x, check_y, m_col_rect.m_w - (check_x * 0.5f), m_col_rect.m_h - (check_y * 0.5f));
+    cObjectCollisionType_Buffer col_list;
+    Collision_Check_Relative(*col_list, check_x, check_y, m_col_rect.m_w - (check_x * 0.5f), m_col_rect.m_h - (check_y * 0.5f));
 
     // handle collisions
     for (cObjectCollision_List::iterator itr = col_list->objects.begin(); itr != col_list->objects.end(); ++itr) {
@@ -367,8 +368,6 @@ void cBaseBox::Check_Collision(ObjectDirection col_direction)
         col_obj->m_obj->Handle_Collision_Box(Get_Opposite_Direction(col_obj->m_direction), &m_col_rect);
 
     }
-
-    delete col_list;
 }
 
 void cBaseBox::Activate(void)
@@ -530,6 +529,15 @@ void cBaseBox::Generate_Activation_Particles(void)
     }
 }
 
+bool cBaseBox::Can_Be_Dormant(void) const
+{
+    if (m_move_col_dir != DIR_UNDEFINED) {
+        return 0;
+    }
+
+    return cMovingSprite::Can_Be_Dormant();
+}
+
 bool cBaseBox::Is_Update_Valid()
 {
     // if not activateable and not animating
@@ -92,6 +92,8 @@ namespace TSC {
 
         // if update is valid for the current state
         virtual bool Is_Update_Valid();
+        // the activation movement has to finish
+        virtual bool Can_Be_Dormant(void) const;
         // if draw is valid for the current state and position
         virtual bool Is_Draw_Valid(void);
 
@@ -0,0 +1,196 @@
+/***************************************************************************
+ * collision_proxy.cpp  -  merged collision rect of level tiles
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../objects/collision_proxy.hpp"
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** *** Helpers *** *** *** *** *** *** *** *** *** */
+
+// Return the sprite type of the tile or of the tiles merged into the proxy
+static inline SpriteType Get_Tile_Type(const cSprite* sprite)
+{
+    if (sprite->m_type == TYPE_COLLISION_PROXY) {
+        return static_cast<const cCollision_Proxy*>(sprite)->m_tile_type;
+    }
+
+    return sprite->m_type;
+}
+
+/* *** *** *** *** *** cCollision_Proxy *** *** *** *** *** *** *** *** *** *** *** *** */
+
+cCollision_Proxy::cCollision_Proxy(cSprite_Manager* sprite_manager, cSprite* tile, unsigned long order)
+    : cSprite(sprite_manager, "collision_proxy")
+{
+    m_sprite_array = tile->m_sprite_array;
+    m_type = TYPE_COLLISION_PROXY;
+    m_tile_type = tile->m_type;
+    m_massive_type = tile->m_massive_type;
+    m_can_be_ground = tile->m_can_be_ground;
+
+    m_col_rect = tile->m_col_rect;
+    m_rect = m_col_rect;
+    m_pos_x = m_col_rect.m_x;
+    m_pos_y = m_col_rect.m_y;
+
+    m_tiles.push_back(tile);
+    m_tile_orders.push_back(order);
+}
+
+cCollision_Proxy::~cCollision_Proxy(void)
+{
+    //
+}
+
+bool cCollision_Proxy::Is_Mergeable(const cSprite* tile)
+{
+    // only plain tiles as derived classes handle collisions themselves
+    if (typeid(*tile) != typeid(cSprite)) {
+        return 0;
+    }
+
+    if (!tile->Is_Static_Collision()) {
+        return 0;
+    }
+
+    // animations change the image and collision rect
+    if (tile->m_anim_enabled) {
+        return 0;
+    }
+
+    // no collision rect
+    if (tile->m_col_rect.m_w <= 0.0f || tile->m_col_rect.m_h <= 0.0f) {
+        return 0;
+    }
+
+    return 1;
+}
+
+bool cCollision_Proxy::Is_Same_Type(const cSprite* a, const cSprite* b)
+{
+    return a->m_sprite_array == b->m_sprite_array && Get_Tile_Type(a) == Get_Tile_Type(b) && a->m_massive_type == b->m_massive_type && a->m_can_be_ground == b->m_can_be_ground;
+}
+
+void cCollision_Proxy::Add_Tile(cSprite* tile, unsigned long order)
+{
+    float x2 = std::max(m_col_rect.m_x + m_col_rect.m_w, tile->m_col_rect.m_x + tile->m_col_rect.m_w);
+    float y2 = std::max(m_col_rect.m_y + m_col_rect.m_h, tile->m_col_rect.m_y + tile->m_col_rect.m_h);
+
+    m_col_rect.m_x = std::min(m_col_rect.m_x, tile->m_col_rect.m_x);
+    m_col_rect.m_y = std::min(m_col_rect.m_y, tile->m_col_rect.m_y);
+    m_col_rect.m_w = x2 - m_col_rect.m_x;
+    m_col_rect.m_h = y2 - m_col_rect.m_y;
+
+    m_rect = m_col_rect;
+    m_pos_x = m_col_rect.m_x;
+    m_pos_y = m_col_rect.m_y;
+
+    m_tiles.push_back(tile);
+    m_tile_orders.push_back(order);
+}
+
+void cCollision_Proxy::Add_Tiles(const cCollision_Proxy* proxy)
+{
+    for (size_t i = 0; i < proxy->m_tiles.size(); i++) {
+        Add_Tile(proxy->m_tiles[i], proxy->m_tile_orders[i]);
+    }
+}
+
+cSprite* cCollision_Proxy::Get_Tile(const GL_rect& rect) const
+{
+    const float x = rect.m_x + rect.m_w * 0.5f;
+    const float y = rect.m_y + rect.m_h * 0.5f;
+
+    cSprite* nearest = NULL;
+    float nearest_distance = 0.0f;
+
+    for (cSprite_List::const_iterator itr = m_tiles.begin(); itr != m_tiles.end(); ++itr) {
+        const GL_rect& tile_rect = (*itr)->m_col_rect;
+
+        // distance from the rect center to the tile
+        float dist_x = std::max(std::max(tile_rect.m_x - x, x - (tile_rect.m_x + tile_rect.m_w)), 0.0f);
+        float dist_y = std::max(std::max(tile_rect.m_y - y, y - (tile_rect.m_y + tile_rect.m_h)), 0.0f);
+        float distance = dist_x * dist_x + dist_y * dist_y;
+
+        if (!nearest || distance < nearest_distance) {
+            nearest = (*itr);
+            nearest_distance = distance;
+        }
+    }
+
+    return nearest;
+}
+
+unsigned long cCollision_Proxy::Get_Order(void) const
+{
+    return *std::min_element(m_tile_orders.begin(), m_tile_orders.end());
+}
+
+// compare the collision properties first so equal tiles are next to each other
+static inline int Compare_Collision_Type(const cSprite* a, const cSprite* b)
+{
+    if (a->m_sprite_array != b->m_sprite_array) {
+        return (a->m_sprite_array < b->m_sprite_array) ? (-1) : (1);
+    }
+    if (Get_Tile_Type(a) != Get_Tile_Type(b)) {
+        return (Get_Tile_Type(a) < Get_Tile_Type(b)) ? (-1) : (1);
+    }
+    if (a->m_massive_type != b->m_massive_type) {
+        return (a->m_massive_type < b->m_massive_type) ? (-1) : (1);
+    }
+    if (a->m_can_be_ground != b->m_can_be_ground) {
+        return (a->m_can_be_ground < b->m_can_be_ground) ? (-1) : (1);
+    }
+
+    return 0;
+}
+
+bool cCollision_Proxy::row_sort::operator()(const cSprite* a, const cSprite* b) const
+{
+    int type = Compare_Collision_Type(a, b);
+
+    if (type != 0) {
+        return type < 0;
+    }
+    if (a->m_col_rect.m_y != b->m_col_rect.m_y) {
+        return a->m_col_rect.m_y < b->m_col_rect.m_y;
+    }
+    if (a->m_col_rect.m_h != b->m_col_rect.m_h) {
+        return a->m_col_rect.m_h < b->m_col_rect.m_h;
+    }
+
+    return a->m_col_rect.m_x < b->m_col_rect.m_x;
+}
+
+bool cCollision_Proxy::column_sort::operator()(const cSprite* a, const cSprite* b) const
+{
+    int type = Compare_Collision_Type(a, b);
+
+    if (type != 0) {
+        return type < 0;
+    }
+    if (a->m_col_rect.m_x != b->m_col_rect.m_x) {
+        return a->m_col_rect.m_x < b->m_col_rect.m_x;
+    }
+    if (a->m_col_rect.m_w != b->m_col_rect.m_w) {
+        return a->m_col_rect.m_w < b->m_col_rect.m_w;
+    }
+
+    return a->m_col_rect.m_y < b->m_col_rect.m_y;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
@@ -0,0 +1,79 @@
+/***************************************************************************
+ * collision_proxy.h  -  merged collision rect of level tiles
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_COLLISION_PROXY_HPP
+#define TSC_COLLISION_PROXY_HPP
+
+#include "../core/global_basic.hpp"
+#include "../objects/sprite.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** cCollision_Proxy *** *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Collision only sprite covering touching level tiles with the same
+     * collision properties, e.g. a long ground strip. The sprite manager
+     * puts it into the static collision tree instead of the tiles, which
+     * are still drawn and updated as usual. A collision with the proxy is
+     * reported as a collision with every merged tile touched, the same as
+     * without merging. It has the TYPE_COLLISION_PROXY sprite type, the
+     * type of the tiles is kept in m_tile_type.
+     * It is not part of the sprite manager objects and never drawn or saved.
+    */
+    class cCollision_Proxy : public cSprite {
+    public:
+        // create with the given tile
+        cCollision_Proxy(cSprite_Manager* sprite_manager, cSprite* tile, unsigned long order);
+        // destructor
+        virtual ~cCollision_Proxy(void);
+
+        // Return true if the given tile can be merged
+        static bool Is_Mergeable(const cSprite* tile);
+        // Return true if the given tiles have the same collision properties
+        static bool Is_Same_Type(const cSprite* a, const cSprite* b);
+
+        // Add the tile and extend the collision rect to include it
+        void Add_Tile(cSprite* tile, unsigned long order);
+        // Add the tiles of the given proxy
+        void Add_Tiles(const cCollision_Proxy* proxy);
+        // Return the merged tile nearest to the given rect
+        cSprite* Get_Tile(const GL_rect& rect) const;
+        // Return the lowest spatial hash order of the merged tiles
+        unsigned long Get_Order(void) const;
+
+        // sprite type of the merged tiles
+        SpriteType m_tile_type;
+        // merged tiles
+        cSprite_List m_tiles;
+        // spatial hash order of the merged tiles
+        vector<unsigned long> m_tile_orders;
+
+        // Sort for merging rows
+        struct row_sort {
+            bool operator()(const cSprite* a, const cSprite* b) const;
+        };
+        // Sort for merging rows into columns
+        struct column_sort {
+            bool operator()(const cSprite* a, const cSprite* b) const;
+        };
+    };
+
+    typedef vector<cCollision_Proxy*> cCollision_Proxy_List;
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
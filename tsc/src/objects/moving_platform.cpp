@@ -110,6 +110,8 @@ void cMoving_Platform::Init(void)
     m_pos_z = 0.085f;
     m_gravity_max = 25.0f;
     m_can_be_on_ground = 0;
+    // can fall fast
+    m_col_move_type = COL_MOVE_SWEPT;
 
     m_camera_range = 3000;
     m_can_be_ground = 1;
@@ -785,6 +787,8 @@ void cMoving_Platform::Update_Rect(void)
     // set height
     m_col_rect.m_h = m_rect.m_h;
     m_start_rect.m_h = m_rect.m_h;
+
+    Update_Spatial_Index();
 }
 
 void cMoving_Platform::Update_Velocity(void)
@@ -832,6 +836,25 @@ bool cMoving_Platform::Is_Update_Valid()
     return 1;
 }
 
+bool cMoving_Platform::Can_Be_Dormant(void) const
+{
+    // touched, shaking or falling
+    if (m_platform_state != MOVING_PLATFORM_STAY) {
+        return 0;
+    }
+
+    if (m_move_type == MOVING_PLATFORM_TYPE_PATH || m_move_type == MOVING_PLATFORM_TYPE_PATH_BACKWARDS) {
+        return 0;
+    }
+
+    // line and circle platforms would get out of phase with the level
+    if ((m_move_type == MOVING_PLATFORM_TYPE_LINE || m_move_type == MOVING_PLATFORM_TYPE_CIRCLE) && m_speed) {
+        return 0;
+    }
+
+    return cMovingSprite::Can_Be_Dormant();
+}
+
 bool cMoving_Platform::Is_Draw_Valid(void)
 {
     bool valid = cMovingSprite::Is_Draw_Valid();
@@ -127,6 +127,8 @@ namespace TSC {
         virtual bool Is_Update_Valid();
         // if draw is valid for the current state and position
         virtual bool Is_Draw_Valid(void);
+        // moving, falling or shaking platforms have to keep running
+        virtual bool Can_Be_Dormant(void) const;
 
         /* Validate the given collision object
          * returns 0 if not valid
@@ -142,6 +142,7 @@ void cMovingSprite::Init(void)
     m_start_direction = DIR_UNDEFINED;
     m_can_be_on_ground = 1;
     m_ground_object = NULL;
+    m_col_move_type = COL_MOVE_STEPS;
 
     m_ice_resistance = 0.0f;
     m_freeze_counter = 0.0f;
@@ -157,6 +158,7 @@ cMovingSprite* cMovingSprite::Copy(void) const
     moving_sprite->Set_Massive_Type(m_massive_type);
     moving_sprite->m_can_be_ground = m_can_be_ground;
     moving_sprite->m_can_be_on_ground = m_can_be_on_ground;
+    moving_sprite->m_col_move_type = m_col_move_type;
     moving_sprite->Set_Ignore_Camera(m_no_camera);
     moving_sprite->Set_Shadow_Pos(m_shadow_pos);
     moving_sprite->Set_Shadow_Color(m_shadow_color);
@@ -228,16 +230,13 @@ void cMovingSprite::Move(float move_x, float move_y, bool real /* = 0 */)
     Check_And_Handle_Out_Of_Level(move_x, move_y);
 }
 
-cObjectCollisionType* cMovingSprite::Col_Move_in_Steps(float move_x, float move_y, float step_size_x, float step_size_y, float final_pos_x, float final_pos_y, cSprite_List sprite_list, bool stop_on_internal /* = 0 */)
+void cMovingSprite::Col_Move_in_Steps(cObjectCollisionType& col_list, float move_x, float move_y, float step_size_x, float step_size_y, float final_pos_x, float final_pos_y, cSprite_List& sprite_list, bool stop_on_internal /* = 0 */)
 {
     if (sprite_list.empty()) {
         cSprite::Move(final_pos_x - m_pos_x, final_pos_y - m_pos_y, 1);
-        return NULL;
+        return;
     }
 
-    // collision list
-    cObjectCollisionType* col_list = new cObjectCollisionType();
-
     bool move_x_valid = 1;
     bool move_y_valid = 1;
 
@@ -253,24 +252,29 @@ cObjectCollisionType* cMovingSprite::Col_Move_in_Steps(float move_x, float move_
             }
 
             // collision check
-            cObjectCollisionType* col_list_temp = Collision_Check_Relative(step_size_x, 0.0f, 0.0f, 0.0f, COLLIDE_COMPLETE, &sprite_list);
+            const size_t col_start = col_list.size();
+            Collision_Check_Relative(col_list, step_size_x, 0.0f, 0.0f, 0.0f, COLLIDE_COMPLETE, &sprite_list);
 
             bool collision_found = 0;
 
             // stop on everything
             if (stop_on_internal) {
-                if (col_list_temp->size()) {
+                if (col_list.size() > col_start) {
                     collision_found = 1;
                 }
             }
             // stop only on blocking
             else {
-                if (col_list_temp->Is_Included(COL_VTYPE_BLOCKING)) {
-                    collision_found = 1;
+                for (cObjectCollision_List::iterator itr = col_list.objects.begin() + col_start; itr != col_list.objects.end(); ++itr) {
+                    if ((*itr)->m_valid_type == COL_VTYPE_BLOCKING) {
+                        collision_found = 1;
+                        break;
+                    }
                 }
+
                 // remove internal collision from further checks
-                else if (col_list_temp->objects.size()) {
-                    for (cObjectCollision_List::iterator itr = col_list_temp->objects.begin(); itr != col_list_temp->objects.end(); ++itr) {
+                if (!collision_found && col_list.size() > col_start) {
+                    for (cObjectCollision_List::iterator itr = col_list.objects.begin() + col_start; itr != col_list.objects.end(); ++itr) {
                         cObjectCollision* col = (*itr);
 
                         if (col->m_valid_type != COL_VTYPE_INTERNAL) {
@@ -278,7 +282,7 @@ cObjectCollisionType* cMovingSprite::Col_Move_in_Steps(float move_x, float move_
                         }
 
                         // find in sprite list
-                        cSprite_List::iterator sprite_itr = std::find(sprite_list.begin(), sprite_list.end(), col->m_obj);
+                        cSprite_List::iterator sprite_itr = std::find(sprite_list.begin(), sprite_list.end(), col->m_check_obj);
 
                         // not found
                         if (sprite_itr == sprite_list.end()) {
@@ -296,13 +300,6 @@ cObjectCollisionType* cMovingSprite::Col_Move_in_Steps(float move_x, float move_
                 }
             }
 
-            if (col_list_temp->size()) {
-                col_list->objects.insert(col_list->objects.end(), col_list_temp->objects.begin(), col_list_temp->objects.end());
-                col_list_temp->objects.clear();
-            }
-
-            delete col_list_temp;
-
             if (!collision_found) {
                 m_pos_x += step_size_x;
 
@@ -330,24 +327,29 @@ cObjectCollisionType* cMovingSprite::Col_Move_in_Steps(float move_x, float move_
             }
 
             // collision check
-            cObjectCollisionType* col_list_temp = Collision_Check_Relative(0.0f, step_size_y, 0.0f, 0.0f, COLLIDE_COMPLETE, &sprite_list);
+            const size_t col_start = col_list.size();
+            Collision_Check_Relative(col_list, 0.0f, step_size_y, 0.0f, 0.0f, COLLIDE_COMPLETE, &sprite_list);
 
             bool collision_found = 0;
 
             // stop on everything
             if (stop_on_internal) {
-                if (col_list_temp->size()) {
+                if (col_list.size() > col_start) {
                     collision_found = 1;
                 }
             }
             // stop only on blocking
             else {
-                if (col_list_temp->Is_Included(COL_VTYPE_BLOCKING)) {
-                    collision_found = 1;
+                for (cObjectCollision_List::iterator itr = col_list.objects.begin() + col_start; itr != col_list.objects.end(); ++itr) {
+                    if ((*itr)->m_valid_type == COL_VTYPE_BLOCKING) {
+                        collision_found = 1;
+                        break;
+                    }
                 }
+
                 // remove internal collision from further checks
-                else if (col_list_temp->objects.size()) {
-                    for (cObjectCollision_List::iterator itr = col_list_temp->objects.begin(); itr != col_list_temp->objects.end(); ++itr) {
+                if (!collision_found && col_list.size() > col_start) {
+                    for (cObjectCollision_List::iterator itr = col_list.objects.begin() + col_start; itr != col_list.objects.end(); ++itr) {
                         cObjectCollision* col = (*itr);
 
                         if (col->m_valid_type != COL_VTYPE_INTERNAL) {
@@ -355,7 +357,7 @@ cObjectCollisionType* cMovingSprite::Col_Move_in_Steps(float move_x, float move_
                         }
 
                         // find in sprite list
-                        cSprite_List::iterator sprite_itr = std::find(sprite_list.begin(), sprite_list.end(), col->m_obj);
+                        cSprite_List::iterator sprite_itr = std::find(sprite_list.begin(), sprite_list.end(), col->m_check_obj);
 
                         // not found
                         if (sprite_itr == sprite_list.end()) {
@@ -373,13 +375,6 @@ cObjectCollisionType* cMovingSprite::Col_Move_in_Steps(float move_x, float move_
                 }
             }
 
-            if (col_list_temp->size()) {
-                col_list->objects.insert(col_list->objects.end(), col_list_temp->objects.begin(), col_list_temp->objects.end());
-                col_list_temp->objects.clear();
-            }
-
-            delete col_list_temp;
-
             if (!collision_found) {
                 m_pos_y += step_size_y;
 
@@ -399,8 +394,239 @@ cObjectCollisionType* cMovingSprite::Col_Move_in_Steps(float move_x, float move_
             }
         }
     }
+}
 
-    return col_list;
+/* An object touched by a swept movement
+ * the entry time is calculated once per object and sweep
+*/
+struct cSwept_Contact {
+    cSprite* m_obj;
+    // the checked object which is the collision proxy if m_obj is a merged tile
+    cSprite* m_check_obj;
+    // position in the checked objects
+    size_t m_num;
+    // position in the tiles of a collision proxy
+    size_t m_tile;
+    float m_time_entry;
+    // if it starts touching on the horizontal axis
+    bool m_entry_x;
+};
+
+// sort by entry time and then by the position in the checked objects
+struct swept_contact_sort {
+    bool operator()(const cSwept_Contact& a, const cSwept_Contact& b) const
+    {
+        if (a.m_time_entry != b.m_time_entry) {
+            return a.m_time_entry < b.m_time_entry;
+        }
+
+        if (a.m_num != b.m_num) {
+            return a.m_num < b.m_num;
+        }
+
+        return a.m_tile < b.m_tile;
+    }
+};
+
+// Set the contact with the object and return true if it is touched along the movement
+static bool Get_Swept_Contact(const GL_rect& rect, float move_x, float move_y, cSprite* obj, cSwept_Contact& contact)
+{
+    float time_exit;
+
+    if (!Col_Box_Swept(rect, move_x, move_y, obj->m_col_rect, contact.m_time_entry, time_exit, &contact.m_entry_x)) {
+        return 0;
+    }
+    // only touched at the start and moving away from it
+    if (time_exit <= 0.0f) {
+        return 0;
+    }
+
+    contact.m_obj = obj;
+    return 1;
+}
+
+/* objects touched in the current swept pass
+ * reused to not allocate on every pass, per thread for the parallel update
+*/
+static thread_local vector<cSwept_Contact> swept_contacts;
+
+// distance kept to a blocking object so sliding along it does not touch it
+static const float swept_block_gap = 0.01f;
+
+// Return the distance to move back from a blocking object after moving the given distance towards it
+static float Get_Swept_Block_Gap(float moved)
+{
+    // not behind the start position
+    const float gap = (fabs(moved) < swept_block_gap) ? (fabs(moved)) : (swept_block_gap);
+
+    return (moved < 0.0f) ? (-gap) : (gap);
+}
+
+void cMovingSprite::Col_Move_Swept(cObjectCollisionType& col_list, float move_x, float move_y, cSprite_List& sprite_list)
+{
+    if (sprite_list.empty()) {
+        cSprite::Move(move_x, move_y, 1);
+        return;
+    }
+
+    // every blocking collision stops one axis and the rest of the other one is swept again
+    while (!Is_Float_Equal(move_x, 0.0f) || !Is_Float_Equal(move_y, 0.0f)) {
+        Col_Move_Swept_Pass(col_list, move_x, move_y, sprite_list);
+    }
+}
+
+void cMovingSprite::Col_Move_Swept_Pass(cObjectCollisionType& col_list, float& move_x, float& move_y, cSprite_List& sprite_list)
+{
+    const GL_rect start_rect = m_col_rect;
+    const float start_pos_x = m_pos_x;
+    const float start_pos_y = m_pos_y;
+    const size_t col_start = col_list.size();
+
+    // objects touched somewhere along the movement
+    vector<cSwept_Contact>& contacts = swept_contacts;
+    contacts.clear();
+
+    for (size_t i = 0; i < sprite_list.size(); i++) {
+        cSprite* obj = sprite_list[i];
+        cSwept_Contact contact;
+
+        contact.m_check_obj = obj;
+        contact.m_num = i;
+        contact.m_tile = 0;
+
+        if (!Is_Collision_Object(obj) || !Get_Swept_Contact(start_rect, move_x, move_y, obj, contact)) {
+            continue;
+        }
+
+        // every touched tile of a collision proxy
+        if (obj->m_type == TYPE_COLLISION_PROXY) {
+            const cSprite_List& tiles = static_cast<cCollision_Proxy*>(obj)->m_tiles;
+            const size_t count = contacts.size();
+
+            for (size_t j = 0; j < tiles.size(); j++) {
+                cSwept_Contact tile_contact = contact;
+                tile_contact.m_tile = j;
+
+                if (Get_Swept_Contact(start_rect, move_x, move_y, tiles[j], tile_contact)) {
+                    contacts.push_back(tile_contact);
+                }
+            }
+
+            // only touched between the tiles
+            if (contacts.size() > count) {
+                continue;
+            }
+        }
+
+        contacts.push_back(contact);
+    }
+
+    std::sort(contacts.begin(), contacts.end(), swept_contact_sort());
+
+    // the first blocking contact
+    const cSwept_Contact* blocked = NULL;
+
+    for (vector<cSwept_Contact>::const_iterator itr = contacts.begin(); itr != contacts.end(); ++itr) {
+        const cSwept_Contact& contact = (*itr);
+
+        if (blocked) {
+            // contacts touched together with the blocking one are also added
+            if (!Is_Float_Equal(contact.m_time_entry, blocked->m_time_entry)) {
+                break;
+            }
+        }
+        // validate at the position when reaching it
+        else {
+            m_pos_x = start_pos_x + move_x * contact.m_time_entry;
+            m_pos_y = start_pos_y + move_y * contact.m_time_entry;
+            Update_Position_Rect();
+        }
+
+        Col_Valid_Type col_valid = Validate_Collision(contact.m_obj);
+
+        if (col_valid == COL_VTYPE_NOT_VALID) {
+            continue;
+        }
+
+        cObjectCollision* collision = Create_Collision_Object(this, contact.m_obj, col_valid);
+        // removed from further checks as the checked object
+        collision->m_check_obj = contact.m_check_obj;
+        col_list.Add(collision);
+
+        if (col_valid == COL_VTYPE_BLOCKING && !blocked) {
+            blocked = &contact;
+        }
+    }
+
+    // remove internal collision from further checks
+    for (cObjectCollision_List::iterator itr = col_list.objects.begin() + col_start; itr != col_list.objects.end(); ++itr) {
+        cObjectCollision* col = (*itr);
+
+        if (col->m_valid_type != COL_VTYPE_INTERNAL) {
+            continue;
+        }
+
+        cSprite_List::iterator sprite_itr = std::find(sprite_list.begin(), sprite_list.end(), col->m_check_obj);
+
+        if (sprite_itr != sprite_list.end()) {
+            sprite_list.erase(sprite_itr);
+        }
+    }
+
+    // move to final position
+    if (!blocked) {
+        m_pos_x = start_pos_x + move_x;
+        m_pos_y = start_pos_y + move_y;
+        Update_Position_Rect();
+
+        move_x = 0.0f;
+        move_y = 0.0f;
+        return;
+    }
+
+    const float time = blocked->m_time_entry;
+
+    m_pos_x = start_pos_x + move_x * time;
+    m_pos_y = start_pos_y + move_y * time;
+
+    // already touching at the start blocks both axes
+    if (time <= 0.0f) {
+        move_x = 0.0f;
+        move_y = 0.0f;
+    }
+    // stop the blocked axis and keep the rest of the other one
+    else if (blocked->m_entry_x) {
+        m_pos_x -= Get_Swept_Block_Gap(move_x * time);
+        move_x = 0.0f;
+        move_y *= 1.0f - time;
+    }
+    else {
+        m_pos_y -= Get_Swept_Block_Gap(move_y * time);
+        move_x *= 1.0f - time;
+        move_y = 0.0f;
+    }
+
+    Update_Position_Rect();
+}
+
+bool cMovingSprite::Is_Collision_Object(const cSprite* obj) const
+{
+    // if the same object or destroyed object
+    if (this == obj || obj->m_auto_destroy) {
+        return 0;
+    }
+
+    // if undefined, hud or animation
+    if (obj->m_sprite_array == ARRAY_UNDEFINED || obj->m_sprite_array == ARRAY_HUD || obj->m_sprite_array == ARRAY_ANIM) {
+        return 0;
+    }
+
+    // if enemy is dead
+    if (obj->m_sprite_array == ARRAY_ENEMY && static_cast<const cEnemy*>(obj)->m_dead) {
+        return 0;
+    }
+
+    return 1;
 }
 
 void cMovingSprite::Col_Move(float move_x, float move_y, bool real /* = 0 */, bool force /* = 0 */, bool check_on_ground /* = 1 */)
@@ -442,59 +668,71 @@ void cMovingSprite::Col_Move(float move_x, float move_y, bool real /* = 0 */, bo
             complete_rect.m_h -= move_y;
         }
 
-        cSprite_List sprite_list;
-        m_sprite_manager->Get_Colliding_Objects(sprite_list, complete_rect, 1, this);
-
-        // step size
-        float step_size_x = move_x;
-        float step_size_y = move_y;
+        cSprite_List_Buffer sprite_list;
+        m_sprite_manager->Get_Colliding_Objects(*sprite_list, complete_rect, 1, this);
 
-        // check if object collision rect is smaller as the position check size
-        if (step_size_x > m_col_rect.m_w) {
-            step_size_x = m_col_rect.m_w;
-        }
-        else if (step_size_x < -m_col_rect.m_w) {
-            step_size_x = -m_col_rect.m_w;
-        }
+        // find all contacts in one pass
+        if (m_col_move_type == COL_MOVE_SWEPT) {
+            cObjectCollisionType_Buffer col_list;
+            Col_Move_Swept(*col_list, move_x, move_y, *sprite_list);
 
-        if (step_size_y > m_col_rect.m_h) {
-            step_size_y = m_col_rect.m_h;
-        }
-        else if (step_size_y < -m_col_rect.m_h) {
-            step_size_y = -m_col_rect.m_h;
+            Add_Collisions(col_list, 1);
         }
+        // move in steps
+        else {
+            // step size
+            float step_size_x = move_x;
+            float step_size_y = move_y;
 
-        float final_pos_x = m_pos_x + move_x;
-        float final_pos_y = m_pos_y + move_y;
-
-        // move in big steps
-        cObjectCollisionType* col_list = Col_Move_in_Steps(move_x, move_y, step_size_x, step_size_y, final_pos_x, final_pos_y, sprite_list, 1);
-
-        // if a collision is found enter pixel checking
-        if (col_list && col_list->size()) {
-            // change to pixel checking
-            if (step_size_x < -1.0f) {
-                step_size_x = -1.0f;
+            // check if object collision rect is smaller as the position check size
+            if (step_size_x > m_col_rect.m_w) {
+                step_size_x = m_col_rect.m_w;
             }
-            else if (step_size_x > 1.0f) {
-                step_size_x = 1.0f;
+            else if (step_size_x < -m_col_rect.m_w) {
+                step_size_x = -m_col_rect.m_w;
             }
 
-            if (step_size_y < -1.0f) {
-                step_size_y = -1.0f;
+            if (step_size_y > m_col_rect.m_h) {
+                step_size_y = m_col_rect.m_h;
             }
-            else if (step_size_y > 1.0f) {
-                step_size_y = 1.0f;
+            else if (step_size_y < -m_col_rect.m_h) {
+                step_size_y = -m_col_rect.m_h;
             }
 
-            delete col_list;
-            col_list = Col_Move_in_Steps(move_x, move_y, step_size_x, step_size_y, final_pos_x, final_pos_y, sprite_list);
+            float final_pos_x = m_pos_x + move_x;
+            float final_pos_y = m_pos_y + move_y;
 
-            Add_Collisions(col_list, 1);
-        }
+            // move in big steps
+            cObjectCollisionType_Buffer col_list;
+            // Col_Move_in_Steps() removes objects from it
+            cSprite_List_Buffer steps_sprite_list;
+            steps_sprite_list->assign(sprite_list->begin(), sprite_list->end());
+
+            Col_Move_in_Steps(*col_list, move_x, move_y, step_size_x, step_size_y, final_pos_x, final_pos_y, *steps_sprite_list, 1);
+
+            // if a collision is found enter pixel checking
+            if (col_list->size()) {
+                // change to pixel checking
+                if (step_size_x < -1.0f) {
+                    step_size_x = -1.0f;
+                }
+                else if (step_size_x > 1.0f) {
+                    step_size_x = 1.0f;
+                }
+
+                if (step_size_y < -1.0f) {
+                    step_size_y = -1.0f;
+                }
+                else if (step_size_y > 1.0f) {
+                    step_size_y = 1.0f;
+                }
+
+                col_list->Delete_All();
+                steps_sprite_list->assign(sprite_list->begin(), sprite_list->end());
+                Col_Move_in_Steps(*col_list, move_x, move_y, step_size_x, step_size_y, final_pos_x, final_pos_y, *steps_sprite_list);
 
-        if (col_list) {
-            delete col_list;
+                Add_Collisions(col_list, 1);
+            }
         }
     }
     // don't check for collisions
@@ -642,6 +880,13 @@ void cMovingSprite::Draw(cSurface_Request* request /* = NULL */)
 }
 
 cObjectCollisionType* cMovingSprite::Collision_Check_Absolute(const float x, const float y, const float w /* = 0 */, const float h /* = 0 */, const ColCheckType check_type /* = COLLIDE_COMPLETE */, cSprite_List* objects /* = NULL */)
+{
+    cObjectCollisionType* col_list = new cObjectCollisionType();
+    Collision_Check_Absolute(*col_list, x, y, w, h, check_type, objects);
+    return col_list;
+}
+
+void cMovingSprite::Collision_Check_Absolute(cObjectCollisionType& col_list, const float x, const float y, const float w /* = 0 */, const float h /* = 0 */, const ColCheckType check_type /* = COLLIDE_COMPLETE */, cSprite_List* objects /* = NULL */)
 {
     // save original rect
     GL_rect new_rect;
@@ -694,23 +939,33 @@ cObjectCollisionType* cMovingSprite::Collision_Check_Absolute(const float x, con
         pRenderer->Add(request);
     }
 
-    // return collisions list
-    return Collision_Check(&new_rect, check_type, objects);
+    // add collisions
+    Collision_Check(col_list, new_rect, check_type, objects);
 }
 
 cObjectCollisionType* cMovingSprite::Collision_Check(const GL_rect& new_rect, const ColCheckType check_type /* = COLLIDE_COMPLETE */, cSprite_List* objects /* = NULL */)
 {
     // blocking collisions list
     cObjectCollisionType* col_list = new cObjectCollisionType();
+    Collision_Check(*col_list, new_rect, check_type, objects);
+    return col_list;
+}
 
+void cMovingSprite::Collision_Check(cObjectCollisionType& col_list, const GL_rect& new_rect, const ColCheckType check_type /* = COLLIDE_COMPLETE */, cSprite_List* objects /* = NULL */)
+{
     // no width or height is invalid
     if (Is_Float_Equal(new_rect.m_w, 0.0f) || Is_Float_Equal(new_rect.m_h, 0.0f)) {
-        return col_list;
+        return;
     }
 
+    // objects near the rect if no object list is given
+    cSprite_List_Buffer near_objects;
+
     // if no object list is given get all objects available
     if (!objects) {
-        objects = &m_sprite_manager->objects;
+        // only the objects in the overlapping spatial hash cells
+        m_sprite_manager->Get_Colliding_Objects(*near_objects, new_rect, 0, this);
+        objects = near_objects;
 
         // Player
         if (m_type != TYPE_PLAYER && new_rect.Intersects(pActive_Player->m_col_rect)) {
@@ -733,7 +988,7 @@ cObjectCollisionType* cMovingSprite::Collision_Check(const GL_rect& new_rect, co
             // valid collision
             if (col_valid != COL_VTYPE_NOT_VALID) {
                 // add to list
-                col_list->Add(Create_Collision_Object(this, pActive_Player, col_valid));
+                col_list.Add(Create_Collision_Object(this, pActive_Player, col_valid));
             }
         }
     }
@@ -743,23 +998,13 @@ cObjectCollisionType* cMovingSprite::Collision_Check(const GL_rect& new_rect, co
         // get object pointer
         cSprite* level_object = (*itr);
 
-        // if the same object or destroyed object
-        if (this == level_object || level_object->m_auto_destroy) {
-            continue;
-        }
-
         // if rects don't touch
         if (!new_rect.Intersects(level_object->m_col_rect)) {
             continue;
         }
 
-        // if undefined, hud or animation
-        if (level_object->m_sprite_array == ARRAY_UNDEFINED || level_object->m_sprite_array == ARRAY_HUD || level_object->m_sprite_array == ARRAY_ANIM) {
-            continue;
-        }
-
-        // if enemy is dead
-        if (level_object->m_sprite_array == ARRAY_ENEMY && static_cast<cEnemy*>(level_object)->m_dead) {
+        // if the same, destroyed or not collidable object
+        if (!Is_Collision_Object(level_object)) {
             continue;
         }
 
@@ -784,11 +1029,38 @@ cObjectCollisionType* cMovingSprite::Collision_Check(const GL_rect& new_rect, co
             }
         }
 
+        // every touched tile of a collision proxy
+        if (level_object->m_type == TYPE_COLLISION_PROXY) {
+            Add_Proxy_Collisions(col_list, new_rect, static_cast<cCollision_Proxy*>(level_object), col_valid);
+            continue;
+        }
+
         // add to list
-        col_list->Add(Create_Collision_Object(this, level_object, col_valid));
+        col_list.Add(Create_Collision_Object(this, level_object, col_valid));
     }
+}
 
-    return col_list;
+void cMovingSprite::Add_Proxy_Collisions(cObjectCollisionType& col_list, const GL_rect& rect, cCollision_Proxy* proxy, Col_Valid_Type col_valid)
+{
+    const size_t count = col_list.size();
+
+    for (cSprite_List::iterator itr = proxy->m_tiles.begin(); itr != proxy->m_tiles.end(); ++itr) {
+        cSprite* tile = (*itr);
+
+        if (!rect.Intersects(tile->m_col_rect)) {
+            continue;
+        }
+
+        cObjectCollision* collision = Create_Collision_Object(this, tile, col_valid);
+        // removed from further checks as the proxy
+        collision->m_check_obj = proxy;
+        col_list.Add(collision);
+    }
+
+    // only touched between the tiles
+    if (col_list.size() == count) {
+        col_list.Add(Create_Collision_Object(this, proxy, col_valid));
+    }
 }
 
 void cMovingSprite::Check_And_Handle_Out_Of_Level(const float move_x, const float move_y)
@@ -866,6 +1138,17 @@ bool cMovingSprite::Set_On_Ground(cSprite* obj, bool set_on_top /* = 1 */)
     return 1;
 }
 
+bool cMovingSprite::Is_On_Ground_Object(void) const
+{
+    if (!m_ground_object) {
+        return 0;
+    }
+
+    GL_rect rect2(m_col_rect.m_x, m_col_rect.m_y + m_col_rect.m_h, m_col_rect.m_w, 1.0f);
+
+    return m_ground_object->m_col_rect.Intersects(rect2) && m_ground_object->m_can_be_ground;
+}
+
 void cMovingSprite::Check_on_Ground(void)
 {
     // can't be on ground
@@ -877,14 +1160,9 @@ void cMovingSprite::Check_on_Ground(void)
         return;
     }
 
-    // if ground object
-    if (m_ground_object) {
-        GL_rect rect2(m_col_rect.m_x, m_col_rect.m_y + m_col_rect.m_h, m_col_rect.m_w, 1.0f);
-
-        // if on ground object
-        if (m_ground_object->m_col_rect.Intersects(rect2) && m_ground_object->m_can_be_ground) {
-            return;
-        }
+    // still on the ground object
+    if (Is_On_Ground_Object()) {
+        return;
     }
 
     // don't check if flying or linked
@@ -893,7 +1171,8 @@ void cMovingSprite::Check_on_Ground(void)
     }
 
     // new onground check
-    cObjectCollisionType* col_list = Collision_Check_Relative(0.0f, m_col_rect.m_h, 0.0f, 1.0f, COLLIDE_ONLY_BLOCKING);
+    cObjectCollisionType_Buffer col_list;
+    Collision_Check_Relative(*col_list, 0.0f, m_col_rect.m_h, 0.0f, 1.0f, COLLIDE_ONLY_BLOCKING);
 
     Reset_On_Ground();
 
@@ -910,14 +1189,13 @@ void cMovingSprite::Check_on_Ground(void)
             }
         }
     }
-
-    delete col_list;
 }
 
 void cMovingSprite::Update_Anti_Stuck(void)
 {
     // collision count
-    cObjectCollisionType* col_list = Collision_Check(&m_col_rect, COLLIDE_ONLY_BLOCKING);
+    cObjectCollisionType_Buffer col_list;
+    Collision_Check(*col_list, m_col_rect, COLLIDE_ONLY_BLOCKING);
 
     // check collisions
     for (cObjectCollision_List::iterator itr = col_list->objects.begin(); itr != col_list->objects.end(); ++itr) {
@@ -943,8 +1221,6 @@ void cMovingSprite::Update_Anti_Stuck(void)
             Col_Move(0.0f, -1.0f, 0, 1);
         }
     }
-
-    delete col_list;
 }
 
 void cMovingSprite::Collide_Move(void)
@@ -1262,6 +1538,7 @@ void cMovingSprite::Send_Collision(const cObjectCollision* collision, bool handl
 
     // set object
     new_collision->m_obj = this;
+    new_collision->m_check_obj = this;
     // set object manager id
     new_collision->m_number = my_number;
 
@@ -1273,6 +1550,9 @@ void cMovingSprite::Send_Collision(const cObjectCollision* collision, bool handl
     // set type
     new_collision->m_array = m_sprite_array;
 
+    // a dormant target needs to handle it
+    target_obj->Wake_Up();
+
     // handle now
     if (handle_now) {
         target_obj->Handle_Collision(new_collision);
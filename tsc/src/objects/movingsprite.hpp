@@ -54,6 +54,15 @@ namespace TSC {
         COLLIDE_COMPLETE = 3
     };
 
+    /* *** *** *** *** *** *** *** collision move type *** *** *** *** *** *** *** *** *** *** */
+
+    enum ColMoveType {
+        // Move in steps with a collision check for each step
+        COL_MOVE_STEPS = 0,
+        // Sweep the collision rect and find all contacts in one pass over the objects
+        COL_MOVE_SWEPT = 1
+    };
+
     /* *** *** *** *** *** *** *** cMovingSprite *** *** *** *** *** *** *** *** *** *** */
 
     class cMovingSprite : public cSprite {
@@ -212,6 +221,16 @@ namespace TSC {
         */
         cObjectCollisionType* Collision_Check(const GL_rect& new_rect, const ColCheckType check_type = COLLIDE_COMPLETE, cSprite_List* objects = NULL);
 
+        /* Add the collisions found by the checks above to the given list
+         * use these with a cObjectCollisionType_Buffer to avoid allocating a list for each check
+        */
+        void Collision_Check_Relative(cObjectCollisionType& col_list, const float x, const float y, const float w = 0.0f, const float h = 0.0f, const ColCheckType check_type = COLLIDE_COMPLETE, cSprite_List* objects = NULL)
+        {
+            Collision_Check_Absolute(col_list, m_col_rect.m_x + x, m_col_rect.m_y + y, w, h, check_type, objects);
+        }
+        void Collision_Check_Absolute(cObjectCollisionType& col_list, const float x, const float y, const float w = 0.0f, const float h = 0.0f, const ColCheckType check_type = COLLIDE_COMPLETE, cSprite_List* objects = NULL);
+        void Collision_Check(cObjectCollisionType& col_list, const GL_rect& new_rect, const ColCheckType check_type = COLLIDE_COMPLETE, cSprite_List* objects = NULL);
+
         // Check if the given movement goes out of the level rect and handle possible out of level events
         void Check_And_Handle_Out_Of_Level(const float move_x, const float move_y);
         // Check if the given movement goes out of the level rect
@@ -221,6 +240,8 @@ namespace TSC {
         bool Is_Out_Of_Level_Bottom(const float move_x) const;
         // Set the ground object
         virtual bool Set_On_Ground(cSprite* obj, bool set_on_top = 1);
+        // Return true if still standing on the ground object
+        bool Is_On_Ground_Object(void) const;
         // Check if the Object is onground and sets the state to onground
         virtual void Check_on_Ground(void);
         // object looses onground state
@@ -234,6 +255,12 @@ namespace TSC {
         // default collision and movement handling
         virtual void Collide_Move(void);
 
+        // moving sprites are never baked
+        virtual bool Is_Static_Collision(void) const
+        {
+            return 0;
+        }
+
         /* Freeze for the given time
         */
         void Freeze(float freeze_time = speedfactor_fps * 10);
@@ -297,6 +324,9 @@ namespace TSC {
          */
         Moving_state m_state;
 
+        // how Col_Move() detects collisions
+        ColMoveType m_col_move_type;
+
         // ice resistance
         float m_ice_resistance;
         // time counter if frozen
@@ -304,11 +334,27 @@ namespace TSC {
 
     private:
         /* moves in steps and checks in both directions simultaneous
-         * returns the found collisions
-         * sprite_list : objects to check
+         * adds the found collisions to col_list
+         * sprite_list : objects to check, objects with internal collisions are removed from it
          * stop_on_internal : if set stops moving if internal collision was found
         */
-        cObjectCollisionType* Col_Move_in_Steps(float move_x, float move_y, float step_size_x, float step_size_y, float final_pos_x, float final_pos_y, cSprite_List sprite_list, bool stop_on_internal = 0);
+        void Col_Move_in_Steps(cObjectCollisionType& col_list, float move_x, float move_y, float step_size_x, float step_size_y, float final_pos_x, float final_pos_y, cSprite_List& sprite_list, bool stop_on_internal = 0);
+        /* moves until the earliest blocking collision on either axis and slides along the other axis
+         * adds the found collisions to col_list like the pixel checking of Col_Move_in_Steps()
+         * the collisions are validated at the position where the sprite touches them
+         * sprite_list : objects to check, objects with internal collisions are removed from it
+        */
+        void Col_Move_Swept(cObjectCollisionType& col_list, float move_x, float move_y, cSprite_List& sprite_list);
+        /* moves up to the first blocking collision for Col_Move_Swept()
+         * move_x and move_y are set to the movement left after it
+        */
+        void Col_Move_Swept_Pass(cObjectCollisionType& col_list, float& move_x, float& move_y, cSprite_List& sprite_list);
+        // returns true if the given object can be checked for collisions with this sprite
+        bool Is_Collision_Object(const cSprite* obj) const;
+        /* adds a collision with every merged tile of the proxy touching the rect
+         * the same collisions are found as if the tiles were not merged
+        */
+        void Add_Proxy_Collisions(cObjectCollisionType& col_list, const GL_rect& rect, cCollision_Proxy* proxy, Col_Valid_Type col_valid);
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -20,6 +20,7 @@
 #include "../gui/hud.hpp"
 #include "../core/framerate.hpp"
 #include "../video/animation.hpp"
+#include "../video/particle_presets.hpp"
 #include "../video/gl_surface.hpp"
 #include "../user/savegame/savegame.hpp"
 #include "../core/math/utilities.hpp"
@@ -574,17 +575,14 @@ void cMoon::Activate(void)
     pHud_Points->Add_Points(4000, m_pos_x + (m_image ? m_image->m_w / 2 : 0), m_pos_y);
 
     // Particle burst on collection
-    cParticle_Emitter* anim = new cParticle_Emitter(m_sprite_manager);
-    anim->Set_Image(pVideo->Get_Surface("animation/particles/dirt.png"));
-    anim->Set_Emitter_Rect(m_pos_x, m_pos_y, m_rect.m_w, m_rect.m_h);
-    anim->Set_Quota(20);
-    anim->Set_Pos_Z(m_pos_z - 0.0001f);
-    anim->Set_Speed(0.6f, 0.6f);
-    anim->Set_Scale(1.0f);
-    anim->Set_Time_to_Live(5.0f);
-    anim->Set_Const_Rotation_Z(7.0f, 1.0f);
-    anim->Emit();
-    pActive_Animation_Manager->Add(anim);
+    cParticle_Emitter* anim = pParticle_Preset_Manager->Create("moon_collect", m_sprite_manager);
+
+    if (anim) {
+        anim->Set_Emitter_Rect(m_pos_x, m_pos_y, m_rect.m_w, m_rect.m_h);
+        anim->Set_Pos_Z(m_pos_z - 0.0001f);
+        anim->Emit();
+        pActive_Animation_Manager->Add(anim);
+    }
 
     // if spawned destroy
     if (m_spawned) {
@@ -606,17 +604,15 @@ void cMoon::Update(void)
 
     // particles
     if (m_particle_counter >= 1.0f) {
-        cParticle_Emitter* anim = new cParticle_Emitter(m_sprite_manager);
-        anim->Set_Image(pVideo->Get_Package_Surface("animation/particles/dirt.png"));
-        anim->Set_Emitter_Rect(m_pos_x, m_pos_y, m_rect.m_w, m_rect.m_h);
-        anim->Set_Quota(static_cast<int>(m_particle_counter));
-        anim->Set_Pos_Z(m_pos_z - 0.0001f);
-        anim->Set_Speed(0.2f, 0.2f);
-        anim->Set_Scale(1.0f);
-        anim->Set_Time_to_Live(2.5f);
-        anim->Set_Const_Rotation_Z(5.0f, 1.0f);
-        anim->Emit();
-        pActive_Animation_Manager->Add(anim);
+        cParticle_Emitter* anim = pParticle_Preset_Manager->Create("moon_glow", m_sprite_manager);
+
+        if (anim) {
+            anim->Set_Emitter_Rect(m_pos_x, m_pos_y, m_rect.m_w, m_rect.m_h);
+            anim->Set_Quota(static_cast<int>(m_particle_counter));
+            anim->Set_Pos_Z(m_pos_z - 0.0001f);
+            anim->Emit();
+            pActive_Animation_Manager->Add(anim);
+        }
 
         m_particle_counter -= static_cast<int>(m_particle_counter);
     }
@@ -165,7 +165,8 @@ void cSpinBox::Update(void)
                 // set to massive for collision check
                 m_massive_type = MASS_MASSIVE;
                 // collision data
-                cObjectCollisionType* col_list = Collision_Check(&m_col_rect, COLLIDE_ONLY_BLOCKING);
+                cObjectCollisionType_Buffer col_list;
+                Collision_Check(*col_list, m_col_rect, COLLIDE_ONLY_BLOCKING);
 
                 // check if spinning should continue
                 bool spin_again = 0;
@@ -187,8 +188,6 @@ void cSpinBox::Update(void)
                     }
                 }
 
-                delete col_list;
-
                 // continue spinning
                 if (spin_again) {
                     // spin some time again
@@ -214,6 +213,15 @@ bool cSpinBox::Is_Update_Valid(void)
     return cBaseBox::Is_Update_Valid();
 }
 
+bool cSpinBox::Can_Be_Dormant(void) const
+{
+    if (m_spin) {
+        return 0;
+    }
+
+    return cBaseBox::Can_Be_Dormant();
+}
+
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
 } // namespace TSC
@@ -63,6 +63,8 @@ namespace TSC {
 
         // if update is valid for the current state
         virtual bool Is_Update_Valid(void);
+        // the spin time has to run out
+        virtual bool Can_Be_Dormant(void) const;
 
         // spin counter
         float m_spin_counter;
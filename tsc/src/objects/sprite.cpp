@@ -24,6 +24,7 @@
 #include "../video/gl_surface.hpp"
 #include "../video/renderer.hpp"
 #include "../core/sprite_manager.hpp"
+#include "../core/update_jobs.hpp"
 #include "../core/editor/editor.hpp"
 #include "../core/i18n.hpp"
 #include "../scripting/events/touch_event.hpp"
@@ -90,16 +91,23 @@ cObjectCollision* cCollidingSprite::Create_Collision_Object(const cSprite* base,
 
     // if col object is available
     if (col) {
+        // direction
+        collision->Set_Direction(base, col);
+        collision->m_check_obj = col;
+
+        // report a merged tile instead of the collision proxy
+        if (col->m_type == TYPE_COLLISION_PROXY) {
+            col = static_cast<cCollision_Proxy*>(col)->Get_Tile(base->m_col_rect);
+        }
+
         // object
         collision->m_obj = col;
         // identifier
         if (col->m_sprite_array != ARRAY_PLAYER) {
-            collision->m_number = m_sprite_manager->Get_Array_Num(col);
+            collision->m_number = col->m_slot;
         }
         // type
         collision->m_array = col->m_sprite_array;
-        // direction
-        collision->Set_Direction(base, col);
     }
 
     // valid type
@@ -425,6 +433,9 @@ void cSprite::Init(void)
 
     m_valid_draw = 1;
     m_valid_update = 1;
+    m_dormant = 0;
+    m_wake_counter = 0.0f;
+    m_slot = -1;
 
     m_editor_window_name_width = 0.0f;
 
@@ -675,6 +686,8 @@ void cSprite::Set_Ignore_Camera(bool enable /* = 0 */)
 
     m_no_camera = enable;
 
+    // the draw rect changed
+    Update_Spatial_Index();
     Update_Valid_Draw();
 }
 
@@ -724,6 +737,7 @@ void cSprite::Set_Active(bool enabled)
 
     Update_Valid_Draw();
     Update_Valid_Update();
+    Update_Static_Geometry();
 }
 
 /** Set a Color Combination ( GL_ADD, GL_MODULATE or GL_REPLACE ).
@@ -743,6 +757,8 @@ void cSprite::Set_Color_Combine(const float red, const float green, const float
     m_combine_color[0] = Clamp(red, 0.000001f, 1.0f);
     m_combine_color[1] = Clamp(green, 0.000001f, 1.0f);
     m_combine_color[2] = Clamp(blue, 0.000001f, 1.0f);
+
+    Update_Static_Geometry();
 }
 
 void cSprite::Update_Rect_Rotation_Z(void)
@@ -796,6 +812,10 @@ void cSprite::Set_Rotation_X(float rot, bool new_start_rot /* = 0 */)
 
     if (m_rotation_affects_rect) {
         Update_Rect_Rotation_X();
+        Update_Spatial_Index();
+    }
+    else {
+        Update_Static_Geometry();
     }
 }
 
@@ -809,6 +829,10 @@ void cSprite::Set_Rotation_Y(float rot, bool new_start_rot /* = 0 */)
 
     if (m_rotation_affects_rect) {
         Update_Rect_Rotation_Y();
+        Update_Spatial_Index();
+    }
+    else {
+        Update_Static_Geometry();
     }
 }
 
@@ -822,6 +846,10 @@ void cSprite::Set_Rotation_Z(float rot, bool new_start_rot /* = 0 */)
 
     if (m_rotation_affects_rect) {
         Update_Rect_Rotation_Z();
+        Update_Spatial_Index();
+    }
+    else {
+        Update_Static_Geometry();
     }
 }
 void cSprite::Set_Scale_X(const float scale, const bool new_startscale /* = 0 */)
@@ -845,6 +873,13 @@ void cSprite::Set_Scale_X(const float scale, const bool new_startscale /* = 0 */
         m_rect.m_w *= m_scale_x;
     }
 
+    if (m_scale_affects_rect) {
+        Update_Spatial_Index();
+    }
+    else {
+        Update_Static_Geometry();
+    }
+
     if (new_startscale) {
         m_start_scale_x = m_scale_x;
     }
@@ -871,6 +906,13 @@ void cSprite::Set_Scale_Y(const float scale, const bool new_startscale /* = 0 */
         m_rect.m_h *= m_scale_y;
     }
 
+    if (m_scale_affects_rect) {
+        Update_Spatial_Index();
+    }
+    else {
+        Update_Static_Geometry();
+    }
+
     if (new_startscale) {
         m_start_scale_y = m_scale_y;
     }
@@ -929,9 +971,36 @@ void cSprite::Update_Position_Rect(void)
         m_col_rect.m_y = m_pos_y + m_col_pos.m_y;
     }
 
+    Update_Spatial_Index();
     Update_Valid_Draw();
 }
 
+void cSprite::Update_Spatial_Index(void) const
+{
+    if (m_sprite_manager) {
+        // the spatial hash is shared
+        if (cUpdate_Jobs::Is_Recording()) {
+            cUpdate_Jobs::Defer(std::bind(&cSprite::Update_Spatial_Index, this));
+            return;
+        }
+
+        m_sprite_manager->Update_Spatial(this);
+    }
+}
+
+void cSprite::Update_Static_Geometry(void) const
+{
+    if (m_sprite_manager) {
+        // the chunks are shared
+        if (cUpdate_Jobs::Is_Recording()) {
+            cUpdate_Jobs::Defer(std::bind(&cSprite::Update_Static_Geometry, this));
+            return;
+        }
+
+        m_sprite_manager->Update_Static_Geometry(this);
+    }
+}
+
 void cSprite::Update_Valid_Draw(void)
 {
     m_valid_draw = Is_Draw_Valid();
@@ -1051,6 +1120,10 @@ void cSprite::Draw_Image_Normal(cSurface_Request* request /* = NULL */) const
 {
     // texture id
     request->m_texture_id = m_image->m_image;
+    request->m_tex_x1 = m_image->m_tex_x1;
+    request->m_tex_y1 = m_image->m_tex_y1;
+    request->m_tex_x2 = m_image->m_tex_x2;
+    request->m_tex_y2 = m_image->m_tex_y2;
 
     // size
     request->m_w = m_image->m_start_w;
@@ -1143,6 +1216,10 @@ void cSprite::Draw_Image_Editor(cSurface_Request* request /* = NULL */) const
 {
     // texture id
     request->m_texture_id = m_start_image->m_image;
+    request->m_tex_x1 = m_start_image->m_tex_x1;
+    request->m_tex_y1 = m_start_image->m_tex_y1;
+    request->m_tex_x2 = m_start_image->m_tex_x2;
+    request->m_tex_y2 = m_start_image->m_tex_y2;
 
     // size
     request->m_w = m_start_image->m_start_w;
@@ -1275,6 +1352,23 @@ void cSprite::Set_Massive_Type(MassiveType type)
 
     // make it the latest sprite
     m_sprite_manager->Move_To_Back(this);
+    // the z position changed
+    Update_Static_Geometry();
+}
+
+bool cSprite::Is_Static_Collision(void) const
+{
+    // spawned objects are not part of the level
+    if (m_spawned || m_auto_destroy) {
+        return 0;
+    }
+
+    // level tiles
+    if (m_sprite_array == ARRAY_MASSIVE || m_sprite_array == ARRAY_PASSIVE || m_sprite_array == ARRAY_ACTIVE) {
+        return 1;
+    }
+
+    return 0;
 }
 
 bool cSprite::Is_On_Top(const cSprite* obj) const
@@ -1324,6 +1418,17 @@ bool cSprite::Is_Visible_On_Screen(void) const
     return 1;
 }
 
+bool cSprite::Get_Draw_Rect(GL_rect& rect) const
+{
+    // always on the screen
+    if (m_no_camera) {
+        return 0;
+    }
+
+    rect = m_rect;
+    return 1;
+}
+
 bool cSprite::Is_In_Range(void) const
 {
     // no camera range set
@@ -1343,6 +1448,37 @@ bool cSprite::Is_In_Range(void) const
     return 1;
 }
 
+bool cSprite::Can_Be_Dormant(void) const
+{
+    return 1;
+}
+
+bool cSprite::Can_Update_Parallel(void) const
+{
+    // derived types have to allow it themselves
+    if (typeid(*this) != typeid(cSprite)) {
+        return 0;
+    }
+
+    // a plain sprite only updates its animation
+    return !m_anim_enabled;
+}
+
+void cSprite::Wake_Up(void)
+{
+    // the active objects list is shared
+    if (cUpdate_Jobs::Is_Recording()) {
+        cUpdate_Jobs::Defer(std::bind(&cSprite::Wake_Up, this));
+        return;
+    }
+
+    m_wake_counter = speedfactor_fps;
+
+    if (m_dormant) {
+        m_sprite_manager->Wake(this);
+    }
+}
+
 bool cSprite::Is_Update_Valid()
 {
     // if destroyed
@@ -1402,6 +1538,17 @@ void cSprite::Destroy(void)
     m_valid_draw = 0;
     m_valid_update = 0;
     Set_Image(NULL, 1);
+
+    // the array slot can be reused
+    if (m_sprite_manager) {
+        // the free slot list is shared
+        if (cUpdate_Jobs::Is_Recording()) {
+            cUpdate_Jobs::Defer(std::bind(&cSprite_Manager::Free_Slot, m_sprite_manager, this));
+        }
+        else {
+            m_sprite_manager->Free_Slot(this);
+        }
+    }
 }
 
 void cSprite::Editor_Add(const CEGUI::String& name, const CEGUI::String& tooltip, CEGUI::Window* window_setting, float obj_width, float obj_height /* = 28 */, bool advance_row /* = 1 */)
@@ -356,6 +356,10 @@ namespace TSC {
 
         // Update the position rect values
         void Update_Position_Rect(void);
+        // Update the collision rect in the spatial hash of the sprite manager
+        void Update_Spatial_Index(void) const;
+        // Update the static geometry chunk of the sprite manager if the drawing changed without the rect
+        void Update_Static_Geometry(void) const;
         // default update, derived updates should not call this again if they also call Update_Animation()
         virtual void Update(void) { Update_Animation(); };
         /* late update
@@ -389,13 +393,35 @@ namespace TSC {
         /// Set the massive type.
         virtual void Set_Massive_Type(MassiveType type);
 
+        /** Return true if this sprite never moves after loading the level
+         * and can be baked into the static collision tree of the sprite manager.
+        */
+        virtual bool Is_Static_Collision(void) const;
+
         // Check if this sprite is on top of the given object
         bool Is_On_Top(const cSprite* obj) const;
 
         // if the sprite is visible on the screen
         bool Is_Visible_On_Screen(void) const;
+        /* Set the rect this is drawn in and return true
+         * the sprite manager only draws the objects with a draw rect on the screen
+         * returns false if this can also draw when not on the screen
+        */
+        virtual bool Get_Draw_Rect(GL_rect& rect) const;
         // if this is in range of the maximum camera distance
         bool Is_In_Range(void) const;
+        /* if this can stop updating while outside the camera activity region
+         * objects which have to keep running when far away (paths, timers) return false
+        */
+        virtual bool Can_Be_Dormant(void) const;
+        /* Make this active again if dormant
+         * it then stays active for a while even if outside the camera activity region
+        */
+        void Wake_Up(void);
+        /* if Update() only changes this sprite and defers everything else
+         * it is then allowed to run on a worker thread, see cUpdate_Jobs
+        */
+        virtual bool Can_Update_Parallel(void) const;
         // if update is valid for the current state
         virtual bool Is_Update_Valid();
         // if draw is valid for the current state and position
@@ -557,6 +583,12 @@ namespace TSC {
         bool m_valid_draw;
         /// if updating is valid
         bool m_valid_update;
+        /// if outside the camera activity region and not updated by the sprite manager
+        bool m_dormant;
+        /// time left until this can become dormant again
+        float m_wake_counter;
+        /// array position in the sprite manager or -1 if not added
+        int m_slot;
 
         /// editor active window list
         typedef vector<cEditor_Object_Settings_Item*> Editor_Object_Settings_List;
@@ -80,6 +80,12 @@ xmlpp::Element* cLayer_Line_Point::Save_To_XML_Node(xmlpp::Element* p_element)
     return NULL;
 }
 
+bool cLayer_Line_Point::Get_Draw_Rect(GL_rect& rect) const
+{
+    rect = m_col_rect;
+    return 1;
+}
+
 void cLayer_Line_Point::Draw(cSurface_Request* request /* = NULL */)
 {
     if (m_auto_destroy || !pOverworld_Manager->m_draw_layer) {
@@ -213,6 +219,11 @@ void cLayer_Line_Point_Start::Draw(cSurface_Request* request /* = NULL */)
     cLayer_Line_Point::Draw(request);
 }
 
+bool cLayer_Line_Point_Start::Get_Draw_Rect(GL_rect& rect) const
+{
+    return 0;
+}
+
 GL_line cLayer_Line_Point_Start::Get_Line(void) const
 {
     return GL_line(m_pos_x + (m_col_rect.m_w * 0.5f), m_pos_y + (m_col_rect.m_h * 0.5f), m_linked_point->m_pos_x + (m_linked_point->m_col_rect.m_w * 0.5f), m_linked_point->m_pos_y + (m_linked_point->m_col_rect.m_h * 0.5f));
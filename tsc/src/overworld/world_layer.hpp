@@ -39,6 +39,8 @@ namespace TSC {
 
         // draw
         virtual void Draw(cSurface_Request* request = NULL);
+        // the point is drawn with the collision rect
+        virtual bool Get_Draw_Rect(GL_rect& rect) const;
 
         /* set this sprite to destroyed and completely disable it
          * sprite is still in the sprite manager but only to get possibly replaced
@@ -77,6 +79,8 @@ namespace TSC {
 
         // Draw
         virtual void Draw(cSurface_Request* request = NULL);
+        // the line to the linked point can cross the screen
+        virtual bool Get_Draw_Rect(GL_rect& rect) const;
 
         // return a normal line
         GL_line Get_Line(void) const;
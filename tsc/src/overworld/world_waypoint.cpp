@@ -171,6 +171,29 @@ void cWaypoint::Update(void)
     }
 }
 
+bool cWaypoint::Get_Draw_Rect(GL_rect& rect) const
+{
+    if (!cSprite::Get_Draw_Rect(rect)) {
+        return 0;
+    }
+
+    float arrow_size = 0.0f;
+
+    if (m_arrow_forward) {
+        arrow_size = max(m_arrow_forward->m_w, m_arrow_forward->m_h);
+    }
+    if (m_arrow_backward) {
+        arrow_size = max(arrow_size, max(m_arrow_backward->m_w, m_arrow_backward->m_h));
+    }
+
+    rect.m_x -= arrow_size;
+    rect.m_y -= arrow_size;
+    rect.m_w += arrow_size * 2.0f;
+    rect.m_h += arrow_size * 2.0f;
+
+    return 1;
+}
+
 void cWaypoint::Draw(cSurface_Request* request /* = NULL  */)
 {
     if (m_auto_destroy) {
@@ -298,6 +321,9 @@ void cWaypoint::Set_Direction_Forward(ObjectDirection direction)
     else if (direction == DIR_DOWN) {
         m_arrow_forward = pVideo->Get_Package_Surface("game/arrow/small/white/down.png");
     }
+
+    // the draw rect changed
+    Update_Spatial_Index();
 }
 
 void cWaypoint::Set_Direction_Backward(ObjectDirection direction)
@@ -316,6 +342,9 @@ void cWaypoint::Set_Direction_Backward(ObjectDirection direction)
     else if (direction == DIR_DOWN) {
         m_arrow_backward = pVideo->Get_Package_Surface("game/arrow/small/blue/down.png");
     }
+
+    // the draw rect changed
+    Update_Spatial_Index();
 }
 
 void cWaypoint::Set_Access(bool enabled, bool new_start_access /* = 0 */)
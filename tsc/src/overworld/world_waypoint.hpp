@@ -51,6 +51,8 @@ namespace TSC {
         virtual void Update(void);
         // Draw
         virtual void Draw(cSurface_Request* request = NULL);
+        // the direction arrows are drawn next to the rect
+        virtual bool Get_Draw_Rect(GL_rect& rect) const;
 
         // Set direction forward
         void Set_Direction_Forward(ObjectDirection direction);
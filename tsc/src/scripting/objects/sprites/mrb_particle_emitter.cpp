@@ -13,6 +13,7 @@
  */
 
 #include "../../../video/animation.hpp"
+#include "../../../video/particle_presets.hpp"
 #include "../../../level/level.hpp"
 #include "../../../core/sprite_manager.hpp"
 #include "../../../core/property_helper.hpp"
@@ -637,6 +638,36 @@ static mrb_value Emit(mrb_state* p_state, mrb_value self)
     return mrb_nil_value();
 }
 
+/**
+ * Method: ParticleEmitter::spawn_preset
+ *
+ *   spawn_preset( name, x, y ) → true or false
+ *
+ * Emit the particle effect preset `name` once at the given position.
+ * The presets are defined in `particles/presets.xml` below the game
+ * data directory, e.g. `"enemy_ball_destroy"`. This is much cheaper
+ * than setting up a new particle emitter as the emitter is reused
+ * when finished. For the same reason you don’t get an emitter object
+ * back; returns false if there is no preset with the given name.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ ruby
+ * UIDS[14].on_activate do
+ *   ParticleEmitter.spawn_preset("turtle_boss_stars", 100, -100)
+ * end
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+static mrb_value Spawn_Preset(mrb_state* p_state, mrb_value self)
+{
+    char* name = NULL;
+    mrb_float x, y;
+    mrb_get_args(p_state, "zff", &name, &x, &y);
+
+    if (!pParticle_Preset_Manager->Spawn(name, x, y, pActive_Level->m_sprite_manager))
+        return mrb_false_value();
+
+    return mrb_true_value();
+}
+
 /***************************************
  * Binding
  ***************************************/
@@ -654,6 +685,9 @@ void TSC::Scripting::Init_ParticleEmitter(mrb_state* p_state)
     struct RClass* p_rcParticleEmitter = mrb_define_class(p_state, "ParticleEmitter", p_rcAnimation);
     MRB_SET_INSTANCE_TT(p_rcParticleEmitter, MRB_TT_DATA);
 
+    // Class methods
+    mrb_define_class_method(p_state, p_rcParticleEmitter, "spawn_preset", Spawn_Preset, MRB_ARGS_REQ(3));
+
     // Methods
     mrb_define_method(p_state, p_rcParticleEmitter, "initialize", Initialize, MRB_ARGS_REQ(2) | MRB_ARGS_OPT(2));
     mrb_define_method(p_state, p_rcParticleEmitter, "inspect", Inspect, MRB_ARGS_NONE());
@@ -86,6 +86,11 @@ namespace TSC {
 
 namespace Scripting {
 
+void Script_Access(cSprite* p_sprite)
+{
+    p_sprite->Wake_Up();
+}
+
 cMRuby_Interpreter::cMRuby_Interpreter(cLevel* p_level)
 {
     // Set member variables
@@ -40,10 +40,17 @@ namespace TSC {
             return mrb_symbol_value(mrb_intern_cstr(mrb, str.c_str()));
         }
 
+        // Wakes up the given sprite if it is dormant, as
+        // scripts expect the sprites they use to react.
+        void Script_Access(cSprite* p_sprite);
+        // Other objects can't be dormant.
+        inline void Script_Access(void* p_obj) {}
+
         /**
          * Shorthand for doing
          *   DATA_GET_PTR(p_state, obj, &rtTSC_Scriptable)
-         * over and over with a security NULL check.
+         * over and over with a security NULL check. Sprites
+         * accessed this way are woken up if dormant.
          */
         template<typename T>
         T* Get_Data_Ptr(mrb_state* p_state, mrb_value obj)
@@ -54,6 +61,7 @@ namespace TSC {
                 return NULL; // Not reached
             }
 
+            Script_Access(p_result);
             return p_result;
         }
 
@@ -43,6 +43,8 @@ const bool cPreferences::m_always_run_default = 0;
 const std::string cPreferences::m_menu_level_default = "menu_brown_1";
 const float cPreferences::m_camera_hor_speed_default = 0.3f;
 const float cPreferences::m_camera_ver_speed_default = 0.2f;
+const float cPreferences::m_activity_range_default = 1000.0f;
+const bool cPreferences::m_parallel_update_default = 0;
 // Video
 #ifdef _DEBUG
 const bool cPreferences::m_video_fullscreen_default = 0;
@@ -57,6 +59,10 @@ const uint8_t cPreferences::m_video_screen_bpp_default = 32;
 */
 const bool cPreferences::m_video_vsync_default = 0;
 const uint16_t cPreferences::m_video_fps_limit_default = 240;
+const bool cPreferences::m_video_batch_rendering_default = 1;
+const bool cPreferences::m_video_shader_rendering_default = 1;
+const bool cPreferences::m_video_render_thread_default = 0;
+const unsigned int cPreferences::m_video_particle_limit_default = 20000;
 // default geometry detail is medium
 const float cPreferences::m_geometry_quality_default = 0.5f;
 // default texture detail is high
@@ -155,6 +161,8 @@ void cPreferences::Save(void)
     Add_Property(p_root, "game_menu_level", m_menu_level);
     Add_Property(p_root, "game_camera_hor_speed", m_camera_hor_speed);
     Add_Property(p_root, "game_camera_ver_speed", m_camera_ver_speed);
+    Add_Property(p_root, "game_activity_range", m_activity_range);
+    Add_Property(p_root, "game_parallel_update", m_parallel_update);
     // Video
     Add_Property(p_root, "video_fullscreen", m_video_fullscreen);
     Add_Property(p_root, "video_screen_w", m_video_screen_w);
@@ -162,6 +170,10 @@ void cPreferences::Save(void)
     Add_Property(p_root, "video_screen_bpp", static_cast<int>(m_video_screen_bpp));
     Add_Property(p_root, "video_vsync", m_video_vsync);
     Add_Property(p_root, "video_fps_limit", m_video_fps_limit);
+    Add_Property(p_root, "video_batch_rendering", m_video_batch_rendering);
+    Add_Property(p_root, "video_shader_rendering", m_video_shader_rendering);
+    Add_Property(p_root, "video_render_thread", m_video_render_thread);
+    Add_Property(p_root, "video_particle_limit", m_video_particle_limit);
     Add_Property(p_root, "video_geometry_quality", pVideo->m_geometry_quality);
     Add_Property(p_root, "video_texture_quality", pVideo->m_texture_quality);
     // Audio
@@ -238,6 +250,8 @@ void cPreferences::Reset_Game(void)
     m_menu_level = m_menu_level_default;
     m_camera_hor_speed = m_camera_hor_speed_default;
     m_camera_ver_speed = m_camera_ver_speed_default;
+    m_activity_range = m_activity_range_default;
+    m_parallel_update = m_parallel_update_default;
 }
 
 void cPreferences::Reset_Video(void)
@@ -248,6 +262,10 @@ void cPreferences::Reset_Video(void)
     m_video_screen_bpp = m_video_screen_bpp_default;
     m_video_vsync = m_video_vsync_default;
     m_video_fps_limit = m_video_fps_limit_default;
+    m_video_batch_rendering = m_video_batch_rendering_default;
+    m_video_shader_rendering = m_video_shader_rendering_default;
+    m_video_render_thread = m_video_render_thread_default;
+    m_video_particle_limit = m_video_particle_limit_default;
     m_video_fullscreen = m_video_fullscreen_default;
     pVideo->m_geometry_quality = m_geometry_quality_default;
     pVideo->m_texture_quality = m_texture_quality_default;
@@ -72,6 +72,14 @@ namespace TSC {
         // smart camera speed
         float m_camera_hor_speed;
         float m_camera_ver_speed;
+        /* distance around the screen in which level objects stay active
+         * objects further away become dormant, disabled if 0
+        */
+        float m_activity_range;
+        /* update independent enemies on worker threads
+         * the result is the same as updating them one after another
+        */
+        bool m_parallel_update;
 
         // Audio
         bool m_audio_music;
@@ -85,6 +93,22 @@ namespace TSC {
         uint8_t m_video_screen_bpp;
         bool m_video_vsync;
         uint16_t m_video_fps_limit;
+        /* draw surfaces with the same state together from a vertex buffer
+         * if disabled every surface is drawn on its own
+        */
+        bool m_video_batch_rendering;
+        /* draw the batched surfaces with a shader if available
+         * shadows and color combinations can then be drawn together with the other surfaces
+        */
+        bool m_video_shader_rendering;
+        /* render the game in a thread while the next frame is updated
+         * the game is shown one frame behind the GUI
+        */
+        bool m_video_render_thread;
+        /* maximum live particles of all emitters
+         * only high priority emitters can exceed it and 0 is unlimited
+        */
+        unsigned int m_video_particle_limit;
 
         // Keyboard
         // key definitions
@@ -158,6 +182,8 @@ namespace TSC {
         static const std::string m_menu_level_default;
         static const float m_camera_hor_speed_default;
         static const float m_camera_ver_speed_default;
+        static const float m_activity_range_default;
+        static const bool m_parallel_update_default;
         // Audio
         static const bool m_audio_music_default;
         static const bool m_audio_sound_default;
@@ -171,6 +197,10 @@ namespace TSC {
         static const uint8_t m_video_screen_bpp_default;
         static const bool m_video_vsync_default;
         static const uint16_t m_video_fps_limit_default;
+        static const bool m_video_batch_rendering_default;
+        static const bool m_video_shader_rendering_default;
+        static const bool m_video_render_thread_default;
+        static const unsigned int m_video_particle_limit_default;
         static const float m_geometry_quality_default;
         static const float m_texture_quality_default;
         // Keyboard
@@ -131,6 +131,15 @@ void cPreferencesLoader::handle_property(const std::string& name, const std::str
         mp_preferences->m_camera_hor_speed = string_to_float(value);
     else if (name == "game_camera_ver_speed" || name == "camera_ver_speed")
         mp_preferences->m_camera_ver_speed = string_to_float(value);
+    else if (name == "game_activity_range") {
+        float range = string_to_float(value);
+        if (range < 0.0f)
+            range = 0.0f;
+
+        mp_preferences->m_activity_range = range;
+    }
+    else if (name == "game_parallel_update")
+        mp_preferences->m_parallel_update = string_to_bool(value);
     //////////////////// Video ////////////////////
     else if (name == "video_screen_h") {
         val = string_to_int(value);
@@ -163,6 +172,14 @@ void cPreferencesLoader::handle_property(const std::string& name, const std::str
         mp_preferences->m_video_vsync = string_to_bool(value);
     else if (name == "video_fps_limit")
         mp_preferences->m_video_fps_limit = string_to_int(value);
+    else if (name == "video_batch_rendering")
+        mp_preferences->m_video_batch_rendering = string_to_bool(value);
+    else if (name == "video_shader_rendering")
+        mp_preferences->m_video_shader_rendering = string_to_bool(value);
+    else if (name == "video_render_thread")
+        mp_preferences->m_video_render_thread = string_to_bool(value);
+    else if (name == "video_particle_limit")
+        mp_preferences->m_video_particle_limit = string_to_int(value);
     else if (name == "video_fullscreen")
         mp_preferences->m_video_fullscreen = string_to_bool(value);
     else if (name == "video_geometry_detail" || name == "video_geometry_quality")
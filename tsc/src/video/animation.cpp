@@ -15,6 +15,8 @@
 */
 
 #include "../video/animation.hpp"
+#include "../video/particle_kernels.hpp"
+#include "../video/particle_presets.hpp"
 #include "../core/framerate.hpp"
 #include "../core/game_core.hpp"
 #include "../video/gl_surface.hpp"
@@ -344,120 +346,84 @@ void cAnimation_Fireball::Draw(cSurface_Request* request /* = NULL */)
     }
 }
 
-/* *** *** *** *** *** *** *** cParticle *** *** *** *** *** *** *** *** *** *** */
+/* *** *** *** *** *** *** *** cParticle_List *** *** *** *** *** *** *** *** *** *** */
 
-cParticle::cParticle(cParticle_Emitter* parent)
-    : cMovingSprite(parent->m_sprite_manager)
+size_t cParticle_List::Add(void)
 {
-    m_can_be_on_ground = 0;
-    // scale centered
-    Set_Scale_Directions(1, 1, 1, 1);
-
-    m_time_to_live = 0.0f;
-    m_const_rot_x = 0.0f;
-    m_const_rot_y = 0.0f;
-    m_const_rot_z = 0.0f;
-    m_gravity_x = 0.0f;
-    m_gravity_y = 0.0f;
+    const size_t index = m_pos_x.size();
 
-    m_fade_pos = 1.0f;
+    Resize(index + 1);
 
-    m_parent = parent;
+    return index;
 }
 
-cParticle::~cParticle(void)
+void cParticle_List::Move(size_t dest, size_t src)
 {
-
+    m_pos_x[dest] = m_pos_x[src];
+    m_pos_y[dest] = m_pos_y[src];
+    m_pos_z[dest] = m_pos_z[src];
+    m_vel_x[dest] = m_vel_x[src];
+    m_vel_y[dest] = m_vel_y[src];
+    m_gravity_x[dest] = m_gravity_x[src];
+    m_gravity_y[dest] = m_gravity_y[src];
+    m_rot_x[dest] = m_rot_x[src];
+    m_rot_y[dest] = m_rot_y[src];
+    m_rot_z[dest] = m_rot_z[src];
+    m_const_rot_x[dest] = m_const_rot_x[src];
+    m_const_rot_y[dest] = m_const_rot_y[src];
+    m_const_rot_z[dest] = m_const_rot_z[src];
+    m_scale[dest] = m_scale[src];
+    m_color[dest] = m_color[src];
+    m_time_to_live[dest] = m_time_to_live[src];
+    m_fade_pos[dest] = m_fade_pos[src];
 }
 
-void cParticle::Update(void)
+void cParticle_List::Remove_Finished(void)
 {
-    // update fade modifier
-    m_fade_pos -= ((static_cast<float>(speedfactor_fps) * 0.001f) * pFramerate->m_speed_factor) / m_time_to_live;
+    const size_t count = m_pos_x.size();
+    // particles still alive are moved down to this index
+    size_t alive = 0;
 
-    // finished fading
-    if (m_fade_pos <= 0.0f) {
-        m_fade_pos = 0.0f;
-        Set_Active(0);
-        return;
-    }
-
-    // with size fading
-    if (m_parent->m_fade_size) {
-        Set_Scale(m_start_scale_x * m_fade_pos);
-    }
+    for (size_t i = 0; i < count; i++) {
+        // finished fading
+        if (m_fade_pos[i] <= 0.0f) {
+            continue;
+        }
 
-    // move
-    Move(m_velx, m_vely);
-    // todo : gravity maximum
-    Add_Velocity(m_gravity_x, m_gravity_y);
+        if (alive != i) {
+            Move(alive, i);
+        }
 
-    // constant rotation
-    if (!Is_Float_Equal(m_const_rot_x, 0.0f)) {
-        Add_Rotation_X(m_const_rot_x * pFramerate->m_speed_factor);
-    }
-    if (!Is_Float_Equal(m_const_rot_y, 0.0f)) {
-        Add_Rotation_Y(m_const_rot_y * pFramerate->m_speed_factor);
-    }
-    if (!Is_Float_Equal(m_const_rot_z, 0.0f)) {
-        Add_Rotation_Z(m_const_rot_z * pFramerate->m_speed_factor);
+        alive++;
     }
+
+    Resize(alive);
 }
 
-void cParticle::Draw(cSurface_Request* request /* = NULL */)
+void cParticle_List::Resize(size_t size)
 {
-    if (!m_image) {
-        return;
-    }
-
-    bool create_request = 0;
-
-    if (!request) {
-        create_request = 1;
-        // create request
-        request = new cSurface_Request();
-    }
-
-    Draw_Image_Normal(request);
-
-    // based on emitter position
-    if (m_parent->m_particle_based_on_emitter_pos > 0.0f) {
-        request->m_pos_x += (m_parent->m_pos_x * m_parent->m_particle_based_on_emitter_pos);
-        request->m_pos_y += (m_parent->m_pos_y * m_parent->m_particle_based_on_emitter_pos);
-    }
-
-    // blending
-    if (m_parent->m_blending == BLEND_ADD) {
-        request->m_blend_sfactor = GL_SRC_ALPHA;
-        request->m_blend_dfactor = GL_ONE;
-    }
-    else if (m_parent->m_blending == BLEND_DRIVE) {
-        request->m_blend_sfactor = GL_SRC_COLOR;
-        request->m_blend_dfactor = GL_DST_ALPHA;
-    }
-
-    // color fading
-    if (m_parent->m_fade_color) {
-        request->m_color.red = static_cast<uint8_t>(m_color.red * m_fade_pos);
-        request->m_color.green = static_cast<uint8_t>(m_color.green * m_fade_pos);
-        request->m_color.blue = static_cast<uint8_t>(m_color.blue * m_fade_pos);
-    }
-
-    // alpha fading
-    if (m_parent->m_fade_alpha) {
-        request->m_color.alpha = static_cast<uint8_t>(request->m_color.alpha * m_fade_pos);
-    }
-
-    if (create_request) {
-        // add request
-        pRenderer->Add(request);
-    }
+    m_pos_x.resize(size);
+    m_pos_y.resize(size);
+    m_pos_z.resize(size);
+    m_vel_x.resize(size);
+    m_vel_y.resize(size);
+    m_gravity_x.resize(size);
+    m_gravity_y.resize(size);
+    m_rot_x.resize(size);
+    m_rot_y.resize(size);
+    m_rot_z.resize(size);
+    m_const_rot_x.resize(size);
+    m_const_rot_y.resize(size);
+    m_const_rot_z.resize(size);
+    m_scale.resize(size);
+    m_color.resize(size);
+    m_time_to_live.resize(size);
+    m_fade_pos.resize(size);
 }
 
-void cParticle::Set_Gravity(float x, float y)
+void cParticle_List::Clear(void)
 {
-    m_gravity_x = x;
-    m_gravity_y = y;
+    Resize(0);
 }
 
 /* *** *** *** *** *** *** *** cParticle_Emitter *** *** *** *** *** *** *** *** *** *** */
@@ -476,6 +442,9 @@ cParticle_Emitter::cParticle_Emitter(XmlAttributes& attributes, cSprite_Manager*
     // Particle image filename
     Set_Image_Filename(utf8_to_path(attributes["particle_image"]));
 
+    // level emitters are decoration
+    Set_Priority(PARTICLE_PRIORITY_LOW);
+
 
     // position z
     Set_Pos_Z(attributes.fetch<float>("pos_z", m_pos_z),
@@ -618,10 +587,13 @@ void cParticle_Emitter::Init(void)
 
     m_clip_rect = GL_rect();
     m_clip_mode = PCM_MOVE;
+    m_priority = PARTICLE_PRIORITY_NORMAL;
+    m_pooled = 0;
 
     // animation data
     m_emit_counter = 0.0f;
     m_emitter_living_time = 0.0f;
+    m_budget_remainder = 0.0f;
 }
 
 cParticle_Emitter* cParticle_Emitter::Copy(void) const
@@ -651,6 +623,7 @@ cParticle_Emitter* cParticle_Emitter::Copy(void) const
     particle_animation->Set_Spawned(m_spawned);
     particle_animation->Set_Clip_Rect(m_clip_rect);
     particle_animation->Set_Clip_Mode(m_clip_mode);
+    particle_animation->Set_Priority(m_priority);
     return particle_animation;
 }
 
@@ -761,8 +734,11 @@ void cParticle_Emitter::Emit(void)
         return;
     }
 
-    for (unsigned int i = 0; i < m_emitter_quota; i++) {
-        cParticle* particle = new cParticle(this);
+    // the budget can reduce the quota
+    const unsigned int quota = pParticle_Budget->Request(m_emitter_quota, m_priority, m_budget_remainder);
+
+    for (unsigned int i = 0; i < quota; i++) {
+        const size_t num = m_particles.Add();
 
         // X Position
         float x = m_pos_x - (m_image->m_w * 0.5f);
@@ -775,16 +751,15 @@ void cParticle_Emitter::Emit(void)
             y += Get_Random_Float(0.0f, m_rect.m_h);
         }
         // Set Position
-        particle->Set_Pos(x, y, 1);
-
-        // Image
-        particle->Set_Image(m_image, 1);
+        m_particles.m_pos_x[num] = x;
+        m_particles.m_pos_y[num] = y;
 
         // Z position
-        particle->m_pos_z = m_pos_z;
+        float z = m_pos_z;
         if (m_pos_z_rand > 0.0f) {
-            particle->m_pos_z += Get_Random_Float(0.0f, m_pos_z_rand);
+            z += Get_Random_Float(0.0f, m_pos_z_rand);
         }
+        m_particles.m_pos_z[num] = z;
 
         // angle range
         float dir_angle = m_angle_start;
@@ -799,38 +774,42 @@ void cParticle_Emitter::Emit(void)
             speed += Get_Random_Float(0.0f, m_vel_rand);
         }
         // Set Velocity
-        particle->Set_Velocity_From_Angle(dir_angle, speed, 1);
+        m_particles.m_vel_x[num] = cos(dir_angle * deg_to_rad) * speed;
+        m_particles.m_vel_y[num] = sin(dir_angle * deg_to_rad) * speed;
 
         // Start rotation
-        particle->m_rot_x = m_start_rot_x;
-        particle->m_rot_y = m_start_rot_y;
-        particle->m_rot_z = m_start_rot_z;
+        m_particles.m_rot_x[num] = m_start_rot_x;
+        m_particles.m_rot_y[num] = m_start_rot_y;
+        m_particles.m_rot_z[num] = m_start_rot_z;
 
         // Start direction is added to the z rotation
         if (m_start_rot_z_uses_direction) {
-            particle->m_rot_z += dir_angle;
+            m_particles.m_rot_z[num] += dir_angle;
         }
 
         // Constant rotation
-        particle->m_const_rot_x = m_const_rot_x;
-        particle->m_const_rot_y = m_const_rot_y;
-        particle->m_const_rot_z = m_const_rot_z;
+        float const_rot_x = m_const_rot_x;
+        float const_rot_y = m_const_rot_y;
+        float const_rot_z = m_const_rot_z;
         if (m_const_rot_x_rand > 0.0f) {
-            particle->m_const_rot_x += Get_Random_Float(0.0f, m_const_rot_x_rand);
+            const_rot_x += Get_Random_Float(0.0f, m_const_rot_x_rand);
         }
         if (m_const_rot_y_rand > 0.0f) {
-            particle->m_const_rot_y += Get_Random_Float(0.0f, m_const_rot_y_rand);
+            const_rot_y += Get_Random_Float(0.0f, m_const_rot_y_rand);
         }
         if (m_const_rot_z_rand > 0.0f) {
-            particle->m_const_rot_z += Get_Random_Float(0.0f, m_const_rot_z_rand);
+            const_rot_z += Get_Random_Float(0.0f, m_const_rot_z_rand);
         }
+        m_particles.m_const_rot_x[num] = const_rot_x;
+        m_particles.m_const_rot_y[num] = const_rot_y;
+        m_particles.m_const_rot_z[num] = const_rot_z;
 
         // Scale
         float scale = m_size_scale;
         if (m_size_scale_rand > 0.0f) {
             scale += Get_Random_Float(0.0f, m_size_scale_rand);
         }
-        particle->Set_Scale(scale, 1);
+        m_particles.m_scale[num] = scale;
 
         // Gravity
         float grav_x = m_gravity_x;
@@ -842,41 +821,40 @@ void cParticle_Emitter::Emit(void)
             grav_y += Get_Random_Float(0.0f, m_gravity_y_rand);
         }
         // set Gravity
-        particle->Set_Gravity(grav_x, grav_y);
+        m_particles.m_gravity_x[num] = grav_x;
+        m_particles.m_gravity_y[num] = grav_y;
 
         // Color
-        particle->Set_Color(m_color);
+        Color color = m_color;
         if (m_color_rand.red > 0) {
-            particle->m_color.red += rand() % m_color_rand.red;
+            color.red += rand() % m_color_rand.red;
         }
         if (m_color_rand.green > 0) {
-            particle->m_color.green += rand() % m_color_rand.green;
+            color.green += rand() % m_color_rand.green;
         }
         if (m_color_rand.blue > 0) {
-            particle->m_color.blue += rand() % m_color_rand.blue;
+            color.blue += rand() % m_color_rand.blue;
         }
         if (m_color_rand.alpha > 0) {
-            particle->m_color.alpha += rand() % m_color_rand.alpha;
+            color.alpha += rand() % m_color_rand.alpha;
         }
+        m_particles.m_color[num] = color;
 
         // Time to life
-        particle->m_time_to_live = m_time_to_live;
+        float ttl = m_time_to_live;
         if (m_time_to_live_rand > 0.0f) {
-            particle->m_time_to_live += Get_Random_Float(0.0f, m_time_to_live_rand);
+            ttl += Get_Random_Float(0.0f, m_time_to_live_rand);
         }
-
-        m_objects.push_back(particle);
+        m_particles.m_time_to_live[num] = ttl;
+        m_particles.m_fade_pos[num] = 1.0f;
     }
 }
 
 void cParticle_Emitter::Clear(bool reset /* = 1 */)
 {
     // clear particles
-    for (ParticleList::iterator itr = m_objects.begin(); itr != m_objects.end(); ++itr) {
-        delete *itr;
-    }
-
-    m_objects.clear();
+    Release_Particles(m_particles.Size());
+    m_particles.Clear();
 
     // clear animation data
     m_emit_counter = 0.0f;
@@ -903,23 +881,14 @@ void cParticle_Emitter::Update(void)
 
 void cParticle_Emitter::Update_Particles(void)
 {
-    // update objects
-    for (ParticleList::iterator itr = m_objects.begin(); itr != m_objects.end();) {
-        // get object pointer
-        cParticle* obj = (*itr);
+    const float fade_step = (static_cast<float>(speedfactor_fps) * 0.001f) * pFramerate->m_speed_factor;
 
-        // update
-        obj->Update();
+    // update particles and remove the finished ones
+    const unsigned int finished = Particle_Integrate(m_particles, pFramerate->m_speed_factor, fade_step);
 
-        // if finished
-        if (!obj->m_active) {
-            itr = m_objects.erase(itr);
-            delete obj;
-        }
-        // increment
-        else {
-            ++itr;
-        }
+    if (finished > 0) {
+        m_particles.Remove_Finished();
+        Release_Particles(finished);
     }
 
     // if able to emit or endless emitter
@@ -933,7 +902,7 @@ void cParticle_Emitter::Update_Particles(void)
         m_emit_counter += pFramerate->m_speed_factor * (static_cast<float>(speedfactor_fps) * 0.001f);
     }
     // no particles are active
-    else if (m_objects.empty()) {
+    else if (m_particles.Empty()) {
         Set_Active(0);
     }
 }
@@ -976,8 +945,8 @@ void cParticle_Emitter::Draw(cSurface_Request* request /* = NULL */)
         return;
     }
 
-    for (ParticleList::iterator itr = m_objects.begin(); itr != m_objects.end(); ++itr) {
-        (*itr)->Draw();
+    if (m_image) {
+        Draw_Particles();
     }
 
     if (editor_enabled) {
@@ -1009,94 +978,118 @@ void cParticle_Emitter::Draw(cSurface_Request* request /* = NULL */)
 
 void cParticle_Emitter::Keep_Particles_In_Rect(const GL_rect& clip_rect, ParticleClipMode mode /* = PCM_MOVE */)
 {
-    // temporary obj rect
-    GL_rect obj_rect;
+    if (!m_image) {
+        return;
+    }
 
-    // find particles that are not visible and move them to the opposite screen side
-    for (ParticleList::iterator itr = m_objects.begin(); itr != m_objects.end(); ++itr) {
-        // get animation particle pointer
-        cParticle* obj = static_cast<cParticle*>(*itr);
+    Particle_Clip(m_particles, clip_rect, mode, m_image->m_w, m_image->m_h, m_fade_size);
+}
 
-        // set rectangle
-        if (obj->m_scale_x != 1.0f) {
-            obj_rect.m_x = obj->m_pos_x - ((obj->m_image->m_w * 0.5f) * (obj->m_scale_x - 1.0f));
-            obj_rect.m_w = obj->m_rect.m_w * obj->m_scale_x;
-        }
-        else {
-            obj_rect.m_x = obj->m_pos_x;
-            obj_rect.m_w = obj->m_rect.m_w;
-        }
+void cParticle_Emitter::Release_Particles(size_t count)
+{
+    // emitters can be deleted after the budget when exiting
+    if (pParticle_Budget && count > 0) {
+        pParticle_Budget->Release(static_cast<unsigned int>(count));
+    }
+}
 
-        if (obj->m_scale_y != 1.0f) {
-            obj_rect.m_y = obj->m_pos_y - ((obj->m_image->m_h * 0.5f) * (obj->m_scale_y - 1.0f));
-            obj_rect.m_h = obj->m_rect.m_h * obj->m_scale_y;
-        }
-        else {
-            obj_rect.m_y = obj->m_pos_y;
-            obj_rect.m_h = obj->m_rect.m_h;
-        }
+void cParticle_Emitter::Draw_Particles(void)
+{
+    if (m_particles.Empty()) {
+        return;
+    }
 
-        // out in left
-        if (obj_rect.m_x + obj_rect.m_w < clip_rect.m_x) {
-            // move to right
-            if (mode == PCM_MOVE) {
-                obj->Move(clip_rect.m_w + obj_rect.m_w - 1.0f, 0, 1);
-            }
-            else if (mode == PCM_REVERSE) {
-                if (obj->m_velx < 0.0f) {
-                    obj->Set_Velocity(-obj->m_velx, obj->m_vely);
-                }
-            }
-            else if (mode == PCM_DELETE) {
-                obj->Set_Active(0);
-            }
+    const cGL_Surface* image = m_image;
+    const size_t count = m_particles.Size();
+
+    // based on emitter position
+    float offset_x = 0.0f;
+    float offset_y = 0.0f;
+
+    if (m_particle_based_on_emitter_pos > 0.0f) {
+        offset_x = m_pos_x * m_particle_based_on_emitter_pos;
+        offset_y = m_pos_y * m_particle_based_on_emitter_pos;
+    }
+
+    cParticle_Request* request = new cParticle_Request();
+
+    // texture id
+    request->m_texture_id = image->m_image;
+    request->m_tex_x1 = image->m_tex_x1;
+    request->m_tex_y1 = image->m_tex_y1;
+    request->m_tex_x2 = image->m_tex_x2;
+    request->m_tex_y2 = image->m_tex_y2;
+
+    // size
+    request->m_w = image->m_start_w;
+    request->m_h = image->m_start_h;
+
+    // sorted at the emitter z position and every particle is drawn at its own offset to it
+    request->m_pos_z = m_pos_z;
+
+    // blending
+    if (m_blending == BLEND_ADD) {
+        request->m_blend_sfactor = GL_SRC_ALPHA;
+        request->m_blend_dfactor = GL_ONE;
+    }
+    else if (m_blending == BLEND_DRIVE) {
+        request->m_blend_sfactor = GL_SRC_COLOR;
+        request->m_blend_dfactor = GL_DST_ALPHA;
+    }
+
+    request->m_instances.resize(count);
+
+    for (size_t i = 0; i < count; i++) {
+        cParticle_Request::Instance& instance = request->m_instances[i];
+        const float fade_pos = m_particles.m_fade_pos[i];
+
+        // rotation
+        instance.m_rot_x = m_particles.m_rot_x[i] + image->m_base_rot_x;
+        instance.m_rot_y = m_particles.m_rot_y[i] + image->m_base_rot_y;
+        instance.m_rot_z = m_particles.m_rot_z[i] + image->m_base_rot_z;
+
+        float scale = m_particles.m_scale[i];
+
+        // with size fading
+        if (m_fade_size) {
+            scale *= fade_pos;
         }
-        // out in right
-        else if (obj_rect.m_x > clip_rect.m_x + clip_rect.m_w) {
-            // move to left
-            if (mode == PCM_MOVE) {
-                obj->Move(-clip_rect.m_w - obj_rect.m_w + 1.0f, 0, 1);
-            }
-            else if (mode == PCM_REVERSE) {
-                if (obj->m_velx > 0.0f) {
-                    obj->Set_Velocity(-obj->m_velx, obj->m_vely);
-                }
-            }
-            else if (mode == PCM_DELETE) {
-                obj->Set_Active(0);
-            }
+
+        // an invalid scale is not used
+        if (scale <= 0.0f) {
+            scale = 1.0f;
         }
-        // out on top
-        else if (obj_rect.m_y + obj_rect.m_h < clip_rect.m_y) {
-            // move to bottom
-            if (mode == PCM_MOVE) {
-                obj->Move(0, clip_rect.m_h + obj_rect.m_h - 1.0f, 1);
-            }
-            else if (mode == PCM_REVERSE) {
-                if (obj->m_vely < 0.0f) {
-                    obj->Set_Velocity(obj->m_velx, -obj->m_vely);
-                }
-            }
-            else if (mode == PCM_DELETE) {
-                obj->Set_Active(0);
-            }
+
+        /* scaling is centered
+         * the instance position is the center of the quad
+        */
+        instance.m_scale = scale;
+        instance.m_x = m_particles.m_pos_x[i] + (image->m_int_x * scale) - ((image->m_w * 0.5f) * (scale - 1.0f)) + (request->m_w * 0.5f * scale) + offset_x;
+        instance.m_y = m_particles.m_pos_y[i] + (image->m_int_y * scale) - ((image->m_h * 0.5f) * (scale - 1.0f)) + (request->m_h * 0.5f * scale) + offset_y;
+        instance.m_z = m_particles.m_pos_z[i] - m_pos_z;
+
+        // color
+        const Color& color = m_particles.m_color[i];
+        instance.m_color[0] = color.red;
+        instance.m_color[1] = color.green;
+        instance.m_color[2] = color.blue;
+        instance.m_color[3] = color.alpha;
+
+        // color fading
+        if (m_fade_color) {
+            instance.m_color[0] = static_cast<uint8_t>(color.red * fade_pos);
+            instance.m_color[1] = static_cast<uint8_t>(color.green * fade_pos);
+            instance.m_color[2] = static_cast<uint8_t>(color.blue * fade_pos);
         }
-        // out on bottom
-        else if (obj_rect.m_y > clip_rect.m_y + clip_rect.m_h) {
-            // move to top
-            if (mode == PCM_MOVE) {
-                obj->Move(0, -clip_rect.m_h - obj_rect.m_h + 1.0f, 1);
-            }
-            else if (mode == PCM_REVERSE) {
-                if (obj->m_vely > 0.0f) {
-                    obj->Set_Velocity(obj->m_velx, -obj->m_vely);
-                }
-            }
-            else if (mode == PCM_DELETE) {
-                obj->Set_Active(0);
-            }
+
+        // alpha fading
+        if (m_fade_alpha) {
+            instance.m_color[3] = static_cast<uint8_t>(color.alpha * fade_pos);
         }
     }
+
+    // add request
+    pRenderer->Add(request);
 }
 
 bool cParticle_Emitter::Is_Update_Valid()
@@ -1124,6 +1117,20 @@ bool cParticle_Emitter::Is_Update_Valid()
     return 1;
 }
 
+bool cParticle_Emitter::Can_Be_Dormant(void) const
+{
+    if (m_emitter_based_on_camera_pos) {
+        return 0;
+    }
+
+    return cAnimation::Can_Be_Dormant();
+}
+
+bool cParticle_Emitter::Get_Draw_Rect(GL_rect& rect) const
+{
+    return 0;
+}
+
 bool cParticle_Emitter::Is_Draw_Valid(void)
 {
     // if not visible
@@ -1211,6 +1218,8 @@ void cParticle_Emitter::Set_Emitter_Rect(float x, float y, float w /* = 0 */, fl
     m_col_rect.m_h = m_rect.m_h;
     m_start_rect.m_w = m_rect.m_w;
     m_start_rect.m_h = m_rect.m_h;
+
+    Update_Spatial_Index();
 }
 
 void cParticle_Emitter::Set_Emitter_Rect(const GL_rect& rect)
@@ -1362,6 +1371,11 @@ void cParticle_Emitter::Set_Clip_Mode(ParticleClipMode mode)
     m_clip_mode = mode;
 }
 
+void cParticle_Emitter::Set_Priority(ParticlePriority priority)
+{
+    m_priority = priority;
+}
+
 void cParticle_Emitter::Editor_Activate(void)
 {
     CEGUI::WindowManager& wmgr = CEGUI::WindowManager::getSingleton();
@@ -2118,7 +2132,7 @@ void cAnimation_Manager::Update(void)
         // delete if finished
         if (!obj->m_active) {
             itr = objects.erase(itr);
-            delete obj;
+            Delete_Animation(obj);
         }
         // increment
         else {
@@ -2134,6 +2148,30 @@ void cAnimation_Manager::Draw(void)
     }
 }
 
+void cAnimation_Manager::Delete_All(void)
+{
+    for (cAnimation_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+        Delete_Animation(*itr);
+    }
+
+    objects.clear();
+}
+
+void cAnimation_Manager::Delete_Animation(cAnimation* animation)
+{
+    if (animation->m_type == TYPE_PARTICLE_EMITTER) {
+        cParticle_Emitter* emitter = static_cast<cParticle_Emitter*>(animation);
+
+        // reuse preset emitters
+        if (emitter->m_pooled && pParticle_Preset_Manager) {
+            pParticle_Preset_Manager->Release_Emitter(emitter);
+            return;
+        }
+    }
+
+    delete animation;
+}
+
 void cAnimation_Manager::Add(cAnimation* animation)
 {
     if (!animation) {
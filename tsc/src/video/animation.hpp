@@ -19,6 +19,7 @@
 
 #include "../objects/movingsprite.hpp"
 #include "../core/obj_manager.hpp"
+#include "../video/particle_budget.hpp"
 
 namespace TSC {
 
@@ -116,39 +117,62 @@ namespace TSC {
         FireAnimList m_objects;
     };
 
-    /* *** *** *** *** *** *** *** Particle Emitter item *** *** *** *** *** *** *** *** *** *** */
+    /* *** *** *** *** *** *** *** Particle Emitter items *** *** *** *** *** *** *** *** *** *** */
 
-// forward declare
-    class cParticle_Emitter;
-
-// Particle Item
-    class cParticle : public cMovingSprite {
+    /* Particles of one emitter as a structure of arrays
+     * every attribute is kept in its own array so updating walks
+     * a few tightly packed arrays instead of one sprite per particle
+     * the order of the particles is kept when removing them
+    */
+    class cParticle_List {
     public:
-        cParticle(cParticle_Emitter* parent);
-        virtual ~cParticle(void);
-
-        // update
-        virtual void Update(void);
-        // draw
-        virtual void Draw(cSurface_Request* request = NULL);
-
-        // set gravity
-        void Set_Gravity(float x, float y);
+        // Return the number of particles
+        inline size_t Size(void) const
+        {
+            return m_pos_x.size();
+        }
+        inline bool Empty(void) const
+        {
+            return m_pos_x.empty();
+        }
 
-        // parent particle emitter
-        cParticle_Emitter* m_parent;
-        // time to live
-        float m_time_to_live;
+        // Append an uninitialized particle and return its index
+        size_t Add(void);
+        // Move the particle from the source index to the destination index
+        void Move(size_t dest, size_t src);
+        // Remove the particles with a fading position of 0 or less
+        void Remove_Finished(void);
+        // Keep only the given number of first particles
+        void Resize(size_t size);
+        // Remove all particles
+        void Clear(void);
+
+        // position
+        vector<float> m_pos_x;
+        vector<float> m_pos_y;
+        vector<float> m_pos_z;
+        // velocity
+        vector<float> m_vel_x;
+        vector<float> m_vel_y;
+        // gravity
+        vector<float> m_gravity_x;
+        vector<float> m_gravity_y;
+        // rotation
+        vector<float> m_rot_x;
+        vector<float> m_rot_y;
+        vector<float> m_rot_z;
         // constant rotation
-        float m_const_rot_x;
-        float m_const_rot_y;
-        float m_const_rot_z;
-        // particle gravity
-        float m_gravity_x;
-        float m_gravity_y;
-
-        // fading position value
-        float m_fade_pos;
+        vector<float> m_const_rot_x;
+        vector<float> m_const_rot_y;
+        vector<float> m_const_rot_z;
+        // start scale
+        vector<float> m_scale;
+        // color
+        vector<Color> m_color;
+        // time to live in seconds
+        vector<float> m_time_to_live;
+        // fading position value from 1 to 0
+        vector<float> m_fade_pos;
     };
 
     /* *** *** *** *** *** *** *** Particle Emitter *** *** *** *** *** *** *** *** *** *** */
@@ -206,6 +230,10 @@ namespace TSC {
         virtual bool Is_Update_Valid();
         // if draw is valid for the current state and position
         virtual bool Is_Draw_Valid(void);
+        // emitters based on the camera position always need to be updated
+        virtual bool Can_Be_Dormant(void) const;
+        // particles can be drawn anywhere
+        virtual bool Get_Draw_Rect(GL_rect& rect) const;
 
         /* Set image
          * does not set the image filename
@@ -267,6 +295,8 @@ namespace TSC {
         void Set_Clip_Rect(const GL_rect& rect);
         // set the clip mode
         void Set_Clip_Mode(ParticleClipMode mode);
+        // set the priority used by the particle budget
+        void Set_Priority(ParticlePriority priority);
 
         // editor todo : start rotation x/y/z rand, color, color_rand
         // editor activation
@@ -311,8 +341,7 @@ namespace TSC {
         bool Editor_Clip_Mode_Select(const CEGUI::EventArgs& event);
 
         // Particle items
-        typedef vector<cParticle*> ParticleList;
-        ParticleList m_objects;
+        cParticle_List m_particles;
 
         // filename of the particle image
         boost::filesystem::path m_image_filename;
@@ -364,6 +393,10 @@ namespace TSC {
         GL_rect m_clip_rect;
         // clip mode
         ParticleClipMode m_clip_mode;
+        // particle budget priority
+        ParticlePriority m_priority;
+        // if given back to the particle preset pool when finished
+        bool m_pooled;
 
         // Save to XML node
         virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
@@ -372,10 +405,17 @@ namespace TSC {
         virtual std::string Get_XML_Type_Name();
 
     private:
+        // Add one particle request drawing all particles
+        void Draw_Particles(void);
+        // Give the given number of finished particles back to the budget
+        void Release_Particles(size_t count);
+
         // time alive
         float m_emitter_living_time;
         // emit counter
         float m_emit_counter;
+        // particle fraction carried to the next emission by the budget
+        float m_budget_remainder;
     };
 
     /* *** *** *** *** *** *** *** Animation Manager *** *** *** *** *** *** *** *** *** *** */
@@ -392,8 +432,13 @@ namespace TSC {
         void Update(void);
         // Draw the objects
         void Draw(void);
+        // Delete all objects
+        virtual void Delete_All(void);
 
         typedef vector<cAnimation*> cAnimation_List;
+    private:
+        // Delete the animation or give a pooled emitter back
+        void Delete_Animation(cAnimation* animation);
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -20,6 +20,7 @@
 #include "../core/filesystem/resource_manager.hpp"
 #include "../core/global_basic.hpp"
 #include "../core/game_core.hpp"
+#include "../video/video.hpp"
 #include "renderer.hpp"
 
 using namespace std;
@@ -27,14 +28,34 @@ using namespace TSC;
 
 /* *** *** *** *** *** *** *** Font Manager class *** *** *** *** *** *** *** *** *** *** */
 
+// above the fading and editor rects
+const float cFont_Manager::m_text_pos_z = 0.999f;
+
+// pixels around a glyph rect also copied as SFML pads the glyphs with transparent pixels
+static const int glyph_copy_padding = 2;
+
+// Return true if the font texture can be copied through a framebuffer
+static bool Has_Framebuffer_Copy(void)
+{
+    return GLEW_VERSION_3_0 || GLEW_ARB_framebuffer_object;
+}
+
 cFont_Manager::cFont_Manager(void)
 {
-    //
+    m_copy_framebuffer = 0;
 }
 
 cFont_Manager::~cFont_Manager(void)
 {
-    //
+    for (Glyph_Page_Map::iterator itr = m_glyph_pages.begin(); itr != m_glyph_pages.end(); ++itr) {
+        if (itr->second.m_texture && glIsTexture(itr->second.m_texture)) {
+            glDeleteTextures(1, &itr->second.m_texture);
+        }
+    }
+
+    if (m_copy_framebuffer && Has_Framebuffer_Copy() && glIsFramebuffer(m_copy_framebuffer)) {
+        glDeleteFramebuffers(1, &m_copy_framebuffer);
+    }
 }
 
 void cFont_Manager::Init(void)
@@ -52,10 +73,256 @@ void cFont_Manager::Init(void)
  * The `text` parameter must be prepared with Prepare_SFML_Text()
  * before passing it to this function.
  */
-void cFont_Manager::Queue_Text(const sf::Text& text)
+void cFont_Manager::Queue_Text(const sf::Text& text, float z /* = m_text_pos_z */)
 {
-    cText_Request* p_req = new cText_Request(text);
-    pRenderer->Add(p_req);
+    const sf::String& str = text.getString();
+
+    if (str.isEmpty()) {
+        return;
+    }
+
+#if SFML_VERSION_MAJOR > 2 || (SFML_VERSION_MAJOR == 2 && SFML_VERSION_MINOR >= 4)
+    const sf::Uint32 sfml_styles = sf::Text::Italic | sf::Text::Underlined | sf::Text::StrikeThrough;
+#else
+    const sf::Uint32 sfml_styles = sf::Text::Italic | sf::Text::Underlined;
+#endif
+
+    // the glyph quads are only laid out for the normal font and can not be sheared or lined
+    if (text.getFont() != &m_font_normal || (text.getStyle() & sfml_styles)) {
+        cText_Request* request = new cText_Request(text);
+        request->m_pos_z = z;
+        pRenderer->Add(request);
+        return;
+    }
+
+    const unsigned int size = text.getCharacterSize();
+    const bool bold = (text.getStyle() & sf::Text::Bold) != 0;
+    Glyph_Page& page = Get_Glyph_Page(size);
+
+    // load new glyphs first to upload the page only once
+    for (std::size_t i = 0; i < str.getSize(); i++) {
+        Get_Glyph(page, size, str[i], bold);
+    }
+
+    if (page.m_dirty) {
+        Upload_Glyph_Page(page, size);
+    }
+
+    const sf::Transform& transform = text.getTransform();
+    const sf::Color& text_color = text.getColor();
+    const Color color(text_color.r, text_color.g, text_color.b, text_color.a);
+    const float line_spacing = static_cast<float>(m_font_normal.getLineSpacing(size));
+    const float tex_scale_x = 1.0f / static_cast<float>(page.m_w);
+    const float tex_scale_y = 1.0f / static_cast<float>(page.m_h);
+
+    // the same layout as sf::Text
+    float x = 0.0f;
+    float y = static_cast<float>(size);
+    sf::Uint32 prev_character = 0;
+
+    for (std::size_t i = 0; i < str.getSize(); i++) {
+        const sf::Uint32 character = str[i];
+
+        x += static_cast<float>(m_font_normal.getKerning(prev_character, character, size));
+        prev_character = character;
+
+        if (character == '\n') {
+            x = 0.0f;
+            y += line_spacing;
+            continue;
+        }
+        if (character == '\t') {
+            x += Get_Glyph(page, size, ' ', bold).m_advance * 4;
+            continue;
+        }
+
+        const Glyph& glyph = Get_Glyph(page, size, character, bold);
+
+        // whitespace
+        if (glyph.m_tex_w <= 0 || glyph.m_tex_h <= 0) {
+            x += glyph.m_advance;
+            continue;
+        }
+
+        const sf::FloatRect rect = transform.transformRect(sf::FloatRect(x + glyph.m_left, y + glyph.m_top, glyph.m_width, glyph.m_height));
+
+        cSurface_Request* request = new cSurface_Request();
+        request->m_texture_id = page.m_texture;
+        request->m_tex_x1 = static_cast<float>(glyph.m_tex_x) * tex_scale_x;
+        request->m_tex_y1 = static_cast<float>(glyph.m_tex_y) * tex_scale_y;
+        request->m_tex_x2 = static_cast<float>(glyph.m_tex_x + glyph.m_tex_w) * tex_scale_x;
+        request->m_tex_y2 = static_cast<float>(glyph.m_tex_y + glyph.m_tex_h) * tex_scale_y;
+        request->m_pos_x = rect.left;
+        request->m_pos_y = rect.top;
+        request->m_pos_z = z;
+        request->m_w = rect.width;
+        request->m_h = rect.height;
+        request->m_color = color;
+        // SFML drew the text in window coordinates
+        request->m_global_scale = 0;
+
+        pRenderer->Add(request);
+
+        x += glyph.m_advance;
+    }
+}
+
+void cFont_Manager::Invalidate_Glyph_Pages(void)
+{
+    pVideo->Render_Finish();
+
+    for (Glyph_Page_Map::iterator itr = m_glyph_pages.begin(); itr != m_glyph_pages.end(); ++itr) {
+        if (itr->second.m_texture && glIsTexture(itr->second.m_texture)) {
+            glDeleteTextures(1, &itr->second.m_texture);
+        }
+    }
+
+    m_glyph_pages.clear();
+
+    // not shared with a new context
+    if (m_copy_framebuffer && Has_Framebuffer_Copy() && glIsFramebuffer(m_copy_framebuffer)) {
+        glDeleteFramebuffers(1, &m_copy_framebuffer);
+    }
+
+    m_copy_framebuffer = 0;
+    // the font textures of SFML are deleted too
+    Init();
+}
+
+cFont_Manager::Glyph_Page& cFont_Manager::Get_Glyph_Page(unsigned int size)
+{
+    Glyph_Page_Map::iterator itr = m_glyph_pages.find(size);
+
+    if (itr != m_glyph_pages.end()) {
+        return itr->second;
+    }
+
+    Glyph_Page& page = m_glyph_pages[size];
+    page.m_texture = 0;
+    page.m_w = 0;
+    page.m_h = 0;
+    page.m_dirty = 1;
+
+    // most texts only need these
+    for (sf::Uint32 character = 32; character < 127; character++) {
+        Get_Glyph(page, size, character, 0);
+    }
+
+    return page;
+}
+
+const cFont_Manager::Glyph& cFont_Manager::Get_Glyph(Glyph_Page& page, unsigned int size, sf::Uint32 character, bool bold)
+{
+    const sf::Uint32 key = (character << 1) | (bold ? 1 : 0);
+    Glyph_Map::iterator itr = page.m_glyphs.find(key);
+
+    if (itr != page.m_glyphs.end()) {
+        return itr->second;
+    }
+
+    // rasterised into the font texture of the size
+    const sf::Glyph& sf_glyph = m_font_normal.getGlyph(character, size, bold);
+
+    Glyph& glyph = page.m_glyphs[key];
+    glyph.m_advance = static_cast<float>(sf_glyph.advance);
+    glyph.m_left = static_cast<float>(sf_glyph.bounds.left);
+    glyph.m_top = static_cast<float>(sf_glyph.bounds.top);
+    glyph.m_width = static_cast<float>(sf_glyph.bounds.width);
+    glyph.m_height = static_cast<float>(sf_glyph.bounds.height);
+    glyph.m_tex_x = sf_glyph.textureRect.left;
+    glyph.m_tex_y = sf_glyph.textureRect.top;
+    glyph.m_tex_w = sf_glyph.textureRect.width;
+    glyph.m_tex_h = sf_glyph.textureRect.height;
+
+    if (glyph.m_tex_w > 0 && glyph.m_tex_h > 0) {
+        page.m_new_rects.push_back(sf_glyph.textureRect);
+    }
+
+    page.m_dirty = 1;
+
+    return glyph;
+}
+
+void cFont_Manager::Upload_Glyph_Page(Glyph_Page& page, unsigned int size)
+{
+    // copying the font texture needs the context
+    pVideo->Render_Finish();
+
+    const sf::Texture& font_texture = m_font_normal.getTexture(size);
+    const unsigned int font_w = font_texture.getSize().x;
+    const unsigned int font_h = font_texture.getSize().y;
+    // SFML enlarges the font texture if it is full
+    const bool resized = !page.m_texture || page.m_w != font_w || page.m_h != font_h;
+
+    if (!page.m_texture) {
+        glGenTextures(1, &page.m_texture);
+        glBindTexture(GL_TEXTURE_2D, page.m_texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+
+    if (Has_Framebuffer_Copy()) {
+        if (resized) {
+            glBindTexture(GL_TEXTURE_2D, page.m_texture);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, font_w, font_h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+            // copy everything once
+            page.m_new_rects.clear();
+            page.m_new_rects.push_back(sf::IntRect(0, 0, font_w, font_h));
+        }
+
+        Copy_Glyph_Rects(font_texture, page);
+    }
+    // without framebuffers the font texture can only be read back
+    else {
+        const sf::Image image = font_texture.copyToImage();
+
+        glBindTexture(GL_TEXTURE_2D, page.m_texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.getSize().x, image.getSize().y, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.getPixelsPtr());
+    }
+
+    page.m_w = font_w;
+    page.m_h = font_h;
+    page.m_new_rects.clear();
+    page.m_dirty = 0;
+}
+
+void cFont_Manager::Copy_Glyph_Rects(const sf::Texture& font_texture, const Glyph_Page& page)
+{
+    // SFML does not give out its texture handle but binds it
+    sf::Texture::bind(&font_texture);
+    GLint font_texture_id = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &font_texture_id);
+
+    if (!m_copy_framebuffer) {
+        glGenFramebuffers(1, &m_copy_framebuffer);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_copy_framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, static_cast<GLuint>(font_texture_id), 0);
+    glBindTexture(GL_TEXTURE_2D, page.m_texture);
+
+    const int font_w = static_cast<int>(font_texture.getSize().x);
+    const int font_h = static_cast<int>(font_texture.getSize().y);
+
+    for (vector<sf::IntRect>::const_iterator itr = page.m_new_rects.begin(); itr != page.m_new_rects.end(); ++itr) {
+        const int x1 = std::max(itr->left - glyph_copy_padding, 0);
+        const int y1 = std::max(itr->top - glyph_copy_padding, 0);
+        const int x2 = std::min(itr->left + itr->width + glyph_copy_padding, font_w);
+        const int y2 = std::min(itr->top + itr->height + glyph_copy_padding, font_h);
+
+        if (x2 <= x1 || y2 <= y1) {
+            continue;
+        }
+
+        // the framebuffer rows are the texture rows so nothing is flipped
+        glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x1, y1, x1, y1, x2 - x1, y2 - y1);
+    }
+
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
 /**
@@ -24,6 +24,14 @@ namespace TSC {
 
     /* *** *** *** *** *** *** *** Font Manager class *** *** *** *** *** *** *** *** *** *** */
 
+    /* Text is drawn as surface quads from a glyph atlas per character size
+     * The glyphs are rasterised by SFML into the font texture of the size.
+     * It is copied on the GPU into our own texture when the page is created
+     * or SFML enlarged it, and after that only the rects of new glyphs are.
+     * The quads then go through the render queue like any other surface, so
+     * they are sorted by z and batched together. Text styles the quads can
+     * not draw are drawn by SFML.
+     */
     class cFont_Manager {
     public:
         cFont_Manager(void);
@@ -38,8 +46,10 @@ namespace TSC {
         void Init(void);
 
         /// Queues text for rendering in the render queue. Use this
-        /// to get your text onto the screen.
-        void Queue_Text(const sf::Text& text);
+        /// to get your text onto the screen. The text is drawn above
+        /// everything else unless another z position is given.
+        /// Italic, underlined and struck through text is drawn by SFML.
+        void Queue_Text(const sf::Text& text, float z = m_text_pos_z);
 
         /// Update an sf::Text instance with its parameters so it
         /// is suitable for Queue_Text().
@@ -48,8 +58,61 @@ namespace TSC {
         // Renders the given text into a new surface
         //cGL_Surface* Render_Text(TTF_Font* font, const std::string& text, const Color color = static_cast<uint8_t>(0));
 
+        /* Delete the glyph atlas textures and reload the font
+         * used if the textures were deleted with the video reinitialization
+        */
+        void Invalidate_Glyph_Pages(void);
+
+        // default z position of text
+        static const float m_text_pos_z;
+
         // TTF loaded fonts
         sf::Font m_font_normal;
+
+    private:
+        // glyph of one character size
+        struct Glyph {
+            float m_advance;
+            // quad relative to the baseline
+            float m_left;
+            float m_top;
+            float m_width;
+            float m_height;
+            // pixels in the font texture
+            int m_tex_x;
+            int m_tex_y;
+            int m_tex_w;
+            int m_tex_h;
+        };
+        // key is the character shifted left by one with the bold flag in the lowest bit
+        typedef std::unordered_map<sf::Uint32, Glyph> Glyph_Map;
+
+        // glyph atlas of one character size
+        struct Glyph_Page {
+            Glyph_Map m_glyphs;
+            // texture or 0 if not uploaded
+            GLuint m_texture;
+            unsigned int m_w;
+            unsigned int m_h;
+            // if glyphs were added since the upload
+            bool m_dirty;
+            // font texture rects of the glyphs added since the upload
+            vector<sf::IntRect> m_new_rects;
+        };
+        typedef std::map<unsigned int, Glyph_Page> Glyph_Page_Map;
+
+        // Return the page of the given character size with the printable ASCII glyphs loaded
+        Glyph_Page& Get_Glyph_Page(unsigned int size);
+        // Return the glyph and load it into the font texture if new
+        const Glyph& Get_Glyph(Glyph_Page& page, unsigned int size, sf::Uint32 character, bool bold);
+        // Copy the new glyphs of the font texture of the given size into the page texture
+        void Upload_Glyph_Page(Glyph_Page& page, unsigned int size);
+        // Copy the new glyph rects of the font texture into the page texture on the GPU
+        void Copy_Glyph_Rects(const sf::Texture& font_texture, const Glyph_Page& page);
+
+        Glyph_Page_Map m_glyph_pages;
+        // reads the font texture when copying or 0 if not created
+        GLuint m_copy_framebuffer;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
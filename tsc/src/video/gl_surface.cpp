@@ -42,6 +42,10 @@ cGL_Surface::cGL_Surface(void)
     m_h = 0;
     m_tex_w = 0;
     m_tex_h = 0;
+    m_tex_x1 = 0.0f;
+    m_tex_y1 = 0.0f;
+    m_tex_x2 = 1.0f;
+    m_tex_y2 = 1.0f;
 
     // internal rotation data
     m_base_rot_x = 0;
@@ -55,6 +59,7 @@ cGL_Surface::cGL_Surface(void)
     m_col_h = 0;
 
     m_auto_del_img = 1;
+    m_atlas = 0;
     m_managed = 0;
     m_obsolete = 0;
 
@@ -68,6 +73,11 @@ cGL_Surface::cGL_Surface(void)
 
 cGL_Surface::~cGL_Surface(void)
 {
+    // the render thread may still draw with the texture
+    if (m_auto_del_img && pVideo) {
+        pVideo->Render_Finish();
+    }
+
     // don't delete a managed OpenGL image if still in use by another managed cGL_Surface
     if (m_auto_del_img && glIsTexture(m_image) && (!m_managed || !Is_Texture_Use_Multiple())) {
         glDeleteTextures(1, &m_image);
@@ -93,6 +103,10 @@ cGL_Surface* cGL_Surface::Copy(void) const
     new_surface->m_h = m_h;
     new_surface->m_tex_h = m_tex_h;
     new_surface->m_tex_w = m_tex_w;
+    new_surface->m_tex_x1 = m_tex_x1;
+    new_surface->m_tex_y1 = m_tex_y1;
+    new_surface->m_tex_x2 = m_tex_x2;
+    new_surface->m_tex_y2 = m_tex_y2;
     new_surface->m_base_rot_x = m_base_rot_x;
     new_surface->m_base_rot_y = m_base_rot_y;
     new_surface->m_base_rot_z = m_base_rot_z;
@@ -101,6 +115,12 @@ cGL_Surface* cGL_Surface::Copy(void) const
     new_surface->m_col_h = m_col_h;
     new_surface->m_path = m_path;
 
+    // the atlas page is not owned by the surface
+    if (m_atlas) {
+        new_surface->m_atlas = 1;
+        new_surface->m_auto_del_img = 0;
+    }
+
     // settings
     new_surface->m_obsolete = m_obsolete;
     new_surface->m_editor_tags = m_editor_tags;
@@ -138,6 +158,10 @@ void cGL_Surface::Blit_Data(cSurface_Request* request) const
 {
     // texture id
     request->m_texture_id = m_image;
+    request->m_tex_x1 = m_tex_x1;
+    request->m_tex_y1 = m_tex_y1;
+    request->m_tex_x2 = m_tex_x2;
+    request->m_tex_y2 = m_tex_y2;
 
     // position
     request->m_pos_x += m_int_x;
@@ -160,15 +184,14 @@ void cGL_Surface::Save(const std::string& filename)
         return;
     }
 
-    // bind the texture
-    glBindTexture(GL_TEXTURE_2D, m_image);
+    pVideo->Render_Finish();
 
-    // create image data
-    GLubyte* data = new GLubyte[m_tex_w * m_tex_h * 4];
     // read texture
-    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, static_cast<GLvoid*>(data));
+    GLint width;
+    GLint height;
+    GLubyte* data = Read_Pixels(GL_RGBA, 4, width, height);
     // save
-    pVideo->Save_Surface(filename, data, m_tex_w, m_tex_h);
+    pVideo->Save_Surface(filename, data, width, height);
     // clear data
     delete[] data;
 }
@@ -201,12 +224,12 @@ cSaved_Texture* cGL_Surface::Get_Software_Texture(bool only_filename /* = 0 */)
 
     // hardware texture to software texture
     if (!only_filename) {
+        pVideo->Render_Finish();
+
         // bind the texture
         glBindTexture(GL_TEXTURE_2D, m_image);
 
         // texture settings
-        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &soft_tex->m_width);
-        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &soft_tex->m_height);
         glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &soft_tex->m_format);
 
         glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, &soft_tex->m_wrap_s);
@@ -227,10 +250,8 @@ cSaved_Texture* cGL_Surface::Get_Software_Texture(bool only_filename /* = 0 */)
             cerr << "Warning: cGL_Surface :: Get_Software_Texture : Unknown format" << endl;
         }
 
-        // texture data
-        soft_tex->m_pixels = new GLubyte[soft_tex->m_width * soft_tex->m_height * bpp];
-
-        glGetTexImage(GL_TEXTURE_2D, 0, soft_tex->m_format, GL_UNSIGNED_BYTE, soft_tex->m_pixels);
+        // texture data, the size is set by it
+        soft_tex->m_pixels = Read_Pixels(soft_tex->m_format, bpp, soft_tex->m_width, soft_tex->m_height);
     }
 
     // surface pointer
@@ -247,6 +268,8 @@ void cGL_Surface::Load_Software_Texture(cSaved_Texture* soft_tex)
 
     // software texture
     if (soft_tex->m_pixels) {
+        pVideo->Render_Finish();
+
         GLuint tex_id;
         glGenTextures(1, &tex_id);
 
@@ -269,6 +292,18 @@ void cGL_Surface::Load_Software_Texture(cSaved_Texture* soft_tex)
         pVideo->Create_GL_Texture(soft_tex->m_width, soft_tex->m_height, soft_tex->m_pixels, mipmaps);
 
         m_image = tex_id;
+
+        // the image of an atlas page was saved into a texture of its own
+        if (m_atlas) {
+            m_tex_w = soft_tex->m_width;
+            m_tex_h = soft_tex->m_height;
+            m_tex_x1 = 0.0f;
+            m_tex_y1 = 0.0f;
+            m_tex_x2 = 1.0f;
+            m_tex_y2 = 1.0f;
+            m_atlas = 0;
+            m_auto_del_img = 1;
+        }
     }
     // load from file
     else {
@@ -283,6 +318,13 @@ void cGL_Surface::Load_Software_Texture(cSaved_Texture* soft_tex)
         m_image = surface_copy->m_image;
         m_tex_w = surface_copy->m_tex_w;
         m_tex_h = surface_copy->m_tex_h;
+        m_tex_x1 = surface_copy->m_tex_x1;
+        m_tex_y1 = surface_copy->m_tex_y1;
+        m_tex_x2 = surface_copy->m_tex_x2;
+        m_tex_y2 = surface_copy->m_tex_y2;
+        // the image cache may have been recreated without this image on an atlas page
+        m_atlas = surface_copy->m_atlas;
+        m_auto_del_img = !m_atlas;
         // keep hardware texture
         surface_copy->m_auto_del_img = 0;
         // delete copy
@@ -290,6 +332,47 @@ void cGL_Surface::Load_Software_Texture(cSaved_Texture* soft_tex)
     }
 }
 
+GLubyte* cGL_Surface::Read_Pixels(GLenum format, unsigned int bpp, GLint& width, GLint& height) const
+{
+    // bind the texture
+    glBindTexture(GL_TEXTURE_2D, m_image);
+
+    GLint tex_w = 0;
+    GLint tex_h = 0;
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &tex_w);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &tex_h);
+
+    // the complete texture is read even if only a part of an atlas page is needed
+    GLubyte* data = new GLubyte[tex_w * tex_h * bpp];
+
+    // rows are not padded
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glGetTexImage(GL_TEXTURE_2D, 0, format, GL_UNSIGNED_BYTE, static_cast<GLvoid*>(data));
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    if (!m_atlas) {
+        width = tex_w;
+        height = tex_h;
+        return data;
+    }
+
+    // copy out the image part of the atlas page
+    const GLint x = static_cast<GLint>(m_tex_x1 * tex_w + 0.5f);
+    const GLint y = static_cast<GLint>(m_tex_y1 * tex_h + 0.5f);
+    width = static_cast<GLint>(m_tex_x2 * tex_w + 0.5f) - x;
+    height = static_cast<GLint>(m_tex_y2 * tex_h + 0.5f) - y;
+
+    GLubyte* image_data = new GLubyte[width * height * bpp];
+
+    for (GLint row = 0; row < height; row++) {
+        memcpy(image_data + (row * width * bpp), data + (((y + row) * tex_w + x) * bpp), width * bpp);
+    }
+
+    delete[] data;
+
+    return image_data;
+}
+
 fs::path cGL_Surface::Get_Path()
 {
     return m_path;
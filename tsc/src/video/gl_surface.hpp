@@ -75,6 +75,11 @@ namespace TSC {
         // texture dimension
         unsigned int m_tex_w;
         unsigned int m_tex_h;
+        // texture coordinates of the image, only a part of the texture if on an atlas page
+        float m_tex_x1;
+        float m_tex_y1;
+        float m_tex_x2;
+        float m_tex_y2;
         // internal rotation
         float m_base_rot_x;
         float m_base_rot_y;
@@ -88,6 +93,8 @@ namespace TSC {
         boost::filesystem::path m_path;
         // should the image be deleted
         bool m_auto_del_img;
+        // if the texture is an atlas page owned by the texture atlas
+        bool m_atlas;
         // if managed over the image manager
         bool m_managed;
         // if the image is tagged as obsolete
@@ -102,6 +109,12 @@ namespace TSC {
         // ground type
         GroundType m_ground_type;
     private:
+        /* Read the pixels of the image from the texture
+         * if on an atlas page only the part of the image is returned
+         * width and height are set to the size of the returned pixels
+        */
+        GLubyte* Read_Pixels(GLenum format, unsigned int bpp, GLint& width, GLint& height) const;
+
         // function called on destruction
         void (*destruction_function)(cGL_Surface*);
     };
@@ -16,6 +16,10 @@
 
 #include "../video/img_manager.hpp"
 #include "../video/renderer.hpp"
+#include "../video/video.hpp"
+#include "../video/texture_atlas.hpp"
+#include "../video/static_geometry.hpp"
+#include "../video/font.hpp"
 #include "../core/i18n.hpp"
 #include "../core/global_basic.hpp"
 
@@ -108,6 +112,10 @@ cGL_Surface* cImage_Manager::Copy(const fs::path& path)
 
 void cImage_Manager::Grab_Textures(bool from_file /* = 0 */, bool draw_gui /* = 0 */)
 {
+    pVideo->Render_Finish();
+    // glyph pages are created again when drawing text
+    pFont->Invalidate_Glyph_Pages();
+
     // progress bar
     CEGUI::ProgressBar* progress_bar = NULL;
 
@@ -127,6 +135,13 @@ void cImage_Manager::Grab_Textures(bool from_file /* = 0 */, bool draw_gui /* =
         // get surface
         cGL_Surface* obj = (*itr);
 
+        // atlas pages are shared and loaded again from the image cache
+        if (obj->m_atlas) {
+            m_saved_textures.push_back(obj->Get_Software_Texture(1));
+            loaded_files++;
+            continue;
+        }
+
         // skip surfaces with an already deleted texture
         if (!glIsTexture(obj->m_image)) {
             continue;
@@ -150,10 +165,15 @@ void cImage_Manager::Grab_Textures(bool from_file /* = 0 */, bool draw_gui /* =
             Loading_Screen_Draw();
         }
     }
+
+    // delete the atlas pages
+    pTexture_Atlas->Clear();
 }
 
 void cImage_Manager::Restore_Textures(bool draw_gui /* = 0 */)
 {
+    pVideo->Render_Finish();
+
     // progress bar
     CEGUI::ProgressBar* progress_bar = NULL;
 
@@ -191,10 +211,18 @@ void cImage_Manager::Restore_Textures(bool draw_gui /* = 0 */)
     }
 
     m_saved_textures.clear();
+
+    // the chunks still use the old textures and buffers
+    cStatic_Geometry::Invalidate_All();
 }
 
 void cImage_Manager::Delete_Image_Textures(void)
 {
+    // also called on exit after the video is deleted
+    if (pVideo) {
+        pVideo->Render_Finish();
+    }
+
     for (GL_Surface_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
         // get object
         cGL_Surface* obj = (*itr);
@@ -207,6 +235,8 @@ void cImage_Manager::Delete_Image_Textures(void)
 
 void cImage_Manager::Delete_Hardware_Textures(void)
 {
+    pVideo->Render_Finish();
+
     // delete all hardware surfaces
     for (GLuint i = 0; i < m_high_texture_id; i++) {
         if (glIsTexture(i)) {
@@ -15,6 +15,7 @@
 
 #include "../core/game_core.hpp"
 #include "../core/framerate.hpp"
+#include "../core/update_jobs.hpp"
 #include "../video/gl_surface.hpp"
 #include "../video/renderer.hpp"
 #include "../core/i18n.hpp"
@@ -140,6 +141,12 @@ cImageSet::Surface::~Surface(void)
 
 void cImageSet::Surface::Enter(void)
 {
+    // the rand() sequence has to stay the same in parallel updates
+    if (cUpdate_Jobs::Is_Recording()) {
+        cUpdate_Jobs::Defer(std::bind(&cImageSet::Surface::Enter, this));
+        return;
+    }
+
     // set random time for this frame
     m_time = m_info.m_time_min + rand() % (m_info.m_time_max - m_info.m_time_min + 1);
 }
@@ -396,6 +403,41 @@ void cImageSet::Update_Animation(void)
     return;
 }
 
+bool cImageSet::Has_Animation_Branches(void) const
+{
+    for (Surface_List::const_iterator itr = m_images.begin(); itr != m_images.end(); ++itr) {
+        if (!itr->m_info.m_branches.empty()) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+bool cImageSet::Has_Constant_Collision_Rect(void) const
+{
+    const cGL_Surface* first = NULL;
+
+    for (Surface_List::const_iterator itr = m_images.begin(); itr != m_images.end(); ++itr) {
+        const cGL_Surface* image = itr->m_image;
+
+        if (!image) {
+            continue;
+        }
+
+        if (!first) {
+            first = image;
+            continue;
+        }
+
+        if (image->m_col_pos.m_x != first->m_col_pos.m_x || image->m_col_pos.m_y != first->m_col_pos.m_y || image->m_col_w != first->m_col_w || image->m_col_h != first->m_col_h) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
 void cImageSet::Set_Time_All(const uint32_t time, const bool default_time /* = 0 */)
 {
     for (Surface_List::iterator itr = m_images.begin(); itr != m_images.end(); ++itr) {
@@ -126,6 +126,10 @@ namespace TSC {
 
         // update animation, return true on image change
         void Update_Animation(void);
+        // if any image randomly branches to another image when left
+        bool Has_Animation_Branches(void) const;
+        // if all images have the same collision rect so changing the image never moves the sprite
+        bool Has_Constant_Collision_Rect(void) const;
 
         // Set default image display time
         inline void Set_Default_Time(const uint32_t time = 1000)
@@ -0,0 +1,132 @@
+/***************************************************************************
+ * particle_budget.cpp  -  Global particle limit and quality scheduling
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/particle_budget.hpp"
+#include "../core/game_core.hpp"
+#include "../user/preferences.hpp"
+
+namespace TSC {
+
+/* *** *** *** *** *** *** cParticle_Budget *** *** *** *** *** *** *** *** *** *** *** */
+
+const float cParticle_Budget::m_min_quality = 0.1f;
+
+cParticle_Budget::cParticle_Budget(void)
+{
+    m_live = 0;
+
+    for (unsigned int i = 0; i <= PARTICLE_PRIORITY_HIGH; i++) {
+        m_dropped[i] = 0;
+    }
+
+    m_quality = 1.0f;
+    m_frame_time = 0.0f;
+    m_frame_start = 0;
+}
+
+cParticle_Budget::~cParticle_Budget(void)
+{
+
+}
+
+void cParticle_Budget::Begin_Frame(void)
+{
+    m_frame_start = TSC_GetTicks();
+}
+
+void cParticle_Budget::End_Frame(void)
+{
+    const float ticks = static_cast<float>(TSC_GetTicks() - m_frame_start);
+
+    // the ticks are whole milliseconds so they are smoothed over some frames
+    m_frame_time += (ticks - m_frame_time) * 0.1f;
+
+    // lower fast
+    if (m_frame_time > m_frame_budget) {
+        m_quality -= 0.02f;
+
+        if (m_quality < m_min_quality) {
+            m_quality = m_min_quality;
+        }
+    }
+    // raise slowly with some room to not alternate
+    else if (m_frame_time < m_frame_budget * 0.75f) {
+        m_quality += 0.005f;
+
+        if (m_quality > 1.0f) {
+            m_quality = 1.0f;
+        }
+    }
+}
+
+unsigned int cParticle_Budget::Request(unsigned int quota, ParticlePriority priority, float& remainder)
+{
+    if (quota == 0) {
+        return 0;
+    }
+
+    const float wanted = (quota * Get_Scale(priority)) + remainder;
+    unsigned int count = static_cast<unsigned int>(wanted);
+
+    if (count > quota) {
+        count = quota;
+    }
+
+    remainder = wanted - count;
+
+    // particle limit
+    const unsigned int limit = pPreferences->m_video_particle_limit;
+
+    if (limit > 0 && priority != PARTICLE_PRIORITY_HIGH && m_live + count > limit) {
+        count = (m_live < limit) ? limit - m_live : 0;
+        // don't catch up once below the limit again
+        remainder = 0.0f;
+    }
+
+    m_dropped[priority] += quota - count;
+    m_live += count;
+
+    return count;
+}
+
+void cParticle_Budget::Release(unsigned int count)
+{
+    if (count > m_live) {
+        m_live = 0;
+        return;
+    }
+
+    m_live -= count;
+}
+
+float cParticle_Budget::Get_Scale(ParticlePriority priority) const
+{
+    if (priority == PARTICLE_PRIORITY_LOW) {
+        return m_quality;
+    }
+    else if (priority == PARTICLE_PRIORITY_NORMAL) {
+        return 0.5f + (m_quality * 0.5f);
+    }
+
+    return 1.0f;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+cParticle_Budget* pParticle_Budget = NULL;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
@@ -0,0 +1,110 @@
+/***************************************************************************
+ * particle_budget.h  -  Global particle limit and quality scheduling
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_PARTICLE_BUDGET_HPP
+#define TSC_PARTICLE_BUDGET_HPP
+
+#include "../core/global_basic.hpp"
+#include "../core/global_game.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** Particle priority *** *** *** *** *** *** *** *** *** *** */
+
+    enum ParticlePriority {
+        // decoration like level emitters and feet clouds, reduced first
+        PARTICLE_PRIORITY_LOW = 0,
+        // effects of actions like hits and explosions
+        PARTICLE_PRIORITY_NORMAL = 1,
+        // never reduced or limited
+        PARTICLE_PRIORITY_HIGH = 2
+    };
+
+    /* *** *** *** *** *** cParticle_Budget *** *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Counts the live particles of all emitters and decides how many
+     * particles an emission may add.
+     * The quality goes down while the update and draw time of the frames
+     * is above the frame budget and slowly up again below it. It scales
+     * the quota of low priority emitters fully and of normal priority
+     * emitters halfway. Scaled emissions carry their fraction over to the
+     * next one, so emitters with a quota of 1 emit less often instead of
+     * not at all. Above the particle limit preference only high priority
+     * emitters can add particles.
+     */
+    class cParticle_Budget {
+    public:
+        cParticle_Budget(void);
+        ~cParticle_Budget(void);
+
+        // Start measuring the update and draw time of a frame
+        void Begin_Frame(void);
+        // Stop measuring and adapt the quality to the measured time
+        void End_Frame(void);
+
+        /* Return how many particles of the quota may be emitted and count them as live
+         * remainder : fraction of a particle the emitter carries to its next emission
+        */
+        unsigned int Request(unsigned int quota, ParticlePriority priority, float& remainder);
+        // Count finished particles
+        void Release(unsigned int count);
+
+        // Return the live particles of all emitters
+        inline unsigned int Get_Live_Count(void) const
+        {
+            return m_live;
+        }
+        // Return the particles of the priority not emitted because of the budget
+        inline unsigned long Get_Dropped_Count(ParticlePriority priority) const
+        {
+            return m_dropped[priority];
+        }
+        // Return the quality from m_min_quality to 1
+        inline float Get_Quality(void) const
+        {
+            return m_quality;
+        }
+
+        // update and draw time budget of a frame in milliseconds
+        static const uint32_t m_frame_budget = 12;
+        // lowest quality
+        static const float m_min_quality;
+
+    private:
+        // Return the factor for the quota of the priority
+        float Get_Scale(ParticlePriority priority) const;
+
+        // live particles
+        unsigned int m_live;
+        // dropped particles per priority
+        unsigned long m_dropped[PARTICLE_PRIORITY_HIGH + 1];
+        // current quality
+        float m_quality;
+        // smoothed update and draw time in milliseconds
+        float m_frame_time;
+        // ticks at the start of the frame
+        uint32_t m_frame_start;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// Particle budget
+    extern cParticle_Budget* pParticle_Budget;
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
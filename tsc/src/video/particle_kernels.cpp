@@ -0,0 +1,507 @@
+/***************************************************************************
+ * particle_kernels.cpp  -  Vectorized particle update and clipping
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/particle_kernels.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define TSC_PARTICLE_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace TSC {
+
+/* *** *** *** *** *** *** Particle kernel helpers *** *** *** *** *** *** *** *** *** *** *** */
+
+// array pointers of a particle list
+struct Particle_Arrays {
+    float* pos_x;
+    float* pos_y;
+    float* vel_x;
+    float* vel_y;
+    float* gravity_x;
+    float* gravity_y;
+    float* rot_x;
+    float* rot_y;
+    float* rot_z;
+    float* const_rot_x;
+    float* const_rot_y;
+    float* const_rot_z;
+    float* scale;
+    float* time_to_live;
+    float* fade_pos;
+};
+
+// must not be called with an empty list
+static Particle_Arrays Get_Particle_Arrays(cParticle_List& particles)
+{
+    Particle_Arrays arrays;
+
+    arrays.pos_x = &particles.m_pos_x[0];
+    arrays.pos_y = &particles.m_pos_y[0];
+    arrays.vel_x = &particles.m_vel_x[0];
+    arrays.vel_y = &particles.m_vel_y[0];
+    arrays.gravity_x = &particles.m_gravity_x[0];
+    arrays.gravity_y = &particles.m_gravity_y[0];
+    arrays.rot_x = &particles.m_rot_x[0];
+    arrays.rot_y = &particles.m_rot_y[0];
+    arrays.rot_z = &particles.m_rot_z[0];
+    arrays.const_rot_x = &particles.m_const_rot_x[0];
+    arrays.const_rot_y = &particles.m_const_rot_y[0];
+    arrays.const_rot_z = &particles.m_const_rot_z[0];
+    arrays.scale = &particles.m_scale[0];
+    arrays.time_to_live = &particles.m_time_to_live[0];
+    arrays.fade_pos = &particles.m_fade_pos[0];
+
+    return arrays;
+}
+
+// clip rectangle and image settings shared by all particles
+struct Particle_Clip_Settings {
+    float left;
+    float top;
+    float right;
+    float bottom;
+    float w;
+    float h;
+    float image_w;
+    float image_h;
+    bool fade_size;
+    ParticleClipMode mode;
+};
+
+/* *** *** *** *** *** *** Scalar kernels *** *** *** *** *** *** *** *** *** *** *** */
+
+/* Wrap the rotation like cSprite::Set_Rotation_Z() with fmod(rot, 360)
+ * fmod is only needed for a full turn or more
+*/
+static inline float Wrap_Rotation(float rot)
+{
+    return (fabs(rot) >= 360.0f) ? (fmod(rot, 360.0f)) : (rot);
+}
+
+static unsigned int Integrate_Scalar(const Particle_Arrays& p, size_t first, size_t last, float speed_factor, float fade_step)
+{
+    unsigned int finished = 0;
+
+    for (size_t i = first; i < last; i++) {
+        // update fade modifier
+        p.fade_pos[i] -= fade_step / p.time_to_live[i];
+
+        if (p.fade_pos[i] <= 0.0f) {
+            finished++;
+        }
+
+        // move
+        p.pos_x[i] += p.vel_x[i] * speed_factor;
+        p.pos_y[i] += p.vel_y[i] * speed_factor;
+        // todo : gravity maximum
+        p.vel_x[i] += p.gravity_x[i] * speed_factor;
+        p.vel_y[i] += p.gravity_y[i] * speed_factor;
+
+        // constant rotation
+        p.rot_x[i] = Wrap_Rotation(p.rot_x[i] + p.const_rot_x[i] * speed_factor);
+        p.rot_y[i] = Wrap_Rotation(p.rot_y[i] + p.const_rot_y[i] * speed_factor);
+        p.rot_z[i] = Wrap_Rotation(p.rot_z[i] + p.const_rot_z[i] * speed_factor);
+    }
+
+    return finished;
+}
+
+static void Clip_Scalar(const Particle_Arrays& p, size_t first, size_t last, const Particle_Clip_Settings& clip)
+{
+    for (size_t i = first; i < last; i++) {
+        float scale = p.scale[i];
+
+        // with size fading
+        if (clip.fade_size) {
+            scale *= p.fade_pos[i];
+        }
+
+        // scaling is centered
+        const float rect_x = p.pos_x[i] - ((clip.image_w * 0.5f) * (scale - 1.0f));
+        const float rect_y = p.pos_y[i] - ((clip.image_h * 0.5f) * (scale - 1.0f));
+        const float rect_w = clip.image_w * scale;
+        const float rect_h = clip.image_h * scale;
+
+        // out in left
+        if (rect_x + rect_w < clip.left) {
+            if (clip.mode == PCM_MOVE) {
+                p.pos_x[i] += (clip.w - 1.0f) + rect_w;
+            }
+            else if (clip.mode == PCM_REVERSE) {
+                p.vel_x[i] = fabs(p.vel_x[i]);
+            }
+            else if (clip.mode == PCM_DELETE) {
+                p.fade_pos[i] = 0.0f;
+            }
+        }
+        // out in right
+        else if (rect_x > clip.right) {
+            if (clip.mode == PCM_MOVE) {
+                p.pos_x[i] -= (clip.w - 1.0f) + rect_w;
+            }
+            else if (clip.mode == PCM_REVERSE) {
+                p.vel_x[i] = -fabs(p.vel_x[i]);
+            }
+            else if (clip.mode == PCM_DELETE) {
+                p.fade_pos[i] = 0.0f;
+            }
+        }
+        // out on top
+        else if (rect_y + rect_h < clip.top) {
+            if (clip.mode == PCM_MOVE) {
+                p.pos_y[i] += (clip.h - 1.0f) + rect_h;
+            }
+            else if (clip.mode == PCM_REVERSE) {
+                p.vel_y[i] = fabs(p.vel_y[i]);
+            }
+            else if (clip.mode == PCM_DELETE) {
+                p.fade_pos[i] = 0.0f;
+            }
+        }
+        // out on bottom
+        else if (rect_y > clip.bottom) {
+            if (clip.mode == PCM_MOVE) {
+                p.pos_y[i] -= (clip.h - 1.0f) + rect_h;
+            }
+            else if (clip.mode == PCM_REVERSE) {
+                p.vel_y[i] = -fabs(p.vel_y[i]);
+            }
+            else if (clip.mode == PCM_DELETE) {
+                p.fade_pos[i] = 0.0f;
+            }
+        }
+    }
+}
+
+#ifdef TSC_PARTICLE_KERNELS_X86
+
+/* *** *** *** *** *** *** SSE2 kernels *** *** *** *** *** *** *** *** *** *** *** */
+
+// Return a where mask is set and b otherwise
+static inline __m128 Select_SSE2(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Store the rotations and wrap them with Wrap_Rotation() if any is a full turn or more
+static inline void Store_Rotations_SSE2(float* dest, __m128 rot)
+{
+    _mm_storeu_ps(dest, rot);
+
+    if (_mm_movemask_ps(_mm_cmpge_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), rot), _mm_set1_ps(360.0f)))) {
+        for (unsigned int j = 0; j < 4; j++) {
+            dest[j] = Wrap_Rotation(dest[j]);
+        }
+    }
+}
+
+static unsigned int Integrate_SSE2(const Particle_Arrays& p, size_t count, float speed_factor, float fade_step)
+{
+    const __m128 speed = _mm_set1_ps(speed_factor);
+    const __m128 step = _mm_set1_ps(fade_step);
+    const __m128 zero = _mm_setzero_ps();
+    unsigned int finished = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 fade = _mm_sub_ps(_mm_loadu_ps(p.fade_pos + i), _mm_div_ps(step, _mm_loadu_ps(p.time_to_live + i)));
+        _mm_storeu_ps(p.fade_pos + i, fade);
+        finished += __builtin_popcount(_mm_movemask_ps(_mm_cmple_ps(fade, zero)));
+
+        const __m128 vel_x = _mm_loadu_ps(p.vel_x + i);
+        const __m128 vel_y = _mm_loadu_ps(p.vel_y + i);
+        _mm_storeu_ps(p.pos_x + i, _mm_add_ps(_mm_loadu_ps(p.pos_x + i), _mm_mul_ps(vel_x, speed)));
+        _mm_storeu_ps(p.pos_y + i, _mm_add_ps(_mm_loadu_ps(p.pos_y + i), _mm_mul_ps(vel_y, speed)));
+        _mm_storeu_ps(p.vel_x + i, _mm_add_ps(vel_x, _mm_mul_ps(_mm_loadu_ps(p.gravity_x + i), speed)));
+        _mm_storeu_ps(p.vel_y + i, _mm_add_ps(vel_y, _mm_mul_ps(_mm_loadu_ps(p.gravity_y + i), speed)));
+
+        Store_Rotations_SSE2(p.rot_x + i, _mm_add_ps(_mm_loadu_ps(p.rot_x + i), _mm_mul_ps(_mm_loadu_ps(p.const_rot_x + i), speed)));
+        Store_Rotations_SSE2(p.rot_y + i, _mm_add_ps(_mm_loadu_ps(p.rot_y + i), _mm_mul_ps(_mm_loadu_ps(p.const_rot_y + i), speed)));
+        Store_Rotations_SSE2(p.rot_z + i, _mm_add_ps(_mm_loadu_ps(p.rot_z + i), _mm_mul_ps(_mm_loadu_ps(p.const_rot_z + i), speed)));
+    }
+
+    return finished + Integrate_Scalar(p, i, count, speed_factor, fade_step);
+}
+
+static void Clip_SSE2(const Particle_Arrays& p, size_t count, const Particle_Clip_Settings& clip)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 half_w = _mm_set1_ps(clip.image_w * 0.5f);
+    const __m128 half_h = _mm_set1_ps(clip.image_h * 0.5f);
+    const __m128 image_w = _mm_set1_ps(clip.image_w);
+    const __m128 image_h = _mm_set1_ps(clip.image_h);
+    const __m128 left = _mm_set1_ps(clip.left);
+    const __m128 top = _mm_set1_ps(clip.top);
+    const __m128 right = _mm_set1_ps(clip.right);
+    const __m128 bottom = _mm_set1_ps(clip.bottom);
+    const __m128 move_w = _mm_set1_ps(clip.w - 1.0f);
+    const __m128 move_h = _mm_set1_ps(clip.h - 1.0f);
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 pos_x = _mm_loadu_ps(p.pos_x + i);
+        const __m128 pos_y = _mm_loadu_ps(p.pos_y + i);
+        __m128 scale = _mm_loadu_ps(p.scale + i);
+
+        // with size fading
+        if (clip.fade_size) {
+            scale = _mm_mul_ps(scale, _mm_loadu_ps(p.fade_pos + i));
+        }
+
+        // scaling is centered
+        const __m128 scale_diff = _mm_sub_ps(scale, one);
+        const __m128 rect_x = _mm_sub_ps(pos_x, _mm_mul_ps(half_w, scale_diff));
+        const __m128 rect_y = _mm_sub_ps(pos_y, _mm_mul_ps(half_h, scale_diff));
+        const __m128 rect_w = _mm_mul_ps(image_w, scale);
+        const __m128 rect_h = _mm_mul_ps(image_h, scale);
+
+        // the sides are checked in the same order as the scalar version
+        const __m128 out_left = _mm_cmplt_ps(_mm_add_ps(rect_x, rect_w), left);
+        const __m128 out_right = _mm_andnot_ps(out_left, _mm_cmpgt_ps(rect_x, right));
+        const __m128 out_hor = _mm_or_ps(out_left, out_right);
+        const __m128 out_top = _mm_andnot_ps(out_hor, _mm_cmplt_ps(_mm_add_ps(rect_y, rect_h), top));
+        const __m128 out_bottom = _mm_andnot_ps(_mm_or_ps(out_hor, out_top), _mm_cmpgt_ps(rect_y, bottom));
+
+        if (clip.mode == PCM_MOVE) {
+            const __m128 move_x = _mm_add_ps(move_w, rect_w);
+            const __m128 move_y = _mm_add_ps(move_h, rect_h);
+            _mm_storeu_ps(p.pos_x + i, _mm_sub_ps(_mm_add_ps(pos_x, _mm_and_ps(out_left, move_x)), _mm_and_ps(out_right, move_x)));
+            _mm_storeu_ps(p.pos_y + i, _mm_sub_ps(_mm_add_ps(pos_y, _mm_and_ps(out_top, move_y)), _mm_and_ps(out_bottom, move_y)));
+        }
+        else if (clip.mode == PCM_REVERSE) {
+            const __m128 vel_x = _mm_loadu_ps(p.vel_x + i);
+            const __m128 vel_y = _mm_loadu_ps(p.vel_y + i);
+            const __m128 abs_x = _mm_andnot_ps(sign, vel_x);
+            const __m128 abs_y = _mm_andnot_ps(sign, vel_y);
+            _mm_storeu_ps(p.vel_x + i, Select_SSE2(out_left, abs_x, Select_SSE2(out_right, _mm_or_ps(sign, abs_x), vel_x)));
+            _mm_storeu_ps(p.vel_y + i, Select_SSE2(out_top, abs_y, Select_SSE2(out_bottom, _mm_or_ps(sign, abs_y), vel_y)));
+        }
+        else if (clip.mode == PCM_DELETE) {
+            const __m128 out = _mm_or_ps(_mm_or_ps(out_hor, out_top), out_bottom);
+            _mm_storeu_ps(p.fade_pos + i, _mm_andnot_ps(out, _mm_loadu_ps(p.fade_pos + i)));
+        }
+    }
+
+    Clip_Scalar(p, i, count, clip);
+}
+
+/* *** *** *** *** *** *** AVX2 kernels *** *** *** *** *** *** *** *** *** *** *** */
+
+__attribute__((target("avx2"))) static inline __m256 Select_AVX2(__m256 mask, __m256 a, __m256 b)
+{
+    return _mm256_blendv_ps(b, a, mask);
+}
+
+// Store the rotations and wrap them with Wrap_Rotation() if any is a full turn or more
+__attribute__((target("avx2"))) static inline void Store_Rotations_AVX2(float* dest, __m256 rot)
+{
+    _mm256_storeu_ps(dest, rot);
+
+    if (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), rot), _mm256_set1_ps(360.0f), _CMP_GE_OQ))) {
+        for (unsigned int j = 0; j < 8; j++) {
+            dest[j] = Wrap_Rotation(dest[j]);
+        }
+    }
+}
+
+__attribute__((target("avx2"))) static unsigned int Integrate_AVX2(const Particle_Arrays& p, size_t count, float speed_factor, float fade_step)
+{
+    const __m256 speed = _mm256_set1_ps(speed_factor);
+    const __m256 step = _mm256_set1_ps(fade_step);
+    const __m256 zero = _mm256_setzero_ps();
+    unsigned int finished = 0;
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        const __m256 fade = _mm256_sub_ps(_mm256_loadu_ps(p.fade_pos + i), _mm256_div_ps(step, _mm256_loadu_ps(p.time_to_live + i)));
+        _mm256_storeu_ps(p.fade_pos + i, fade);
+        finished += __builtin_popcount(_mm256_movemask_ps(_mm256_cmp_ps(fade, zero, _CMP_LE_OQ)));
+
+        const __m256 vel_x = _mm256_loadu_ps(p.vel_x + i);
+        const __m256 vel_y = _mm256_loadu_ps(p.vel_y + i);
+        _mm256_storeu_ps(p.pos_x + i, _mm256_add_ps(_mm256_loadu_ps(p.pos_x + i), _mm256_mul_ps(vel_x, speed)));
+        _mm256_storeu_ps(p.pos_y + i, _mm256_add_ps(_mm256_loadu_ps(p.pos_y + i), _mm256_mul_ps(vel_y, speed)));
+        _mm256_storeu_ps(p.vel_x + i, _mm256_add_ps(vel_x, _mm256_mul_ps(_mm256_loadu_ps(p.gravity_x + i), speed)));
+        _mm256_storeu_ps(p.vel_y + i, _mm256_add_ps(vel_y, _mm256_mul_ps(_mm256_loadu_ps(p.gravity_y + i), speed)));
+
+        Store_Rotations_AVX2(p.rot_x + i, _mm256_add_ps(_mm256_loadu_ps(p.rot_x + i), _mm256_mul_ps(_mm256_loadu_ps(p.const_rot_x + i), speed)));
+        Store_Rotations_AVX2(p.rot_y + i, _mm256_add_ps(_mm256_loadu_ps(p.rot_y + i), _mm256_mul_ps(_mm256_loadu_ps(p.const_rot_y + i), speed)));
+        Store_Rotations_AVX2(p.rot_z + i, _mm256_add_ps(_mm256_loadu_ps(p.rot_z + i), _mm256_mul_ps(_mm256_loadu_ps(p.const_rot_z + i), speed)));
+    }
+
+    return finished + Integrate_Scalar(p, i, count, speed_factor, fade_step);
+}
+
+__attribute__((target("avx2"))) static void Clip_AVX2(const Particle_Arrays& p, size_t count, const Particle_Clip_Settings& clip)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 half_w = _mm256_set1_ps(clip.image_w * 0.5f);
+    const __m256 half_h = _mm256_set1_ps(clip.image_h * 0.5f);
+    const __m256 image_w = _mm256_set1_ps(clip.image_w);
+    const __m256 image_h = _mm256_set1_ps(clip.image_h);
+    const __m256 left = _mm256_set1_ps(clip.left);
+    const __m256 top = _mm256_set1_ps(clip.top);
+    const __m256 right = _mm256_set1_ps(clip.right);
+    const __m256 bottom = _mm256_set1_ps(clip.bottom);
+    const __m256 move_w = _mm256_set1_ps(clip.w - 1.0f);
+    const __m256 move_h = _mm256_set1_ps(clip.h - 1.0f);
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        const __m256 pos_x = _mm256_loadu_ps(p.pos_x + i);
+        const __m256 pos_y = _mm256_loadu_ps(p.pos_y + i);
+        __m256 scale = _mm256_loadu_ps(p.scale + i);
+
+        // with size fading
+        if (clip.fade_size) {
+            scale = _mm256_mul_ps(scale, _mm256_loadu_ps(p.fade_pos + i));
+        }
+
+        // scaling is centered
+        const __m256 scale_diff = _mm256_sub_ps(scale, one);
+        const __m256 rect_x = _mm256_sub_ps(pos_x, _mm256_mul_ps(half_w, scale_diff));
+        const __m256 rect_y = _mm256_sub_ps(pos_y, _mm256_mul_ps(half_h, scale_diff));
+        const __m256 rect_w = _mm256_mul_ps(image_w, scale);
+        const __m256 rect_h = _mm256_mul_ps(image_h, scale);
+
+        // the sides are checked in the same order as the scalar version
+        const __m256 out_left = _mm256_cmp_ps(_mm256_add_ps(rect_x, rect_w), left, _CMP_LT_OQ);
+        const __m256 out_right = _mm256_andnot_ps(out_left, _mm256_cmp_ps(rect_x, right, _CMP_GT_OQ));
+        const __m256 out_hor = _mm256_or_ps(out_left, out_right);
+        const __m256 out_top = _mm256_andnot_ps(out_hor, _mm256_cmp_ps(_mm256_add_ps(rect_y, rect_h), top, _CMP_LT_OQ));
+        const __m256 out_bottom = _mm256_andnot_ps(_mm256_or_ps(out_hor, out_top), _mm256_cmp_ps(rect_y, bottom, _CMP_GT_OQ));
+
+        if (clip.mode == PCM_MOVE) {
+            const __m256 move_x = _mm256_add_ps(move_w, rect_w);
+            const __m256 move_y = _mm256_add_ps(move_h, rect_h);
+            _mm256_storeu_ps(p.pos_x + i, _mm256_sub_ps(_mm256_add_ps(pos_x, _mm256_and_ps(out_left, move_x)), _mm256_and_ps(out_right, move_x)));
+            _mm256_storeu_ps(p.pos_y + i, _mm256_sub_ps(_mm256_add_ps(pos_y, _mm256_and_ps(out_top, move_y)), _mm256_and_ps(out_bottom, move_y)));
+        }
+        else if (clip.mode == PCM_REVERSE) {
+            const __m256 vel_x = _mm256_loadu_ps(p.vel_x + i);
+            const __m256 vel_y = _mm256_loadu_ps(p.vel_y + i);
+            const __m256 abs_x = _mm256_andnot_ps(sign, vel_x);
+            const __m256 abs_y = _mm256_andnot_ps(sign, vel_y);
+            _mm256_storeu_ps(p.vel_x + i, Select_AVX2(out_left, abs_x, Select_AVX2(out_right, _mm256_or_ps(sign, abs_x), vel_x)));
+            _mm256_storeu_ps(p.vel_y + i, Select_AVX2(out_top, abs_y, Select_AVX2(out_bottom, _mm256_or_ps(sign, abs_y), vel_y)));
+        }
+        else if (clip.mode == PCM_DELETE) {
+            const __m256 out = _mm256_or_ps(_mm256_or_ps(out_hor, out_top), out_bottom);
+            _mm256_storeu_ps(p.fade_pos + i, _mm256_andnot_ps(out, _mm256_loadu_ps(p.fade_pos + i)));
+        }
+    }
+
+    Clip_Scalar(p, i, count, clip);
+}
+
+#endif
+
+/* *** *** *** *** *** *** Kernel selection *** *** *** *** *** *** *** *** *** *** *** */
+
+#ifndef TSC_PARTICLE_KERNELS_X86
+static unsigned int Integrate_Fallback(const Particle_Arrays& p, size_t count, float speed_factor, float fade_step)
+{
+    return Integrate_Scalar(p, 0, count, speed_factor, fade_step);
+}
+
+static void Clip_Fallback(const Particle_Arrays& p, size_t count, const Particle_Clip_Settings& clip)
+{
+    Clip_Scalar(p, 0, count, clip);
+}
+#endif
+
+struct Particle_Kernels {
+    unsigned int (*integrate)(const Particle_Arrays& p, size_t count, float speed_factor, float fade_step);
+    void (*clip)(const Particle_Arrays& p, size_t count, const Particle_Clip_Settings& clip);
+    const char* name;
+};
+
+static Particle_Kernels Select_Particle_Kernels(void)
+{
+    Particle_Kernels kernels;
+
+#ifdef TSC_PARTICLE_KERNELS_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.integrate = Integrate_AVX2;
+        kernels.clip = Clip_AVX2;
+        kernels.name = "AVX2";
+        return kernels;
+    }
+
+    // always available with SSE2 enabled at compile time
+    kernels.integrate = Integrate_SSE2;
+    kernels.clip = Clip_SSE2;
+    kernels.name = "SSE2";
+#else
+    kernels.integrate = Integrate_Fallback;
+    kernels.clip = Clip_Fallback;
+    kernels.name = "scalar";
+#endif
+
+    return kernels;
+}
+
+// selected once and thread safe as emitters may be updated in parallel
+static const Particle_Kernels& Get_Particle_Kernels(void)
+{
+    static const Particle_Kernels kernels = Select_Particle_Kernels();
+    return kernels;
+}
+
+/* *** *** *** *** *** *** Particle kernels *** *** *** *** *** *** *** *** *** *** *** */
+
+unsigned int Particle_Integrate(cParticle_List& particles, float speed_factor, float fade_step)
+{
+    if (particles.Empty()) {
+        return 0;
+    }
+
+    return Get_Particle_Kernels().integrate(Get_Particle_Arrays(particles), particles.Size(), speed_factor, fade_step);
+}
+
+void Particle_Clip(cParticle_List& particles, const GL_rect& clip_rect, ParticleClipMode mode, float image_w, float image_h, bool fade_size)
+{
+    if (particles.Empty()) {
+        return;
+    }
+
+    Particle_Clip_Settings clip;
+    clip.left = clip_rect.m_x;
+    clip.top = clip_rect.m_y;
+    clip.right = clip_rect.m_x + clip_rect.m_w;
+    clip.bottom = clip_rect.m_y + clip_rect.m_h;
+    clip.w = clip_rect.m_w;
+    clip.h = clip_rect.m_h;
+    clip.image_w = image_w;
+    clip.image_h = image_h;
+    clip.fade_size = fade_size;
+    clip.mode = mode;
+
+    Get_Particle_Kernels().clip(Get_Particle_Arrays(particles), particles.Size(), clip);
+}
+
+const char* Get_Particle_Kernel_Name(void)
+{
+    return Get_Particle_Kernels().name;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
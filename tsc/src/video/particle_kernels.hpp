@@ -0,0 +1,51 @@
+/***************************************************************************
+ * particle_kernels.h  -  Vectorized particle update and clipping
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_PARTICLE_KERNELS_HPP
+#define TSC_PARTICLE_KERNELS_HPP
+
+#include "../video/animation.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** Particle kernels *** *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* These work on all particles of a cParticle_List at once.
+     * The AVX2 or SSE2 version is chosen on first use depending on the
+     * processor and the particles left over after the last full vector
+     * are handled by the scalar version, which is also the fallback.
+     * All versions give the same results.
+     */
+
+    /* Fade, move, accelerate and rotate the particles
+     * particles with a fading position of 0 or less are finished and left in place
+     * returns the number of finished particles
+    */
+    unsigned int Particle_Integrate(cParticle_List& particles, float speed_factor, float fade_step);
+    /* Keep the particles in the given rectangle
+     * image_w/image_h : unscaled particle image size
+     * fade_size : if the scale is faded
+     * deleted particles get a fading position of 0
+    */
+    void Particle_Clip(cParticle_List& particles, const GL_rect& clip_rect, ParticleClipMode mode, float image_w, float image_h, bool fade_size);
+
+    // Return the name of the instruction set used by the particle kernels
+    const char* Get_Particle_Kernel_Name(void);
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
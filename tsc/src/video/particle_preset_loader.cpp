@@ -0,0 +1,112 @@
+/***************************************************************************
+ * particle_preset_loader.cpp - Loading particle preset XML
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "particle_preset_loader.hpp"
+#include "../core/global_basic.hpp"
+
+namespace fs = boost::filesystem;
+using namespace TSC;
+
+using namespace std;
+
+cParticlePresetLoader::cParticlePresetLoader()
+    : xmlpp::SaxParser()
+{
+    //
+}
+
+cParticlePresetLoader::~cParticlePresetLoader()
+{
+    // Do not delete the presets — they are used and
+    // deleted by the caller.
+    m_presets.clear();
+}
+
+vector<cParticle_Preset*>& cParticlePresetLoader::Get_Presets()
+{
+    return m_presets;
+}
+
+/***************************************
+ * SAX parser callbacks
+ ***************************************/
+
+void cParticlePresetLoader::parse_file(boost::filesystem::path filename)
+{
+    m_presetfile = filename;
+    xmlpp::SaxParser::parse_file(path_to_utf8(filename));
+}
+
+void cParticlePresetLoader::on_start_document()
+{
+    if (!m_presets.empty())
+        throw(RestartedXmlParserError());
+}
+
+void cParticlePresetLoader::on_end_document()
+{
+    //
+}
+
+void cParticlePresetLoader::on_start_element(const Glib::ustring& name, const xmlpp::SaxParser::AttributeList& properties)
+{
+    if (name == "property") {
+        std::string key;
+        std::string value;
+
+        /* Collect all the <property> elements for the surrounding
+         * <preset> element. When it is closed, the results are
+         * handled in on_end_element(). */
+        for (xmlpp::SaxParser::AttributeList::const_iterator iter = properties.begin(); iter != properties.end(); iter++) {
+            xmlpp::SaxParser::Attribute attr = *iter;
+
+            if (attr.name == "name")
+                key = attr.value;
+            else if (attr.name == "value")
+                value = attr.value;
+        }
+
+        m_current_properties[key] = value;
+    }
+}
+
+void cParticlePresetLoader::on_end_element(const Glib::ustring& name)
+{
+    // <property> tags are parsed cumulatively in on_start_element()
+    // so all have been collected when the surrounding element
+    // terminates here.
+    if (name == "property")
+        return;
+
+    if (name == "preset")
+        Handle_Preset();
+    else if (name == "particle_presets") {
+        /* Ignore */
+    }
+    else
+        cerr << "Warning: Particle preset unknown element '" << name << "'." << endl;
+
+    m_current_properties.clear();
+}
+
+void cParticlePresetLoader::Handle_Preset()
+{
+    if (m_current_properties["name"].empty()) {
+        cerr << "Warning: Particle preset without name in " << path_to_utf8(m_presetfile) << endl;
+        return;
+    }
+
+    m_presets.push_back(new cParticle_Preset(m_current_properties));
+}
@@ -0,0 +1,51 @@
+/***************************************************************************
+ * particle_preset_loader.hpp - Loading particle preset XML
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_PARTICLE_PRESET_LOADER_HPP
+#define TSC_PARTICLE_PRESET_LOADER_HPP
+#include "../core/global_game.hpp"
+#include "../core/xml_attributes.hpp"
+#include "particle_presets.hpp"
+
+namespace TSC {
+
+    class cParticlePresetLoader: public xmlpp::SaxParser {
+    public:
+        cParticlePresetLoader();
+        virtual ~cParticlePresetLoader();
+
+        // Parse the given filename. Use this function instead of
+        // bare xmlpp’s parse_file() that accepts a Glib::ustring —
+        // this function sets some internal members.
+        virtual void parse_file(boost::filesystem::path filename);
+        // After finishing parsing, contains the loaded presets.
+        // These must be freed by you.
+        vector<cParticle_Preset*>& Get_Presets();
+
+    protected: // SAX parser callbacks
+        virtual void on_start_document();
+        virtual void on_end_document();
+        virtual void on_start_element(const Glib::ustring& name, const xmlpp::SaxParser::AttributeList& properties);
+        virtual void on_end_element(const Glib::ustring& name);
+
+        void Handle_Preset();
+
+        vector<cParticle_Preset*> m_presets;
+        boost::filesystem::path m_presetfile;
+        XmlAttributes m_current_properties;
+    };
+
+}
+#endif
@@ -0,0 +1,279 @@
+/***************************************************************************
+ * particle_presets.cpp  -  Named particle effects and pooled emitters
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/particle_presets.hpp"
+#include "../video/particle_preset_loader.hpp"
+#include "../video/video.hpp"
+#include "../core/filesystem/filesystem.hpp"
+#include "../core/global_basic.hpp"
+
+namespace fs = boost::filesystem;
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** *** Helpers *** *** *** *** *** *** *** *** *** */
+
+// Return the blending mode of the given name
+static BlendingMode Get_Blending_Id(const std::string& str)
+{
+    if (str == "add") {
+        return BLEND_ADD;
+    }
+    else if (str == "drive") {
+        return BLEND_DRIVE;
+    }
+
+    return BLEND_NONE;
+}
+
+// Return the particle priority of the given name
+static ParticlePriority Get_Priority_Id(const std::string& str)
+{
+    if (str == "low") {
+        return PARTICLE_PRIORITY_LOW;
+    }
+    else if (str == "high") {
+        return PARTICLE_PRIORITY_HIGH;
+    }
+
+    return PARTICLE_PRIORITY_NORMAL;
+}
+
+// Return the color of the properties with the given prefix
+static Color Get_Color(XmlAttributes& attributes, const std::string& prefix, const Color& default_color)
+{
+    return Color(static_cast<uint8_t>(attributes.fetch<int>(prefix + "red", default_color.red)),
+                 static_cast<uint8_t>(attributes.fetch<int>(prefix + "green", default_color.green)),
+                 static_cast<uint8_t>(attributes.fetch<int>(prefix + "blue", default_color.blue)),
+                 static_cast<uint8_t>(attributes.fetch<int>(prefix + "alpha", default_color.alpha)));
+}
+
+/* *** *** *** *** *** *** *** cParticle_Preset *** *** *** *** *** *** *** *** *** *** */
+
+cParticle_Preset::cParticle_Preset(XmlAttributes& attributes)
+{
+    m_name = attributes["name"];
+    // the image is only looked up once
+    m_image = pVideo->Get_Package_Surface(utf8_to_path(attributes["particle_image"]));
+
+    // defaults are the same as of a new emitter
+    m_width = attributes.fetch<float>("sizex", 0.0f);
+    m_height = attributes.fetch<float>("sizey", 0.0f);
+    m_pos_z = attributes.fetch<float>("pos_z", 0.07f);
+    m_pos_z_rand = attributes.fetch<float>("pos_z_rand", 0.0f);
+    m_emitter_time_to_live = attributes.fetch<float>("emitter_time_to_live", 0.0f);
+    m_emitter_iteration_interval = attributes.fetch<float>("emitter_interval", 0.2f);
+    m_quota = static_cast<unsigned int>(attributes.fetch<int>("quota", 1));
+
+    m_time_to_live = attributes.fetch<float>("time_to_live", 1.0f);
+    m_time_to_live_rand = attributes.fetch<float>("time_to_live_rand", 0.0f);
+    m_vel = attributes.fetch<float>("vel", 2.0f);
+    m_vel_rand = attributes.fetch<float>("vel_rand", 2.0f);
+    m_start_rot_z = attributes.fetch<float>("rot_z", 0.0f);
+    m_start_rot_z_uses_direction = attributes.fetch<bool>("start_rot_z_uses_direction", 0);
+    m_const_rot_z = attributes.fetch<float>("const_rot_z", 0.0f);
+    m_const_rot_z_rand = attributes.fetch<float>("const_rot_z_rand", 0.0f);
+    m_angle_start = attributes.fetch<float>("angle_start", 0.0f);
+    m_angle_range = attributes.fetch<float>("angle_range", 360.0f);
+    m_size_scale = attributes.fetch<float>("size_scale", 1.0f);
+    m_size_scale_rand = attributes.fetch<float>("size_scale_rand", 0.0f);
+    m_gravity_x = attributes.fetch<float>("gravity_x", 0.0f);
+    m_gravity_x_rand = attributes.fetch<float>("gravity_x_rand", 0.0f);
+    m_gravity_y = attributes.fetch<float>("gravity_y", 0.0f);
+    m_gravity_y_rand = attributes.fetch<float>("gravity_y_rand", 0.0f);
+    m_color = Get_Color(attributes, "color_", white);
+    m_color_rand = Get_Color(attributes, "color_rand_", Color(static_cast<uint8_t>(0), 0, 0, 0));
+    m_fade_size = attributes.fetch<bool>("fade_size", 0);
+    m_fade_alpha = attributes.fetch<bool>("fade_alpha", 1);
+    m_fade_color = attributes.fetch<bool>("fade_color", 0);
+    m_blending = Get_Blending_Id(attributes["blending"]);
+    m_priority = Get_Priority_Id(attributes["priority"]);
+}
+
+cParticle_Preset::~cParticle_Preset(void)
+{
+
+}
+
+void cParticle_Preset::Apply(cParticle_Emitter* emitter) const
+{
+    // reset a reused emitter
+    emitter->Clear();
+    emitter->Init();
+
+    emitter->Set_Spawned(1);
+    emitter->Set_Image(m_image);
+    emitter->Set_Emitter_Rect(0.0f, 0.0f, m_width, m_height);
+    emitter->Set_Pos_Z(m_pos_z, m_pos_z_rand);
+    emitter->Set_Emitter_Time_to_Live(m_emitter_time_to_live);
+    emitter->Set_Emitter_Iteration_Interval(m_emitter_iteration_interval);
+    emitter->Set_Quota(m_quota);
+    emitter->Set_Time_to_Live(m_time_to_live, m_time_to_live_rand);
+    emitter->Set_Speed(m_vel, m_vel_rand);
+    emitter->Set_Rotation(0.0f, 0.0f, m_start_rot_z, 1);
+    emitter->Set_Start_Rot_Z_Uses_Direction(m_start_rot_z_uses_direction);
+    emitter->Set_Const_Rotation_X(0.0f);
+    emitter->Set_Const_Rotation_Y(0.0f);
+    emitter->Set_Const_Rotation_Z(m_const_rot_z, m_const_rot_z_rand);
+    emitter->Set_Direction_Range(m_angle_start, m_angle_range);
+    emitter->Set_Scale(m_size_scale, m_size_scale_rand);
+    emitter->Set_Horizontal_Gravity(m_gravity_x, m_gravity_x_rand);
+    emitter->Set_Vertical_Gravity(m_gravity_y, m_gravity_y_rand);
+    emitter->Set_Color(m_color, m_color_rand);
+    emitter->Set_Fading_Size(m_fade_size);
+    emitter->Set_Fading_Alpha(m_fade_alpha);
+    emitter->Set_Fading_Color(m_fade_color);
+    emitter->Set_Blending(m_blending);
+    emitter->Set_Priority(m_priority);
+}
+
+/* *** *** *** *** *** *** *** cParticle_Preset_Manager *** *** *** *** *** *** *** *** *** *** */
+
+cParticle_Preset_Manager::cParticle_Preset_Manager(void)
+{
+
+}
+
+cParticle_Preset_Manager::~cParticle_Preset_Manager(void)
+{
+    Delete_All();
+}
+
+void cParticle_Preset_Manager::Load(const fs::path& filename)
+{
+    if (!File_Exists(filename)) {
+        cerr << "Error : Particle presets loading failed : " << path_to_utf8(filename) << endl;
+        return;
+    }
+
+    cParticlePresetLoader parser;
+    parser.parse_file(filename);
+
+    vector<cParticle_Preset*>& presets = parser.Get_Presets();
+
+    for (vector<cParticle_Preset*>::iterator itr = presets.begin(); itr != presets.end(); ++itr) {
+        cParticle_Preset* preset = (*itr);
+
+        // without an image it would not emit anything
+        if (!preset->m_image) {
+            cerr << "Warning : Particle preset " << preset->m_name << " image not found" << endl;
+            delete preset;
+            continue;
+        }
+
+        // replace an existing preset
+        PresetMap::iterator found = m_presets.find(preset->m_name);
+
+        if (found != m_presets.end()) {
+            delete found->second;
+            found->second = preset;
+        }
+        else {
+            m_presets[preset->m_name] = preset;
+        }
+    }
+
+    debug_print("Loaded %u particle presets from %s\n", static_cast<unsigned int>(m_presets.size()), path_to_utf8(filename).c_str());
+}
+
+void cParticle_Preset_Manager::Delete_All(void)
+{
+    for (PresetMap::iterator itr = m_presets.begin(); itr != m_presets.end(); ++itr) {
+        delete itr->second;
+    }
+
+    m_presets.clear();
+
+    for (EmitterList::iterator itr = m_pool.begin(); itr != m_pool.end(); ++itr) {
+        delete *itr;
+    }
+
+    m_pool.clear();
+}
+
+const cParticle_Preset* cParticle_Preset_Manager::Get(const std::string& name) const
+{
+    PresetMap::const_iterator itr = m_presets.find(name);
+
+    if (itr == m_presets.end()) {
+        return NULL;
+    }
+
+    return itr->second;
+}
+
+cParticle_Emitter* cParticle_Preset_Manager::Create(const std::string& name, cSprite_Manager* sprite_manager)
+{
+    const cParticle_Preset* preset = Get(name);
+
+    if (!preset) {
+        cerr << "Warning : Particle preset " << name << " not found" << endl;
+        return NULL;
+    }
+
+    cParticle_Emitter* emitter;
+
+    // reuse a finished emitter
+    if (!m_pool.empty()) {
+        emitter = m_pool.back();
+        m_pool.pop_back();
+        emitter->Set_Sprite_Manager(sprite_manager);
+    }
+    else {
+        emitter = new cParticle_Emitter(sprite_manager);
+    }
+
+    preset->Apply(emitter);
+    emitter->m_pooled = 1;
+    // finished emitters are inactive
+    emitter->Set_Active(1);
+
+    return emitter;
+}
+
+cParticle_Emitter* cParticle_Preset_Manager::Spawn(const std::string& name, float x, float y, cSprite_Manager* sprite_manager)
+{
+    cParticle_Emitter* emitter = Create(name, sprite_manager);
+
+    if (!emitter) {
+        return NULL;
+    }
+
+    emitter->Set_Emitter_Rect(x, y, emitter->m_rect.m_w, emitter->m_rect.m_h);
+    emitter->Emit();
+    pActive_Animation_Manager->Add(emitter);
+
+    return emitter;
+}
+
+void cParticle_Preset_Manager::Release_Emitter(cParticle_Emitter* emitter)
+{
+    if (m_pool.size() >= m_pool_limit) {
+        delete emitter;
+        return;
+    }
+
+    // free the particles now
+    emitter->Clear();
+    m_pool.push_back(emitter);
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+cParticle_Preset_Manager* pParticle_Preset_Manager = NULL;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
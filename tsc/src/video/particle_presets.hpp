@@ -0,0 +1,136 @@
+/***************************************************************************
+ * particle_presets.h  -  Named particle effects and pooled emitters
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_PARTICLE_PRESETS_HPP
+#define TSC_PARTICLE_PRESETS_HPP
+
+#include "../video/animation.hpp"
+#include "../core/xml_attributes.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** cParticle_Preset *** *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* The settings of a named particle effect
+     * The image is looked up once when the preset is loaded.
+     */
+    class cParticle_Preset {
+    public:
+        // create from the properties of a preset element
+        cParticle_Preset(XmlAttributes& attributes);
+        ~cParticle_Preset(void);
+
+        // Reset the emitter and set it to the preset settings
+        void Apply(cParticle_Emitter* emitter) const;
+
+        // preset name
+        std::string m_name;
+        // particle image
+        cGL_Surface* m_image;
+
+        // emitter
+        float m_width;
+        float m_height;
+        float m_pos_z;
+        float m_pos_z_rand;
+        float m_emitter_time_to_live;
+        float m_emitter_iteration_interval;
+        unsigned int m_quota;
+        // particles
+        float m_time_to_live;
+        float m_time_to_live_rand;
+        float m_vel;
+        float m_vel_rand;
+        float m_start_rot_z;
+        bool m_start_rot_z_uses_direction;
+        float m_const_rot_z;
+        float m_const_rot_z_rand;
+        float m_angle_start;
+        float m_angle_range;
+        float m_size_scale;
+        float m_size_scale_rand;
+        float m_gravity_x;
+        float m_gravity_x_rand;
+        float m_gravity_y;
+        float m_gravity_y_rand;
+        Color m_color;
+        Color m_color_rand;
+        bool m_fade_size;
+        bool m_fade_alpha;
+        bool m_fade_color;
+        BlendingMode m_blending;
+        ParticlePriority m_priority;
+    };
+
+    /* *** *** *** *** *** cParticle_Preset_Manager *** *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Loads the particle presets and hands out emitters set to them
+     * Emitters are taken from a pool and given back by the animation
+     * manager when they are finished instead of being deleted.
+     */
+    class cParticle_Preset_Manager {
+    public:
+        cParticle_Preset_Manager(void);
+        ~cParticle_Preset_Manager(void);
+
+        // Load the presets from the given file
+        void Load(const boost::filesystem::path& filename);
+        // Delete all presets and pooled emitters
+        void Delete_All(void);
+
+        // Return the preset with the given name or NULL if not found
+        const cParticle_Preset* Get(const std::string& name) const;
+
+        /* Return a pooled emitter set to the preset
+         * it is not emitting nor added to an animation manager yet
+         * returns NULL if the preset is not found
+        */
+        cParticle_Emitter* Create(const std::string& name, cSprite_Manager* sprite_manager);
+        /* Create an emitter at the given position, emit once and add it to the active animation manager
+         * returns NULL if the preset is not found
+        */
+        cParticle_Emitter* Spawn(const std::string& name, float x, float y, cSprite_Manager* sprite_manager);
+
+        // Give a finished emitter from Create back to the pool
+        void Release_Emitter(cParticle_Emitter* emitter);
+
+        // Return the number of unused pooled emitters
+        inline size_t Get_Pool_Size(void) const
+        {
+            return m_pool.size();
+        }
+
+        // maximum unused emitters kept in the pool
+        static const size_t m_pool_limit = 128;
+
+    private:
+        typedef std::map<std::string, cParticle_Preset*> PresetMap;
+        PresetMap m_presets;
+
+        // unused emitters
+        typedef vector<cParticle_Emitter*> EmitterList;
+        EmitterList m_pool;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// Particle Preset Manager
+    extern cParticle_Preset_Manager* pParticle_Preset_Manager;
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
@@ -17,6 +17,7 @@
 #include "../video/renderer.hpp"
 #include "../core/game_core.hpp"
 #include "../core/global_basic.hpp"
+#include "../user/preferences.hpp"
 
 using namespace std;
 
@@ -27,10 +28,300 @@ namespace TSC {
 #endif
 
 const float doubled_pi = static_cast<float>(M_PI * 2.0f);
-static GLuint last_bind_texture = 0;
+
+/* Return the sort key of the request
+ * the z position in the upper 32 bits, then the state key and the submission order
+*/
+static inline uint64_t Get_Sort_Key(const cRender_Request* obj, size_t order)
+{
+    // no negative zero
+    const float pos_z = (obj->m_pos_z == 0.0f) ? 0.0f : obj->m_pos_z;
+    uint32_t z_bits;
+    memcpy(&z_bits, &pos_z, sizeof(z_bits));
+
+    // flip the sign bit of positive and all bits of negative floats to sort them as unsigned integers
+    if (z_bits & 0x80000000) {
+        z_bits = ~z_bits;
+    }
+    else {
+        z_bits |= 0x80000000;
+    }
+
+    // the sort is stable so requests after the first 65535 keep their order too
+    if (order > 0xFFFF) {
+        order = 0xFFFF;
+    }
+
+    return (static_cast<uint64_t>(z_bits) << 32) | (static_cast<uint64_t>(obj->Get_State_Key() & 0xFFFF) << 16) | order;
+}
+
+// Rotate the point given as the two coordinates orthogonal to the axis like glRotatef
+static inline void Rotate_Point(float cos_angle, float sin_angle, float& a, float& b)
+{
+    const float old_a = a;
+    a = cos_angle * a - sin_angle * b;
+    b = sin_angle * old_a + cos_angle * b;
+}
+
+// Set the wrap mode of the bound texture
+static void Set_Texture_Wrap(GLint wrap)
+{
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+}
+
+/* *** *** *** *** *** *** cGL_State *** *** *** *** *** *** *** *** *** *** *** */
+
+cGL_State::cGL_State(void)
+{
+    m_valid = 0;
+    m_texture_id = 0;
+    m_texture_enabled = 0;
+    m_blend_sfactor = GL_SRC_ALPHA;
+    m_blend_dfactor = GL_ONE_MINUS_SRC_ALPHA;
+    m_tex_env_mode = GL_MODULATE;
+    m_combine_rgb = GL_MODULATE;
+    m_combine_color[0] = 0.0f;
+    m_combine_color[1] = 0.0f;
+    m_combine_color[2] = 0.0f;
+    m_color = white;
+    m_program = 0;
+
+    m_issued = 0;
+    m_skipped = 0;
+    m_last_issued = 0;
+    m_last_skipped = 0;
+}
+
+cGL_State::~cGL_State(void)
+{
+
+}
+
+void cGL_State::Reset(void)
+{
+    m_valid = 0;
+}
+
+void cGL_State::Restore_Defaults(void)
+{
+    static const float default_combine_color[3] = { 0.0f, 0.0f, 0.0f };
+
+    Set_Blend_Func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // the combine values are only set in combine mode
+    if (!Is_Same(STATE_COMBINE_RGB, m_combine_rgb == GL_MODULATE)) {
+        glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB, GL_MODULATE);
+        m_combine_rgb = GL_MODULATE;
+    }
+    if (!Is_Same(STATE_COMBINE_COLOR, m_combine_color[0] == 0.0f && m_combine_color[1] == 0.0f && m_combine_color[2] == 0.0f)) {
+        glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, default_combine_color);
+        m_combine_color[0] = 0.0f;
+        m_combine_color[1] = 0.0f;
+        m_combine_color[2] = 0.0f;
+    }
+
+    Set_Combine(0, NULL);
+    Set_Color(white);
+    Use_Program(0);
+}
+
+void cGL_State::Bind_Texture(GLuint texture_id)
+{
+    if (Is_Same(STATE_TEXTURE, m_texture_id == texture_id)) {
+        return;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture_id);
+    m_texture_id = texture_id;
+}
+
+void cGL_State::Enable_Texture(bool enable)
+{
+    if (Is_Same(STATE_TEXTURE_ENABLED, m_texture_enabled == enable)) {
+        return;
+    }
+
+    if (enable) {
+        glEnable(GL_TEXTURE_2D);
+    }
+    else {
+        glDisable(GL_TEXTURE_2D);
+    }
+
+    m_texture_enabled = enable;
+}
+
+void cGL_State::Set_Blend_Func(GLenum sfactor, GLenum dfactor)
+{
+    if (Is_Same(STATE_BLEND, m_blend_sfactor == sfactor && m_blend_dfactor == dfactor)) {
+        return;
+    }
+
+    glBlendFunc(sfactor, dfactor);
+    m_blend_sfactor = sfactor;
+    m_blend_dfactor = dfactor;
+}
+
+void cGL_State::Set_Combine(GLint combine_type, const float* combine_color)
+{
+    // only modulate
+    if (!combine_type) {
+        if (!Is_Same(STATE_TEX_ENV_MODE, m_tex_env_mode == GL_MODULATE)) {
+            glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+            m_tex_env_mode = GL_MODULATE;
+        }
+
+        return;
+    }
+
+    if (!Is_Same(STATE_TEX_ENV_MODE, m_tex_env_mode == GL_COMBINE)) {
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE);
+        // the sources are only changed here
+        glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE0_RGB, GL_CONSTANT);
+        glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE1_RGB, GL_TEXTURE);
+        m_tex_env_mode = GL_COMBINE;
+    }
+    if (!Is_Same(STATE_COMBINE_RGB, m_combine_rgb == combine_type)) {
+        glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB, combine_type);
+        m_combine_rgb = combine_type;
+    }
+    if (!Is_Same(STATE_COMBINE_COLOR, m_combine_color[0] == combine_color[0] && m_combine_color[1] == combine_color[1] && m_combine_color[2] == combine_color[2])) {
+        glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, combine_color);
+        m_combine_color[0] = combine_color[0];
+        m_combine_color[1] = combine_color[1];
+        m_combine_color[2] = combine_color[2];
+    }
+}
+
+void cGL_State::Set_Color(const Color& color)
+{
+    if (Is_Same(STATE_COLOR, m_color == color)) {
+        return;
+    }
+
+    glColor4ub(color.red, color.green, color.blue, color.alpha);
+    m_color = color;
+}
+
+void cGL_State::Use_Program(GLuint program)
+{
+    if (Is_Same(STATE_PROGRAM, m_program == program)) {
+        return;
+    }
+
+    // programs are only available with OpenGL 2.0
+    if (GLEW_VERSION_2_0) {
+        glUseProgram(program);
+    }
+
+    m_program = program;
+}
+
+void cGL_State::New_Frame(void)
+{
+    m_last_issued = m_issued;
+    m_last_skipped = m_skipped;
+    m_issued = 0;
+    m_skipped = 0;
+}
+
+/* *** *** *** *** *** *** cRender_Arena *** *** *** *** *** *** *** *** *** *** *** */
+
+static cRender_Arena render_arena;
+
+cRender_Arena::cRender_Arena(void)
+{
+    m_current = NULL;
+    m_current = Get_Free_Block();
+}
+
+cRender_Arena::~cRender_Arena(void)
+{
+    for (Block_List::iterator itr = m_blocks.begin(); itr != m_blocks.end(); ++itr) {
+        delete[] (*itr)->m_data;
+        delete (*itr);
+    }
+}
+
+void* cRender_Arena::Allocate(size_t size)
+{
+    const size_t total = m_header_size + ((size + m_header_size - 1) & ~(m_header_size - 1));
+
+    // too big for a block
+    if (total > m_block_size) {
+        unsigned char* mem = static_cast<unsigned char*>(::operator new(m_header_size + size));
+        *reinterpret_cast<Block**>(mem) = NULL;
+        return mem + m_header_size;
+    }
+
+    // all requests of the block were deleted
+    if (m_current->m_live == 0) {
+        m_current->m_used = 0;
+    }
+
+    if (m_current->m_used + total > m_block_size) {
+        m_current = Get_Free_Block();
+    }
+
+    unsigned char* mem = m_current->m_data + m_current->m_used;
+    m_current->m_used += total;
+    m_current->m_live++;
+
+    *reinterpret_cast<Block**>(mem) = m_current;
+    return mem + m_header_size;
+}
+
+void cRender_Arena::Release(void* ptr)
+{
+    if (!ptr) {
+        return;
+    }
+
+    unsigned char* mem = static_cast<unsigned char*>(ptr) - m_header_size;
+    Block* block = *reinterpret_cast<Block**>(mem);
+
+    // allocated on its own
+    if (!block) {
+        ::operator delete(mem);
+        return;
+    }
+
+    block->m_live--;
+}
+
+cRender_Arena::Block* cRender_Arena::Get_Free_Block(void)
+{
+    for (Block_List::iterator itr = m_blocks.begin(); itr != m_blocks.end(); ++itr) {
+        Block* block = (*itr);
+
+        if (block != m_current && block->m_live == 0) {
+            block->m_used = 0;
+            return block;
+        }
+    }
+
+    Block* block = new Block();
+    block->m_live = 0;
+    block->m_used = 0;
+    block->m_data = new unsigned char[m_block_size];
+    m_blocks.push_back(block);
+
+    return block;
+}
 
 /* *** *** *** *** *** *** cRender_Request *** *** *** *** *** *** *** *** *** *** *** */
 
+void* cRender_Request::operator new(size_t size)
+{
+    return render_arena.Allocate(size);
+}
+
+void cRender_Request::operator delete(void* ptr)
+{
+    cRender_Arena::Release(ptr);
+}
+
 cRender_Request::cRender_Request(void)
 {
     m_type = REND_NOTHING;
@@ -43,6 +334,11 @@ cRender_Request::~cRender_Request(void)
 
 }
 
+unsigned int cRender_Request::Get_State_Key(void) const
+{
+    return 0;
+}
+
 void cRender_Request::Draw(void)
 {
     // virtual
@@ -72,35 +368,25 @@ void cClear_Request::Draw(void)
 /* *** *** *** *** *** *** cText_Request *** *** *** *** *** *** *** *** *** *** *** */
 
 cText_Request::cText_Request(const sf::Text& text)
-    : cRender_Request(), m_text(text), m_pos(0, 0)
+    : cRender_Request(), m_text(text)
 {
     m_type = REND_TEXT;
+    // load the glyphs now and not while drawing in the render thread
+    m_text.getLocalBounds();
 }
 
 cText_Request::~cText_Request(void)
 {
 }
 
-/**
- * Executes this drawing request. The caller is required to save the
- * OpenGL stack before calling this function using
- * sf::Window::pushGLStates() so that SFML can render with its own
- * presets. After the function returns, the caller is required to
- * reset the OpenGL stack to what it was before with
- * sf::Window::popGLStates() so TSC can render again as it should.
- *
- * It is possible (and recommended) to execute multiple text drawing
- * requests between push/pop. This allows to keep things performant.
- * That is, this is okay:
- *
- * 1. Push OpenGL stack
- * 2. textreq1.Draw()
- * 3. textreq2.Draw()
- * 4. Pop OpenGL stack
- */
 void cText_Request::Draw(void)
 {
+    // SFML renders with its own presets
+    pVideo->mp_window->pushGLStates();
     pVideo->mp_window->draw(m_text);
+    pVideo->mp_window->popGLStates();
+    // the state was changed outside of the tracking
+    pGL_State->Reset();
 }
 
 /* *** *** *** *** *** *** cRender_Request_Advanced *** *** *** *** *** *** *** *** *** *** *** */
@@ -144,18 +430,13 @@ void cRender_Request_Advanced::Render_Basic(void)
     }
 
     // blend factor
-    if (m_blend_sfactor != GL_SRC_ALPHA || m_blend_dfactor != GL_ONE_MINUS_SRC_ALPHA) {
-        glBlendFunc(m_blend_sfactor, m_blend_dfactor);
-    }
+    pGL_State->Set_Blend_Func(m_blend_sfactor, m_blend_dfactor);
+    // fixed function pipeline
+    pGL_State->Use_Program(0);
 }
 
 void cRender_Request_Advanced::Render_Basic_Clear(void) const
 {
-    // clear blend factor
-    if (m_blend_sfactor != GL_SRC_ALPHA || m_blend_dfactor != GL_ONE_MINUS_SRC_ALPHA) {
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    }
-
     // if debug build check for errors
 #ifdef _DEBUG
     // glGetError only saves one error flag
@@ -181,24 +462,17 @@ void cRender_Request_Advanced::Render_Advanced(void)
     }
 
     // Color Combine
-    if (m_combine_type != 0) {
-        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE);
-        glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB, m_combine_type);
-        glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE0_RGB, GL_CONSTANT);
-        glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, m_combine_color);
-        glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE1_RGB, GL_TEXTURE);
-    }
+    pGL_State->Set_Combine(m_combine_type, m_combine_color);
 }
 
-void cRender_Request_Advanced::Render_Advanced_Clear(void) const
+unsigned int cRender_Request_Advanced::Get_State_Key(void) const
 {
-    // clear color modifications
-    if (m_combine_type != 0) {
-        float col[3] = { 0.0f, 0.0f, 0.0f };
-        glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, col);
-        glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB, GL_MODULATE);
-        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    // default blending first
+    if (m_blend_sfactor == GL_SRC_ALPHA && m_blend_dfactor == GL_ONE_MINUS_SRC_ALPHA) {
+        return 0;
     }
+
+    return (1 + ((m_blend_sfactor * 31 + m_blend_dfactor) % 15)) << 12;
 }
 
 /* *** *** *** *** *** *** cLine_Request *** *** *** *** *** *** *** *** *** *** *** */
@@ -224,7 +498,7 @@ void cLine_Request::Draw(void)
 
     // set camera position
     if (!m_no_camera) {
-        glTranslatef(-pActive_Camera->m_x, -pActive_Camera->m_y, m_pos_z);
+        glTranslatef(-cRenderQueue::m_camera_x, -cRenderQueue::m_camera_y, m_pos_z);
     }
     else {
         // only z position
@@ -234,13 +508,9 @@ void cLine_Request::Draw(void)
     Render_Advanced();
 
     // color
-    if (m_color.red != 255 || m_color.green != 255 || m_color.blue != 255 || m_color.alpha != 255) {
-        glColor4ub(m_color.red, m_color.green, m_color.blue, m_color.alpha);
-    }
+    pGL_State->Set_Color(m_color);
 
-    if (glIsEnabled(GL_TEXTURE_2D)) {
-        glDisable(GL_TEXTURE_2D);
-    }
+    pGL_State->Enable_Texture(0);
 
     // change width
     if (m_line_width != 1.0f) {
@@ -266,12 +536,6 @@ void cLine_Request::Draw(void)
         glLineWidth(1.0f);
     }
 
-    // clear color
-    if (m_color.red != 255 || m_color.green != 255 || m_color.blue != 255 || m_color.alpha != 255) {
-        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-    }
-
-    Render_Advanced_Clear();
     Render_Basic_Clear();
 }
 
@@ -311,8 +575,8 @@ void cRect_Request::Draw(void)
 
     // set camera position
     if (!m_no_camera) {
-        final_pos_x -= pActive_Camera->m_x;
-        final_pos_y -= pActive_Camera->m_y;
+        final_pos_x -= cRenderQueue::m_camera_x;
+        final_pos_y -= cRenderQueue::m_camera_y;
     }
 
     glTranslatef(final_pos_x, final_pos_y, m_pos_z);
@@ -325,13 +589,9 @@ void cRect_Request::Draw(void)
     Render_Advanced();
 
     // color
-    if (m_color.red != 255 || m_color.green != 255 || m_color.blue != 255 || m_color.alpha != 255) {
-        glColor4ub(m_color.red, m_color.green, m_color.blue, m_color.alpha);
-    }
+    pGL_State->Set_Color(m_color);
 
-    if (glIsEnabled(GL_TEXTURE_2D)) {
-        glDisable(GL_TEXTURE_2D);
-    }
+    pGL_State->Enable_Texture(0);
 
     if (m_filled) {
         glBegin(GL_POLYGON);
@@ -368,12 +628,6 @@ void cRect_Request::Draw(void)
         glLineWidth(1.0f);
     }
 
-    // clear color
-    if (m_color.red != 255 || m_color.green != 255 || m_color.blue != 255 || m_color.alpha != 255) {
-        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-    }
-
-    Render_Advanced_Clear();
     Render_Basic_Clear();
 }
 
@@ -400,25 +654,23 @@ void cGradient_Request::Draw(void)
 
     // set camera position
     if (!m_no_camera) {
-        glTranslatef(m_rect.m_x - pActive_Camera->m_x, m_rect.m_y - pActive_Camera->m_y, m_pos_z);
+        glTranslatef(m_rect.m_x - cRenderQueue::m_camera_x, m_rect.m_y - cRenderQueue::m_camera_y, m_pos_z);
     }
     // ignore camera position
     else {
         glTranslatef(m_rect.m_x, m_rect.m_y, m_pos_z);
     }
 
-    if (glIsEnabled(GL_TEXTURE_2D)) {
-        glDisable(GL_TEXTURE_2D);
-    }
+    pGL_State->Enable_Texture(0);
 
     Render_Advanced();
 
     if (m_dir == DIR_VERTICAL) {
         glBegin(GL_POLYGON);
-        glColor4ub(m_color_1.red, m_color_1.green, m_color_1.blue, m_color_1.alpha);
+        pGL_State->Set_Color(m_color_1);
         glVertex2f(0.0f, 0.0f);
         glVertex2f(m_rect.m_w, 0.0f);
-        glColor4ub(m_color_2.red, m_color_2.green, m_color_2.blue, m_color_2.alpha);
+        pGL_State->Set_Color(m_color_2);
         glVertex2f(m_rect.m_w, m_rect.m_h);
         glVertex2f(0.0f, m_rect.m_h);
         glEnd();
@@ -426,19 +678,15 @@ void cGradient_Request::Draw(void)
     }
     else if (m_dir == DIR_HORIZONTAL) {
         glBegin(GL_POLYGON);
-        glColor4ub(m_color_1.red, m_color_1.green, m_color_1.blue, m_color_1.alpha);
+        pGL_State->Set_Color(m_color_1);
         glVertex2f(0.0f, m_rect.m_h);
         glVertex2f(0.0f, 0.0f);
-        glColor4ub(m_color_2.red, m_color_2.green, m_color_2.blue, m_color_2.alpha);
+        pGL_State->Set_Color(m_color_2);
         glVertex2f(m_rect.m_w, 0.0f);
         glVertex2f(m_rect.m_w, m_rect.m_h);
         glEnd();
     }
 
-    // clear color
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-
-    Render_Advanced_Clear();
     Render_Basic_Clear();
 }
 
@@ -466,7 +714,7 @@ void cCircle_Request::Draw(void)
 
     // set camera position
     if (!m_no_camera) {
-        glTranslatef(m_pos.m_x - pActive_Camera->m_x, m_pos.m_y - pActive_Camera->m_y, m_pos_z);
+        glTranslatef(m_pos.m_x - cRenderQueue::m_camera_x, m_pos.m_y - cRenderQueue::m_camera_y, m_pos_z);
     }
     // ignore camera position
     else {
@@ -476,13 +724,9 @@ void cCircle_Request::Draw(void)
     Render_Advanced();
 
     // color
-    if (m_color.red != 255 || m_color.green != 255 || m_color.blue != 255 || m_color.alpha != 255) {
-        glColor4ub(m_color.red, m_color.green, m_color.blue, m_color.alpha);
-    }
+    pGL_State->Set_Color(m_color);
 
-    if (glIsEnabled(GL_TEXTURE_2D)) {
-        glDisable(GL_TEXTURE_2D);
-    }
+    pGL_State->Enable_Texture(0);
 
     // not filled
     if (m_line_width) {
@@ -525,12 +769,6 @@ void cCircle_Request::Draw(void)
         glLineWidth(1.0f);
     }
 
-    // clear color
-    if (m_color.red != 255 || m_color.green != 255 || m_color.blue != 255 || m_color.alpha != 255) {
-        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-    }
-
-    Render_Advanced_Clear();
     Render_Basic_Clear();
 }
 
@@ -541,6 +779,10 @@ cSurface_Request::cSurface_Request(void)
 {
     m_type = REND_SURFACE;
     m_texture_id = 0;
+    m_tex_x1 = 0.0f;
+    m_tex_y1 = 0.0f;
+    m_tex_x2 = 1.0f;
+    m_tex_y2 = 1.0f;
 
     m_pos_x = 0.0f;
     m_pos_y = 0.0f;
@@ -555,10 +797,16 @@ cSurface_Request::cSurface_Request(void)
     m_color = static_cast<uint8_t>(255);
 
     m_delete_texture = 0;
+    m_repeat = 0;
 }
 
 cSurface_Request::~cSurface_Request(void)
 {
+    // deleted without rendering
+    if (m_delete_texture) {
+        pVideo->Render_Finish();
+    }
+
     if (m_delete_texture && glIsTexture(m_texture_id)) {
         glDeleteTextures(1, &m_texture_id);
     }
@@ -568,44 +816,7 @@ void cSurface_Request::Draw(void)
 {
     // draw shadow
     if (m_shadow_pos) {
-        // shadow position
-        m_pos_x += m_shadow_pos;
-        m_pos_y += m_shadow_pos;
-        m_pos_z -= 0.000001f;
-
-        // save data
-        const Color temp_color = m_color;
-        const float temp_shadow_pos = m_shadow_pos;
-        const GLint temp_combine_type = m_combine_type;
-        const float temp_combine_color[3] = { m_combine_color[0], m_combine_color[1], m_combine_color[2] };
-
-        // temporarily unset to prevent endless loop
-        m_shadow_pos = 0;
-        // shadow as a white texture
-        m_color = black;
-        // keep m_shadow_color alpha
-        m_color.alpha = m_shadow_color.alpha;
-        // combine color
-        m_combine_type = GL_REPLACE;
-        m_combine_color[0] = static_cast<float>(m_shadow_color.red) / 260;
-        m_combine_color[1] = static_cast<float>(m_shadow_color.green) / 260;
-        m_combine_color[2] = static_cast<float>(m_shadow_color.blue) / 260;
-
-        // draw shadow
-        Draw();
-
-        // set back data
-        m_shadow_pos = temp_shadow_pos;
-        m_color = temp_color;
-        m_combine_type = temp_combine_type;
-        m_combine_color[0] = temp_combine_color[0];
-        m_combine_color[1] = temp_combine_color[1];
-        m_combine_color[2] = temp_combine_color[2];
-        m_pos_z += 0.000001f;
-
-        // move back to original position
-        m_pos_x -= m_shadow_pos;
-        m_pos_y -= m_shadow_pos;
+        Render_Shadow(NULL);
     }
 
     Render_Basic();
@@ -619,8 +830,8 @@ void cSurface_Request::Draw(void)
 
     // set camera position
     if (!m_no_camera) {
-        final_pos_x -= pActive_Camera->m_x;
-        final_pos_y -= pActive_Camera->m_y;
+        final_pos_x -= cRenderQueue::m_camera_x;
+        final_pos_y -= cRenderQueue::m_camera_y;
     }
 
     glTranslatef(final_pos_x, final_pos_y, m_pos_z);
@@ -633,18 +844,14 @@ void cSurface_Request::Draw(void)
     Render_Advanced();
 
     // color
-    if (m_color.red != 255 || m_color.green != 255 || m_color.blue != 255 || m_color.alpha != 255) {
-        glColor4ub(m_color.red, m_color.green, m_color.blue, m_color.alpha);
-    }
+    pGL_State->Set_Color(m_color);
 
-    if (!glIsEnabled(GL_TEXTURE_2D)) {
-        glEnable(GL_TEXTURE_2D);
-    }
+    pGL_State->Enable_Texture(1);
+    pGL_State->Bind_Texture(m_texture_id);
 
-    // only bind if not the same texture
-    if (last_bind_texture != m_texture_id) {
-        glBindTexture(GL_TEXTURE_2D, m_texture_id);
-        last_bind_texture = m_texture_id;
+    // the texture may be shared so the wrap mode is only changed for this request
+    if (m_repeat) {
+        Set_Texture_Wrap(GL_REPEAT);
     }
 
     /* vertex arrays should not be used to draw simple primitives as it
@@ -653,152 +860,1056 @@ void cSurface_Request::Draw(void)
     // rectangle
     glBegin(GL_QUADS);
     // top left
-    glTexCoord2f(0.0f, 0.0f);
+    glTexCoord2f(m_tex_x1, m_tex_y1);
     glVertex2f(-half_w, -half_h);
     // top right
-    glTexCoord2f(1.0f, 0.0f);
+    glTexCoord2f(m_tex_x2, m_tex_y1);
     glVertex2f(half_w, -half_h);
     // bottom right
-    glTexCoord2f(1.0f, 1.0f);
+    glTexCoord2f(m_tex_x2, m_tex_y2);
     glVertex2f(half_w, half_h);
     // bottom left
-    glTexCoord2f(0.0f, 1.0f);
+    glTexCoord2f(m_tex_x1, m_tex_y2);
     glVertex2f(-half_w, half_h);
     glEnd();
 
-    // clear color
-    if (m_color.red != 255 || m_color.green != 255 || m_color.blue != 255 || m_color.alpha != 255) {
-        /* alpha is automatically 1 for glColor3f
-         * update : not on the shitty intel drivers :(
-        */
-        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+    // textures are created with clamping
+    if (m_repeat) {
+        Set_Texture_Wrap(GL_CLAMP_TO_EDGE);
     }
 
-    Render_Advanced_Clear();
     Render_Basic_Clear();
 }
 
-/* *** *** *** *** *** *** cRenderQueue *** *** *** *** *** *** *** *** *** *** *** */
-
-cRenderQueue::cRenderQueue(unsigned int reserve_items)
+unsigned int cSurface_Request::Get_State_Key(void) const
 {
-    m_render_data.reserve(reserve_items);
+    return cRender_Request_Advanced::Get_State_Key() | (m_texture_id & 0xFFF);
 }
 
-cRenderQueue::~cRenderQueue(void)
+void cSurface_Request::Batch(cSurface_Batch& batch)
 {
-    Clear();
+    // batch shadow
+    if (m_shadow_pos) {
+        Render_Shadow(&batch);
+    }
+
+    batch.Add(*this);
 }
 
-void cRenderQueue::Add(cRender_Request* obj)
+void cSurface_Request::Render_Shadow(cSurface_Batch* batch)
 {
-    if (!obj) {
-        return;
-    }
+    // shadow position
+    m_pos_x += m_shadow_pos;
+    m_pos_y += m_shadow_pos;
+    m_pos_z -= 0.000001f;
+
+    // save data
+    const Color temp_color = m_color;
+    const float temp_shadow_pos = m_shadow_pos;
+    const GLint temp_combine_type = m_combine_type;
+    const float temp_combine_color[3] = { m_combine_color[0], m_combine_color[1], m_combine_color[2] };
+
+    // temporarily unset to prevent endless loop
+    m_shadow_pos = 0;
+    // shadow as a white texture
+    m_color = black;
+    // keep m_shadow_color alpha
+    m_color.alpha = m_shadow_color.alpha;
+    // combine color
+    m_combine_type = GL_REPLACE;
+    m_combine_color[0] = static_cast<float>(m_shadow_color.red) / 260;
+    m_combine_color[1] = static_cast<float>(m_shadow_color.green) / 260;
+    m_combine_color[2] = static_cast<float>(m_shadow_color.blue) / 260;
 
-    // if no type
-    if (obj->m_type == REND_NOTHING) {
-        delete obj;
-        return;
-    }
-    else if (obj->m_type == REND_TEXT) {
-        // Add to the special text render queue, which is rendered later for performance
-        m_text_render_data.push_back(static_cast<cText_Request*>(obj));
+    // draw shadow
+    if (batch) {
+        Batch(*batch);
     }
     else {
-        // Add to normal render queue
-        m_render_data.push_back(obj);
+        Draw();
     }
+
+    // set back data
+    m_shadow_pos = temp_shadow_pos;
+    m_color = temp_color;
+    m_combine_type = temp_combine_type;
+    m_combine_color[0] = temp_combine_color[0];
+    m_combine_color[1] = temp_combine_color[1];
+    m_combine_color[2] = temp_combine_color[2];
+    m_pos_z += 0.000001f;
+
+    // move back to original position
+    m_pos_x -= m_shadow_pos;
+    m_pos_y -= m_shadow_pos;
 }
 
-/**
- * Executes all render requests collected via Add(). SFML text elements are
- * rendered at the end of the rendering process, because this allows to
- * perform the OpenGL state saving required by the switch from raw OpenGL
- * to SFML just once here instead of once per text element. As a side effect
- * this causes all text elements to always render on top of the normal
- * stuff, but since texts are meant to be read by the user, this is what
- * is wanted in any case.
- */
-void cRenderQueue::Render(bool clear /* = 1 */)
+/* *** *** *** *** *** *** Shader helpers *** *** *** *** *** *** *** *** *** *** *** */
+
+// Return the compiled shader or 0 on failure
+static GLuint Compile_Shader(GLenum type, const char* source, const char* name)
 {
-    // z position sort
-    std::sort(m_render_data.begin(), m_render_data.end(), zpos_sort());
-    // reset last texture
-    last_bind_texture = 0;
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
 
-    for (RenderList::iterator itr = m_render_data.begin(); itr != m_render_data.end(); ++itr) {
-        cRender_Request* obj = (*itr);
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
 
-        obj->Draw();
-        obj->m_render_count--;
+    if (status != GL_TRUE) {
+        char log[1024] = "";
+        glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+        cerr << "Warning : " << name << " shader compilation failed : " << log << endl;
+
+        glDeleteShader(shader);
+        return 0;
     }
 
-    // Render the SFML text elements afterwards. This allows to call the OpenGL
-    // state resetting functions just once per frame instead of once per text element.
-    pVideo->mp_window->pushGLStates();
-    for(std::vector<cText_Request*>::iterator itr = m_text_render_data.begin(); itr != m_text_render_data.end(); ++itr) {
-        cText_Request* obj = *itr;
+    return shader;
+}
 
-        obj->Draw();
-        obj->m_render_count--;
+/* Return the linked program or 0 on failure
+ * first_attribute : bound to location 0 which needs to be an enabled array on some drivers or NULL
+*/
+static GLuint Create_Program(const char* vertex_source, const char* fragment_source, const char* name, const char* first_attribute = NULL)
+{
+    GLuint vertex_shader = Compile_Shader(GL_VERTEX_SHADER, vertex_source, name);
+    GLuint fragment_shader = Compile_Shader(GL_FRAGMENT_SHADER, fragment_source, name);
+
+    if (!vertex_shader || !fragment_shader) {
+        glDeleteShader(vertex_shader);
+        glDeleteShader(fragment_shader);
+        return 0;
     }
-    pVideo->mp_window->popGLStates();
 
-    if (clear) {
-        Clear(0);
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertex_shader);
+    glAttachShader(program, fragment_shader);
+
+    if (first_attribute) {
+        glBindAttribLocation(program, 0, first_attribute);
+    }
+
+    glLinkProgram(program);
+    // only flagged for deletion until the program is deleted
+    glDeleteShader(vertex_shader);
+    glDeleteShader(fragment_shader);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+
+    if (status != GL_TRUE) {
+        char log[1024] = "";
+        glGetProgramInfoLog(program, sizeof(log), NULL, log);
+        cerr << "Warning : " << name << " shader linking failed : " << log << endl;
+
+        glDeleteProgram(program);
+        return 0;
     }
+
+    return program;
 }
 
-void cRenderQueue::Fake_Render(unsigned int amount /* = 1 */, bool clear /* = 1 */)
+/* *** *** *** *** *** *** cSurface_Shader *** *** *** *** *** *** *** *** *** *** *** */
+
+static const char* surface_vertex_shader =
+    "#version 110\n"
+    "attribute vec4 combine;\n"
+    "varying vec4 combine_color;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = ftransform();\n"
+    "    gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+    "    gl_FrontColor = gl_Color;\n"
+    "    combine_color = combine;\n"
+    "}\n";
+
+/* the combine mode is in the alpha of the combine color
+ * 0 : modulate with the vertex color
+ * 1 : GL_REPLACE, 2 : GL_MODULATE and 3 : GL_ADD with the combine color
+ * the alpha is always modulated like GL_COMBINE_ALPHA does by default
+*/
+static const char* surface_fragment_shader =
+    "#version 110\n"
+    "uniform sampler2D surface_texture;\n"
+    "varying vec4 combine_color;\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 texel = texture2D(surface_texture, gl_TexCoord[0].st);\n"
+    "    float mode = floor(combine_color.a * 255.0 + 0.5);\n"
+    "    vec3 color = texel.rgb * gl_Color.rgb;\n"
+    "    if (mode > 2.5) {\n"
+    "        color = min(combine_color.rgb + texel.rgb, 1.0);\n"
+    "    }\n"
+    "    else if (mode > 1.5) {\n"
+    "        color = combine_color.rgb * texel.rgb;\n"
+    "    }\n"
+    "    else if (mode > 0.5) {\n"
+    "        color = combine_color.rgb;\n"
+    "    }\n"
+    "    gl_FragColor = vec4(color, texel.a * gl_Color.a);\n"
+    "}\n";
+
+cSurface_Shader::cSurface_Shader(void)
 {
-    for (RenderList::iterator itr = m_render_data.begin(); itr != m_render_data.end(); ++itr) {
-        cRender_Request* obj = (*itr);
-        obj->m_render_count -= amount;
-    }
-    for(std::vector<cText_Request*>::iterator itr = m_text_render_data.begin(); itr != m_text_render_data.end(); ++itr) {
-        cText_Request* obj = *itr;
-        obj->m_render_count -= amount;
-    }
+    m_program = 0;
+    m_combine_location = -1;
+    m_state = 0;
+}
 
-    if (clear) {
-        Clear(0);
+cSurface_Shader::~cSurface_Shader(void)
+{
+    if (m_program && GLEW_VERSION_2_0 && glIsProgram(m_program)) {
+        glDeleteProgram(m_program);
     }
 }
 
-void cRenderQueue::Clear(bool force /* = 1 */)
+bool cSurface_Shader::Init(void)
 {
-    for (RenderList::iterator itr = m_render_data.begin(); itr != m_render_data.end();) {
-        cRender_Request* obj = (*itr);
+    if (m_state) {
+        return m_state > 0;
+    }
 
-        // if forced or finished rendering
-        if (force || obj->m_render_count <= 0) {
-            itr = m_render_data.erase(itr);
-            delete obj;
+    m_state = -1;
+
+    if (!GLEW_VERSION_2_0) {
+        cerr << "Info : OpenGL 2.0 not available, using the fixed function pipeline for surfaces" << endl;
+        return 0;
+    }
+
+    m_program = Create_Program(surface_vertex_shader, surface_fragment_shader, "Surface");
+
+    if (!m_program) {
+        return 0;
+    }
+
+    m_combine_location = glGetAttribLocation(m_program, "combine");
+
+    if (m_combine_location < 0) {
+        cerr << "Warning : Surface shader has no combine attribute" << endl;
+
+        glDeleteProgram(m_program);
+        m_program = 0;
+        return 0;
+    }
+
+    // the sampler uses texture unit 0 which is the default value of uniforms
+
+    m_state = 1;
+    return 1;
+}
+
+GLubyte cSurface_Shader::Get_Combine_Mode(GLint combine_type)
+{
+    switch (combine_type) {
+    case GL_REPLACE:
+        return 1;
+    case GL_MODULATE:
+        return 2;
+    case GL_ADD:
+        return 3;
+    default:
+        return 0;
+    }
+}
+
+/* *** *** *** *** *** *** cSurface_Batch *** *** *** *** *** *** *** *** *** *** *** */
+
+cSurface_Batch::cSurface_Batch(void)
+{
+    m_texture_id = 0;
+    m_blend_sfactor = GL_SRC_ALPHA;
+    m_blend_dfactor = GL_ONE_MINUS_SRC_ALPHA;
+    m_combine_type = 0;
+    m_combine_color[0] = 0.0f;
+    m_combine_color[1] = 0.0f;
+    m_combine_color[2] = 0.0f;
+    m_shader = 0;
+    m_repeat = 0;
+    m_buffer = 0;
+}
+
+cSurface_Batch::~cSurface_Batch(void)
+{
+    if (m_buffer && glIsBuffer(m_buffer)) {
+        glDeleteBuffers(1, &m_buffer);
+    }
+}
+
+void cSurface_Batch::Add(const cSurface_Request& request)
+{
+    if (!m_vertices.empty() && !Is_Compatible(request)) {
+        Flush();
+    }
+
+    // take over the state
+    if (m_vertices.empty()) {
+        m_texture_id = request.m_texture_id;
+        m_blend_sfactor = request.m_blend_sfactor;
+        m_blend_dfactor = request.m_blend_dfactor;
+        m_combine_type = request.m_combine_type;
+        m_combine_color[0] = request.m_combine_color[0];
+        m_combine_color[1] = request.m_combine_color[1];
+        m_combine_color[2] = request.m_combine_color[2];
+        m_shader = pPreferences->m_video_shader_rendering && pSurface_Shader->Init();
+        m_repeat = request.m_repeat;
+    }
+
+    Add_Quad(m_vertices, request);
+}
+
+void cSurface_Batch::Add_Quad(vector<Vertex>& vertices, const cSurface_Request& request, bool world_space /* = 0 */)
+{
+    // get half the size
+    const float half_w = request.m_w / 2;
+    const float half_h = request.m_h / 2;
+    // position
+    float final_pos_x = request.m_pos_x + (half_w * request.m_scale_x);
+    float final_pos_y = request.m_pos_y + (half_h * request.m_scale_y);
+
+    // set camera position
+    if (!request.m_no_camera && !world_space) {
+        final_pos_x -= cRenderQueue::m_camera_x;
+        final_pos_y -= cRenderQueue::m_camera_y;
+    }
+
+    // global scale
+    float global_scale_x = 1.0f;
+    float global_scale_y = 1.0f;
+
+    if (request.m_global_scale && !world_space) {
+        global_scale_x = global_upscalex;
+        global_scale_y = global_upscaley;
+    }
+
+    // rotation
+    const float rad_x = request.m_rot_x * static_cast<float>(M_PI / 180.0);
+    const float rad_y = request.m_rot_y * static_cast<float>(M_PI / 180.0);
+    const float rad_z = request.m_rot_z * static_cast<float>(M_PI / 180.0);
+    const float cos_x = cos(rad_x);
+    const float sin_x = sin(rad_x);
+    const float cos_y = cos(rad_y);
+    const float sin_y = sin(rad_y);
+    const float cos_z = cos(rad_z);
+    const float sin_z = sin(rad_z);
+
+    // color combine for the surface shader
+    GLubyte combine[4] = { 0, 0, 0, 0 };
+
+    if (request.m_combine_type) {
+        for (unsigned int i = 0; i < 3; i++) {
+            combine[i] = static_cast<GLubyte>(std::max(0.0f, std::min(request.m_combine_color[i], 1.0f)) * 255.0f + 0.5f);
+        }
+
+        combine[3] = cSurface_Shader::Get_Combine_Mode(request.m_combine_type);
+    }
+
+    // top left, top right, bottom right and bottom left
+    static const float corners[4][2] = {
+        { -1.0f, -1.0f },
+        { 1.0f, -1.0f },
+        { 1.0f, 1.0f },
+        { -1.0f, 1.0f }
+    };
+
+    for (unsigned int i = 0; i < 4; i++) {
+        float x = corners[i][0] * half_w;
+        float y = corners[i][1] * half_h;
+        float z = 0.0f;
+
+        // the last matrix is applied first
+        if (request.m_rot_z != 0.0f) {
+            Rotate_Point(cos_z, sin_z, x, y);
+        }
+        if (request.m_rot_y != 0.0f) {
+            Rotate_Point(cos_y, sin_y, z, x);
+        }
+        if (request.m_rot_x != 0.0f) {
+            Rotate_Point(cos_x, sin_x, y, z);
+        }
+
+        Vertex vertex;
+        vertex.m_x = ((x * request.m_scale_x) + final_pos_x) * global_scale_x;
+        vertex.m_y = ((y * request.m_scale_y) + final_pos_y) * global_scale_y;
+        vertex.m_z = (z * request.m_scale_z) + request.m_pos_z;
+        vertex.m_u = (corners[i][0] < 0.0f) ? request.m_tex_x1 : request.m_tex_x2;
+        vertex.m_v = (corners[i][1] < 0.0f) ? request.m_tex_y1 : request.m_tex_y2;
+        vertex.m_color[0] = request.m_color.red;
+        vertex.m_color[1] = request.m_color.green;
+        vertex.m_color[2] = request.m_color.blue;
+        vertex.m_color[3] = request.m_color.alpha;
+        memcpy(vertex.m_combine, combine, sizeof(combine));
+
+        vertices.push_back(vertex);
+    }
+}
+
+void cSurface_Batch::Flush(void)
+{
+    if (m_vertices.empty()) {
+        return;
+    }
+
+    // the vertices are already transformed
+    glLoadIdentity();
+
+    // blend factor
+    pGL_State->Set_Blend_Func(m_blend_sfactor, m_blend_dfactor);
+
+    GLint combine_location = -1;
+
+    // the shader takes the color combine from the vertices
+    if (m_shader) {
+        pGL_State->Use_Program(pSurface_Shader->Get_Program());
+        combine_location = pSurface_Shader->Get_Combine_Location();
+    }
+    else {
+        pGL_State->Use_Program(0);
+        // Color Combine
+        pGL_State->Set_Combine(m_combine_type, m_combine_color);
+    }
+
+    pGL_State->Enable_Texture(1);
+    pGL_State->Bind_Texture(m_texture_id);
+
+    const GLsizei vertex_count = static_cast<GLsizei>(m_vertices.size());
+    const char* data = reinterpret_cast<const char*>(&m_vertices[0]);
+
+    // stream through a vertex buffer object if available (OpenGL 1.5)
+    if (GLEW_VERSION_1_5) {
+        if (!m_buffer) {
+            glGenBuffers(1, &m_buffer);
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+        // replace the whole storage so the driver does not wait for the previous draw
+        glBufferData(GL_ARRAY_BUFFER, vertex_count * sizeof(Vertex), data, GL_STREAM_DRAW);
+        data = NULL;
+    }
+
+    // the texture may be shared so the wrap mode is only changed for this batch
+    if (m_repeat) {
+        Set_Texture_Wrap(GL_REPEAT);
+    }
+
+    Draw_Quads(data, 0, vertex_count, combine_location);
+
+    // textures are created with clamping
+    if (m_repeat) {
+        Set_Texture_Wrap(GL_CLAMP_TO_EDGE);
+    }
+
+    // CEGUI and SFML use client side arrays
+    if (GLEW_VERSION_1_5) {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    m_vertices.clear();
+}
+
+void cSurface_Batch::Draw_Quads(const char* data, GLint first, GLsizei vertex_count, GLint combine_location /* = -1 */)
+{
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(Vertex), data + offsetof(Vertex, m_x));
+    glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + offsetof(Vertex, m_u));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + offsetof(Vertex, m_color));
+
+    if (combine_location >= 0) {
+        glEnableVertexAttribArray(combine_location);
+        glVertexAttribPointer(combine_location, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), data + offsetof(Vertex, m_combine));
+    }
+
+    glDrawArrays(GL_QUADS, first, vertex_count);
+
+    if (combine_location >= 0) {
+        glDisableVertexAttribArray(combine_location);
+    }
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    // the current color is undefined after drawing with a color array
+    pGL_State->Invalidate_Color();
+}
+
+bool cSurface_Batch::Is_Compatible(const cSurface_Request& request) const
+{
+    if (request.m_texture_id != m_texture_id || request.m_blend_sfactor != m_blend_sfactor || request.m_blend_dfactor != m_blend_dfactor || request.m_repeat != m_repeat) {
+        return 0;
+    }
+
+    // the shader gets the color combine per vertex
+    if (m_shader) {
+        return 1;
+    }
+
+    if (request.m_combine_type != m_combine_type) {
+        return 0;
+    }
+
+    // the combine color is only used with a combine type
+    if (m_combine_type != 0 && (request.m_combine_color[0] != m_combine_color[0] || request.m_combine_color[1] != m_combine_color[1] || request.m_combine_color[2] != m_combine_color[2])) {
+        return 0;
+    }
+
+    return 1;
+}
+
+/* *** *** *** *** *** *** cGeometry_Request *** *** *** *** *** *** *** *** *** *** *** */
+
+cGeometry_Request::cGeometry_Request(void)
+    : cRender_Request()
+{
+    m_type = REND_GEOMETRY;
+    m_buffer = 0;
+    m_vertices = NULL;
+    m_first = 0;
+    m_count = 0;
+    m_texture_id = 0;
+}
+
+cGeometry_Request::~cGeometry_Request(void)
+{
+
+}
+
+void cGeometry_Request::Draw(void)
+{
+    if (m_count <= 0) {
+        return;
+    }
+
+    // the vertices are in world space
+    glLoadIdentity();
+    glScalef(global_upscalex, global_upscaley, 1.0f);
+    glTranslatef(-cRenderQueue::m_camera_x, -cRenderQueue::m_camera_y, 0.0f);
+
+    pGL_State->Set_Blend_Func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    pGL_State->Use_Program(0);
+    pGL_State->Set_Combine(0, NULL);
+    pGL_State->Enable_Texture(1);
+    pGL_State->Bind_Texture(m_texture_id);
+
+    if (m_buffer) {
+        glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+        cSurface_Batch::Draw_Quads(NULL, m_first, m_count);
+        // CEGUI and SFML use client side arrays
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    else {
+        cSurface_Batch::Draw_Quads(reinterpret_cast<const char*>(m_vertices), m_first, m_count);
+    }
+}
+
+unsigned int cGeometry_Request::Get_State_Key(void) const
+{
+    return m_texture_id & 0xFFF;
+}
+
+/* *** *** *** *** *** *** cParticle_Request *** *** *** *** *** *** *** *** *** *** *** */
+
+cParticle_Request::cParticle_Request(void)
+    : cRender_Request_Advanced()
+{
+    m_type = REND_PARTICLES;
+    m_no_camera = 0;
+    m_texture_id = 0;
+    m_tex_x1 = 0.0f;
+    m_tex_y1 = 0.0f;
+    m_tex_x2 = 1.0f;
+    m_tex_y2 = 1.0f;
+    m_w = 0.0f;
+    m_h = 0.0f;
+}
+
+cParticle_Request::~cParticle_Request(void)
+{
+
+}
+
+void cParticle_Request::Draw(void)
+{
+    if (m_instances.empty()) {
+        return;
+    }
+
+    // the instances are in world space
+    glLoadIdentity();
+
+    if (m_global_scale) {
+        glScalef(global_upscalex, global_upscaley, 1.0f);
+    }
+    if (!m_no_camera) {
+        glTranslatef(-cRenderQueue::m_camera_x, -cRenderQueue::m_camera_y, 0.0f);
+    }
+
+    pGL_State->Set_Blend_Func(m_blend_sfactor, m_blend_dfactor);
+    pGL_State->Enable_Texture(1);
+    pGL_State->Bind_Texture(m_texture_id);
+
+    if (pPreferences->m_video_shader_rendering && pParticle_Shader->Init()) {
+        pParticle_Shader->Draw(*this);
+    }
+    else {
+        Draw_Quads();
+    }
+
+    Render_Basic_Clear();
+}
+
+unsigned int cParticle_Request::Get_State_Key(void) const
+{
+    return cRender_Request_Advanced::Get_State_Key() | (m_texture_id & 0xFFF);
+}
+
+void cParticle_Request::Draw_Quads(void)
+{
+    // reused as only the render thread draws
+    static vector<cSurface_Batch::Vertex> vertices;
+
+    vertices.resize(m_instances.size() * 4);
+
+    const float half_w = m_w / 2;
+    const float half_h = m_h / 2;
+
+    // top left, top right, bottom right and bottom left
+    static const float corners[4][2] = {
+        { -1.0f, -1.0f },
+        { 1.0f, -1.0f },
+        { 1.0f, 1.0f },
+        { -1.0f, 1.0f }
+    };
+
+    cSurface_Batch::Vertex* vertex = &vertices[0];
+
+    for (Instance_List::const_iterator itr = m_instances.begin(); itr != m_instances.end(); ++itr) {
+        const Instance& instance = *itr;
+        const float rad_x = instance.m_rot_x * static_cast<float>(M_PI / 180.0);
+        const float rad_y = instance.m_rot_y * static_cast<float>(M_PI / 180.0);
+        const float rad_z = instance.m_rot_z * static_cast<float>(M_PI / 180.0);
+        const float cos_x = cos(rad_x);
+        const float sin_x = sin(rad_x);
+        const float cos_y = cos(rad_y);
+        const float sin_y = sin(rad_y);
+        const float cos_z = cos(rad_z);
+        const float sin_z = sin(rad_z);
+
+        for (unsigned int i = 0; i < 4; i++, vertex++) {
+            float x = corners[i][0] * half_w;
+            float y = corners[i][1] * half_h;
+            float z = 0.0f;
+
+            // the same order as cSurface_Batch::Add_Quad()
+            Rotate_Point(cos_z, sin_z, x, y);
+            Rotate_Point(cos_y, sin_y, z, x);
+            Rotate_Point(cos_x, sin_x, y, z);
+
+            vertex->m_x = (x * instance.m_scale) + instance.m_x;
+            vertex->m_y = (y * instance.m_scale) + instance.m_y;
+            vertex->m_z = z + m_pos_z + instance.m_z;
+            vertex->m_u = (corners[i][0] < 0.0f) ? m_tex_x1 : m_tex_x2;
+            vertex->m_v = (corners[i][1] < 0.0f) ? m_tex_y1 : m_tex_y2;
+            memcpy(vertex->m_color, instance.m_color, sizeof(instance.m_color));
+            memset(vertex->m_combine, 0, sizeof(vertex->m_combine));
+        }
+    }
+
+    pGL_State->Use_Program(0);
+    pGL_State->Set_Combine(0, NULL);
+
+    cSurface_Batch::Draw_Quads(reinterpret_cast<const char*>(&vertices[0]), 0, static_cast<GLsizei>(vertices.size()));
+}
+
+/* *** *** *** *** *** *** cParticle_Shader *** *** *** *** *** *** *** *** *** *** *** */
+
+/* the corner is transformed like cSurface_Batch::Add_Quad() does
+ * with the last rotation applied first
+*/
+static const char* particle_vertex_shader =
+    "#version 110\n"
+    "attribute vec2 corner;\n"
+    "attribute vec3 instance_pos;\n"
+    "attribute vec3 instance_rot;\n"
+    "attribute float instance_scale;\n"
+    "attribute vec4 instance_color;\n"
+    "uniform vec2 half_size;\n"
+    "uniform vec4 tex_rect;\n"
+    "uniform float pos_z;\n"
+    "varying vec4 combine_color;\n"
+    "void main()\n"
+    "{\n"
+    "    vec3 rad = radians(instance_rot);\n"
+    "    vec3 p = vec3(corner * half_size, 0.0);\n"
+    "    p.xy = vec2(cos(rad.z) * p.x - sin(rad.z) * p.y, sin(rad.z) * p.x + cos(rad.z) * p.y);\n"
+    "    p.zx = vec2(cos(rad.y) * p.z - sin(rad.y) * p.x, sin(rad.y) * p.z + cos(rad.y) * p.x);\n"
+    "    p.yz = vec2(cos(rad.x) * p.y - sin(rad.x) * p.z, sin(rad.x) * p.y + cos(rad.x) * p.z);\n"
+    "    p.xy = p.xy * instance_scale + instance_pos.xy;\n"
+    "    p.z += pos_z + instance_pos.z;\n"
+    "    gl_Position = gl_ModelViewProjectionMatrix * vec4(p, 1.0);\n"
+    "    gl_TexCoord[0] = vec4(mix(tex_rect.xy, tex_rect.zw, corner * 0.5 + 0.5), 0.0, 1.0);\n"
+    "    gl_FrontColor = instance_color;\n"
+    "    combine_color = vec4(0.0);\n"
+    "}\n";
+
+// Return true if instanced arrays are supported in the core or as extensions
+static bool Has_Instanced_Arrays(void)
+{
+    return GLEW_VERSION_3_3 || (GLEW_ARB_instanced_arrays && GLEW_ARB_draw_instanced);
+}
+
+// Set how many instances use the same attribute value or 0 to advance per vertex
+static void Set_Attrib_Divisor(GLuint index, GLuint divisor)
+{
+    if (GLEW_VERSION_3_3) {
+        glVertexAttribDivisor(index, divisor);
+    }
+    else {
+        glVertexAttribDivisorARB(index, divisor);
+    }
+}
+
+// Enable the instance attribute read from the bound buffer
+static void Enable_Instance_Attrib(GLint location, GLint size, GLenum type, GLboolean normalized, size_t offset)
+{
+    glEnableVertexAttribArray(location);
+    glVertexAttribPointer(location, size, type, normalized, sizeof(cParticle_Request::Instance), reinterpret_cast<const GLvoid*>(offset));
+    Set_Attrib_Divisor(location, 1);
+}
+
+// Disable the instance attribute and reset its divisor as it is not part of the program
+static void Disable_Instance_Attrib(GLint location)
+{
+    Set_Attrib_Divisor(location, 0);
+    glDisableVertexAttribArray(location);
+}
+
+cParticle_Shader::cParticle_Shader(void)
+{
+    m_program = 0;
+    m_corner_buffer = 0;
+    m_instance_buffer = 0;
+    m_pos_location = -1;
+    m_rot_location = -1;
+    m_scale_location = -1;
+    m_color_location = -1;
+    m_half_size_location = -1;
+    m_tex_rect_location = -1;
+    m_pos_z_location = -1;
+    m_state = 0;
+}
+
+cParticle_Shader::~cParticle_Shader(void)
+{
+    if (m_state <= 0) {
+        return;
+    }
+
+    if (glIsProgram(m_program)) {
+        glDeleteProgram(m_program);
+    }
+    if (glIsBuffer(m_corner_buffer)) {
+        glDeleteBuffers(1, &m_corner_buffer);
+    }
+    if (glIsBuffer(m_instance_buffer)) {
+        glDeleteBuffers(1, &m_instance_buffer);
+    }
+}
+
+bool cParticle_Shader::Init(void)
+{
+    if (m_state) {
+        return m_state > 0;
+    }
+
+    m_state = -1;
+
+    if (!GLEW_VERSION_2_0 || !Has_Instanced_Arrays()) {
+        cerr << "Info : Instanced arrays not available, drawing particles as quads" << endl;
+        return 0;
+    }
+
+    m_program = Create_Program(particle_vertex_shader, surface_fragment_shader, "Particle", "corner");
+
+    if (!m_program) {
+        return 0;
+    }
+
+    m_pos_location = glGetAttribLocation(m_program, "instance_pos");
+    m_rot_location = glGetAttribLocation(m_program, "instance_rot");
+    m_scale_location = glGetAttribLocation(m_program, "instance_scale");
+    m_color_location = glGetAttribLocation(m_program, "instance_color");
+    m_half_size_location = glGetUniformLocation(m_program, "half_size");
+    m_tex_rect_location = glGetUniformLocation(m_program, "tex_rect");
+    m_pos_z_location = glGetUniformLocation(m_program, "pos_z");
+
+    if (m_pos_location < 0 || m_rot_location < 0 || m_scale_location < 0 || m_color_location < 0) {
+        cerr << "Warning : Particle shader is missing instance attributes" << endl;
+
+        glDeleteProgram(m_program);
+        m_program = 0;
+        return 0;
+    }
+
+    // top left, top right, bottom right and bottom left
+    static const GLfloat corners[8] = {
+        -1.0f, -1.0f,
+        1.0f, -1.0f,
+        1.0f, 1.0f,
+        -1.0f, 1.0f
+    };
+
+    glGenBuffers(1, &m_corner_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_corner_buffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glGenBuffers(1, &m_instance_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_state = 1;
+    return 1;
+}
+
+void cParticle_Shader::Draw(const cParticle_Request& request)
+{
+    const GLsizei count = static_cast<GLsizei>(request.m_instances.size());
+
+    pGL_State->Use_Program(m_program);
+    glUniform2f(m_half_size_location, request.m_w / 2, request.m_h / 2);
+    glUniform4f(m_tex_rect_location, request.m_tex_x1, request.m_tex_y1, request.m_tex_x2, request.m_tex_y2);
+    glUniform1f(m_pos_z_location, request.m_pos_z);
+
+    // corners advance per vertex
+    glBindBuffer(GL_ARRAY_BUFFER, m_corner_buffer);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+
+    // replace the whole storage so the driver does not wait for the previous draw
+    glBindBuffer(GL_ARRAY_BUFFER, m_instance_buffer);
+    glBufferData(GL_ARRAY_BUFFER, count * sizeof(cParticle_Request::Instance), &request.m_instances[0], GL_STREAM_DRAW);
+
+    Enable_Instance_Attrib(m_pos_location, 3, GL_FLOAT, GL_FALSE, offsetof(cParticle_Request::Instance, m_x));
+    Enable_Instance_Attrib(m_rot_location, 3, GL_FLOAT, GL_FALSE, offsetof(cParticle_Request::Instance, m_rot_x));
+    Enable_Instance_Attrib(m_scale_location, 1, GL_FLOAT, GL_FALSE, offsetof(cParticle_Request::Instance, m_scale));
+    Enable_Instance_Attrib(m_color_location, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(cParticle_Request::Instance, m_color));
+
+    if (GLEW_VERSION_3_3) {
+        glDrawArraysInstanced(GL_QUADS, 0, 4, count);
+    }
+    else {
+        glDrawArraysInstancedARB(GL_QUADS, 0, 4, count);
+    }
+
+    Disable_Instance_Attrib(m_color_location);
+    Disable_Instance_Attrib(m_scale_location);
+    Disable_Instance_Attrib(m_rot_location);
+    Disable_Instance_Attrib(m_pos_location);
+    glDisableVertexAttribArray(0);
+
+    // CEGUI and SFML use client side arrays
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/* *** *** *** *** *** *** cRenderQueue *** *** *** *** *** *** *** *** *** *** *** */
+
+float cRenderQueue::m_camera_x = 0.0f;
+float cRenderQueue::m_camera_y = 0.0f;
+
+cRenderQueue::cRenderQueue(unsigned int reserve_items)
+{
+    m_render_data.reserve(reserve_items);
+    m_camera_captured = 0;
+    m_captured_camera_x = 0.0f;
+    m_captured_camera_y = 0.0f;
+}
+
+cRenderQueue::~cRenderQueue(void)
+{
+    Clear();
+}
+
+void cRenderQueue::Add(cRender_Request* obj)
+{
+    if (!obj) {
+        return;
+    }
+
+    // if no type
+    if (obj->m_type == REND_NOTHING) {
+        delete obj;
+        return;
+    }
+    else {
+        // Add to normal render queue
+        m_render_data.push_back(obj);
+    }
+}
+
+/**
+ * Executes all render requests collected via Add(). SFML text elements are
+ * rendered at the end of the rendering process, because this allows to
+ * perform the OpenGL state saving required by the switch from raw OpenGL
+ * to SFML just once here instead of once per text element. As a side effect
+ * this causes all text elements to always render on top of the normal
+ * stuff, but since texts are meant to be read by the user, this is what
+ * is wanted in any case.
+ */
+void cRenderQueue::Render(bool clear /* = 1 */)
+{
+    if (!m_camera_captured) {
+        Capture_Camera();
+    }
+
+    m_camera_x = m_captured_camera_x;
+    m_camera_y = m_captured_camera_y;
+    m_camera_captured = 0;
+
+    // z position sort
+    Sort();
+    // the state was changed outside of the renderer
+    pGL_State->New_Frame();
+    pGL_State->Reset();
+
+    const bool batch = pPreferences->m_video_batch_rendering;
+
+    for (RenderList::iterator itr = m_render_data.begin(); itr != m_render_data.end(); ++itr) {
+        cRender_Request* obj = (*itr);
+
+        // collect consecutive surfaces
+        if (batch && obj->m_type == REND_SURFACE) {
+            static_cast<cSurface_Request*>(obj)->Batch(m_surface_batch);
         }
-        // increment
         else {
-            ++itr;
+            m_surface_batch.Flush();
+            obj->Draw();
         }
+
+        obj->m_render_count--;
+    }
+
+    m_surface_batch.Flush();
+    // CEGUI and the texture loading expect the default state
+    pGL_State->Restore_Defaults();
+
+    if (clear) {
+        Clear(0);
+    }
+}
+
+void cRenderQueue::Sort(void)
+{
+    const size_t count = m_render_data.size();
+
+    if (count < 2) {
+        return;
     }
 
-    for (std::vector<cText_Request*>::iterator itr = m_text_render_data.begin(); itr != m_text_render_data.end();) {
-        cText_Request* obj = (*itr);
+    m_sort_entries.resize(count);
+    m_sort_buffer.resize(count);
+
+    // byte counts of every pass
+    size_t counts[8][256];
+    memset(counts, 0, sizeof(counts));
+
+    for (size_t i = 0; i < count; i++) {
+        const uint64_t key = Get_Sort_Key(m_render_data[i], i);
+
+        m_sort_entries[i].m_key = key;
+        m_sort_entries[i].m_request = m_render_data[i];
+
+        for (unsigned int pass = 0; pass < 8; pass++) {
+            counts[pass][(key >> (pass * 8)) & 0xFF]++;
+        }
+    }
+
+    // least significant byte first, every pass keeps the order of equal bytes
+    for (unsigned int pass = 0; pass < 8; pass++) {
+        const unsigned int shift = pass * 8;
+        size_t* pass_counts = counts[pass];
+
+        // all keys have the same byte
+        if (pass_counts[(m_sort_entries[0].m_key >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        // start positions
+        size_t offset = 0;
+
+        for (unsigned int i = 0; i < 256; i++) {
+            const size_t byte_count = pass_counts[i];
+            pass_counts[i] = offset;
+            offset += byte_count;
+        }
+
+        for (Sort_Entry_List::const_iterator itr = m_sort_entries.begin(); itr != m_sort_entries.end(); ++itr) {
+            m_sort_buffer[pass_counts[(itr->m_key >> shift) & 0xFF]++] = *itr;
+        }
+
+        m_sort_entries.swap(m_sort_buffer);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        m_render_data[i] = m_sort_entries[i].m_request;
+    }
+}
+
+void cRenderQueue::Fake_Render(unsigned int amount /* = 1 */, bool clear /* = 1 */)
+{
+    for (RenderList::iterator itr = m_render_data.begin(); itr != m_render_data.end(); ++itr) {
+        cRender_Request* obj = (*itr);
+        obj->m_render_count -= amount;
+    }
+
+    if (clear) {
+        Clear(0);
+    }
+}
+
+void cRenderQueue::Clear(bool force /* = 1 */)
+{
+    // keep the unfinished requests in order at the front
+    RenderList::iterator keep_itr = m_render_data.begin();
+
+    for (RenderList::iterator itr = m_render_data.begin(); itr != m_render_data.end(); ++itr) {
+        cRender_Request* obj = (*itr);
 
         // if forced or finished rendering
         if (force || obj->m_render_count <= 0) {
-            itr = m_text_render_data.erase(itr);
             delete obj;
         }
-        // increment
         else {
-            ++itr;
+            *keep_itr = obj;
+            ++keep_itr;
         }
     }
+
+    m_render_data.erase(keep_itr, m_render_data.end());
+}
+
+void cRenderQueue::Take_Over(cRenderQueue& queue)
+{
+    if (&queue == this) {
+        return;
+    }
+
+    if (!queue.m_render_data.empty()) {
+        m_render_data.insert(m_render_data.begin(), queue.m_render_data.begin(), queue.m_render_data.end());
+        queue.m_render_data.clear();
+    }
+}
+
+void cRenderQueue::Capture_Camera(void)
+{
+    m_captured_camera_x = pActive_Camera->m_x;
+    m_captured_camera_y = pActive_Camera->m_y;
+    m_camera_captured = 1;
 }
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
+cGL_State* pGL_State = NULL;
+cSurface_Shader* pSurface_Shader = NULL;
+cParticle_Shader* pParticle_Shader = NULL;
 cRenderQueue* pRenderer = NULL;
 cRenderQueue* pRenderer_current = NULL;
 
@@ -33,7 +33,156 @@ namespace TSC {
         REND_SURFACE = 4,
         REND_TEXT = 5,
         REND_LINE = 6,
-        REND_CIRCLE = 7
+        REND_CIRCLE = 7,
+        REND_GEOMETRY = 8,
+        REND_PARTICLES = 9
+    };
+
+    /* *** *** *** *** *** *** cRender_Arena *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Bump allocator for the render requests
+     * Requests are placed one after another into big blocks and every
+     * block counts its requests which are not deleted yet. A block is
+     * reused as a whole once all its requests are deleted, which after
+     * rendering a frame is the case for everything but requests with a
+     * render count above 1. These only keep their block from being
+     * reused until they are deleted too.
+     *
+     * Allocating must be done from the main thread but requests can be
+     * deleted from the render thread.
+     */
+    class cRender_Arena {
+    public:
+        cRender_Arena(void);
+        ~cRender_Arena(void);
+
+        // Return memory for a request
+        void* Allocate(size_t size);
+        // Give back the memory of a deleted request
+        static void Release(void* ptr);
+
+    private:
+        struct Block {
+            // requests in this block which are not deleted yet
+            std::atomic<unsigned int> m_live;
+            // used bytes
+            size_t m_used;
+            unsigned char* m_data;
+        };
+        typedef vector<Block*> Block_List;
+
+        // Return a block without requests which is not the current one
+        Block* Get_Free_Block(void);
+
+        // size of a block in bytes
+        static const size_t m_block_size = 65536;
+        /* space in front of every request for its block pointer
+         * also keeps the requests aligned
+        */
+        static const size_t m_header_size = 16;
+
+        Block_List m_blocks;
+        // block new requests are placed in
+        Block* m_current;
+    };
+
+    /* *** *** *** *** *** *** cGL_State *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Shadows the OpenGL state changed by the render requests
+     * A change is only passed to OpenGL if it differs from the tracked
+     * value. The requests set the state they need instead of clearing it
+     * again after drawing. Everything else changing the state directly
+     * (CEGUI, SFML, texture loading) runs outside of the render queue,
+     * which resets the tracking before rendering and restores the
+     * default state afterwards.
+     */
+    class cGL_State {
+    public:
+        cGL_State(void);
+        ~cGL_State(void);
+
+        // Forget the tracked state so the next change of everything is issued
+        void Reset(void);
+        // Set the default blending, texture environment and color
+        void Restore_Defaults(void);
+
+        // Bind the 2D texture
+        void Bind_Texture(GLuint texture_id);
+        // Enable or disable GL_TEXTURE_2D
+        void Enable_Texture(bool enable);
+        // Set the blend function
+        void Set_Blend_Func(GLenum sfactor, GLenum dfactor);
+        /* Set the texture environment color combination
+         * combine_type : GL_ADD, GL_MODULATE or GL_REPLACE with the constant color or 0 to only modulate
+        */
+        void Set_Combine(GLint combine_type, const float* combine_color);
+        // Set the current color
+        void Set_Color(const Color& color);
+        // Use the program or 0 for the fixed function pipeline
+        void Use_Program(GLuint program);
+        // The current color is undefined after drawing with a color array
+        inline void Invalidate_Color(void)
+        {
+            m_valid &= ~STATE_COLOR;
+        }
+
+        // Start counting the state changes of a new frame
+        void New_Frame(void);
+        // Return the state changes issued in the last frame
+        inline unsigned int Get_Issued(void) const
+        {
+            return m_last_issued;
+        }
+        // Return the state changes skipped in the last frame
+        inline unsigned int Get_Skipped(void) const
+        {
+            return m_last_skipped;
+        }
+
+    private:
+        enum State_Flag {
+            STATE_TEXTURE = 1,
+            STATE_TEXTURE_ENABLED = 2,
+            STATE_BLEND = 4,
+            STATE_TEX_ENV_MODE = 8,
+            STATE_COMBINE_RGB = 16,
+            STATE_COMBINE_COLOR = 32,
+            STATE_COLOR = 64,
+            STATE_PROGRAM = 128
+        };
+
+        // Return true if the state is tracked and the same, counts the change
+        inline bool Is_Same(unsigned int flag, bool same)
+        {
+            if ((m_valid & flag) && same) {
+                m_skipped++;
+                return 1;
+            }
+
+            m_valid |= flag;
+            m_issued++;
+            return 0;
+        }
+
+        // tracked state flags
+        unsigned int m_valid;
+
+        GLuint m_texture_id;
+        bool m_texture_enabled;
+        GLenum m_blend_sfactor;
+        GLenum m_blend_dfactor;
+        GLint m_tex_env_mode;
+        GLint m_combine_rgb;
+        float m_combine_color[3];
+        Color m_color;
+        GLuint m_program;
+
+        // state changes in this frame
+        unsigned int m_issued;
+        unsigned int m_skipped;
+        // state changes in the last frame
+        unsigned int m_last_issued;
+        unsigned int m_last_skipped;
     };
 
     /* *** *** *** *** *** *** cRender_Request *** *** *** *** *** *** *** *** *** *** *** */
@@ -43,8 +192,16 @@ namespace TSC {
         cRender_Request(void);
         virtual ~cRender_Request(void);
 
+        // allocate from the render arena
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr);
+
         // draw
         virtual void Draw(void);
+        /* Return the blend and texture state used to group requests with the same z position
+         * blend state in the upper 4 bits and texture in the lower 12 bits
+        */
+        virtual unsigned int Get_State_Key(void) const;
 
         // render type
         RenderType m_type;
@@ -69,6 +226,9 @@ namespace TSC {
 
     /* *** *** *** *** *** *** cText_Request *** *** *** *** *** *** *** *** *** *** *** */
 
+    /* Text drawn by SFML
+     * only used for the text styles the glyph quads of the font manager can not draw
+     */
     class cText_Request: public cRender_Request {
     public:
         cText_Request(const sf::Text& text);
@@ -76,11 +236,10 @@ namespace TSC {
 
         virtual void Draw(void);
 
-        const sf::Text& m_text;
-        sf::Vector2f m_pos;
+        // copied as the text may change while the render thread draws it
+        const sf::Text m_text;
     };
 
-
     /* *** *** *** *** *** *** cRender_Request_Advanced *** *** *** *** *** *** *** *** *** *** *** */
 
     class cRender_Request_Advanced : public cRender_Request {
@@ -90,13 +249,14 @@ namespace TSC {
 
         // render basic state
         void Render_Basic(void);
-        // clear basic render state
+        // check for errors after rendering
         void Render_Basic_Clear(void) const;
 
         // render advanced state
         void Render_Advanced(void);
-        // clear advanced render state
-        void Render_Advanced_Clear(void) const;
+
+        // Return the blend state
+        virtual unsigned int Get_State_Key(void) const;
 
         // global scale
         bool m_global_scale;
@@ -206,6 +366,8 @@ namespace TSC {
 
     /* *** *** *** *** *** *** cSurface_Request *** *** *** *** *** *** *** *** *** *** *** */
 
+    class cSurface_Batch;
+
     class cSurface_Request : public cRender_Request_Advanced {
     public:
         cSurface_Request(void);
@@ -213,9 +375,19 @@ namespace TSC {
 
         // Draw
         virtual void Draw(void);
+        // Add to the batch instead of drawing directly
+        void Batch(cSurface_Batch& batch);
+
+        // Return the blend state and texture
+        virtual unsigned int Get_State_Key(void) const;
 
         // texture id
         GLuint m_texture_id;
+        // texture coordinates
+        float m_tex_x1;
+        float m_tex_y1;
+        float m_tex_x2;
+        float m_tex_y2;
         // position
         float m_pos_x;
         float m_pos_y;
@@ -232,6 +404,234 @@ namespace TSC {
 
         // delete texture after request finished
         bool m_delete_texture;
+        /* repeat the texture for coordinates outside of 0 to 1
+         * only for textures with a power of two size if not supported otherwise
+        */
+        bool m_repeat;
+
+    private:
+        // Draw or batch the shadow with the shadow state set temporarily
+        void Render_Shadow(cSurface_Batch* batch);
+    };
+
+    /* *** *** *** *** *** *** cSurface_Shader *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* GLSL program for the batched surfaces with the color combination as a vertex attribute
+     * The output matches the fixed function GL_MODULATE texture environment
+     * and the GL_COMBINE setup of cGL_State::Set_Combine() with the constant
+     * color as the first and the texture as the second source.
+     */
+    class cSurface_Shader {
+    public:
+        cSurface_Shader(void);
+        ~cSurface_Shader(void);
+
+        /* Return true if the program can be used
+         * it is created on the first call and needs OpenGL 2.0
+        */
+        bool Init(void);
+
+        inline GLuint Get_Program(void) const
+        {
+            return m_program;
+        }
+        // Return the location of the combine vertex attribute
+        inline GLint Get_Combine_Location(void) const
+        {
+            return m_combine_location;
+        }
+
+        // Return the combine vertex attribute value of the given combine type
+        static GLubyte Get_Combine_Mode(GLint combine_type);
+
+    private:
+        GLuint m_program;
+        GLint m_combine_location;
+        // 0 if not created yet, 1 if available and -1 if not supported
+        int m_state;
+    };
+
+    /* *** *** *** *** *** *** cSurface_Batch *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Collects consecutive surface requests with the same texture, blend
+     * and combine state and draws them with one call from a streaming
+     * vertex buffer. The vertices are transformed on the CPU in the same
+     * order cSurface_Request::Draw() applies the matrices, so the output
+     * is the same as drawing every request on its own.
+     * With the surface shader the combine state is a vertex attribute and
+     * only the texture and blending have to be the same.
+     */
+    class cSurface_Batch {
+    public:
+        cSurface_Batch(void);
+        ~cSurface_Batch(void);
+
+        struct Vertex {
+            GLfloat m_x;
+            GLfloat m_y;
+            GLfloat m_z;
+            GLfloat m_u;
+            GLfloat m_v;
+            GLubyte m_color[4];
+            // combine color and mode for the surface shader
+            GLubyte m_combine[4];
+        };
+
+        /* Add the quad of the given request
+         * the collected quads are drawn first if the state is different
+        */
+        void Add(const cSurface_Request& request);
+        // Draw the collected quads
+        void Flush(void);
+
+        /* Append the 4 transformed vertices of the given request
+         * if world_space is set the camera position and the global scale are not applied
+        */
+        static void Add_Quad(vector<Vertex>& vertices, const cSurface_Request& request, bool world_space = 0);
+        /* Draw the given vertices as quads with the bound texture
+         * data is an offset into the bound vertex buffer or a client side array
+         * combine_location : location of the combine attribute of the used program or -1
+        */
+        static void Draw_Quads(const char* data, GLint first, GLsizei vertex_count, GLint combine_location = -1);
+
+    private:
+        // Return true if the request can be drawn with the collected quads
+        bool Is_Compatible(const cSurface_Request& request) const;
+
+        // collected vertices with 4 per quad
+        vector<Vertex> m_vertices;
+        // state of the collected quads
+        GLuint m_texture_id;
+        GLenum m_blend_sfactor;
+        GLenum m_blend_dfactor;
+        GLint m_combine_type;
+        float m_combine_color[3];
+        // if the collected quads are drawn with the surface shader
+        bool m_shader;
+        // if the texture is repeated
+        bool m_repeat;
+        // vertex buffer object or 0 if not created
+        GLuint m_buffer;
+    };
+
+    /* *** *** *** *** *** *** cGeometry_Request *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Draws a range of retained world space quads with one texture
+     * The vertices are owned by the caller and have to stay valid
+     * until the request is rendered.
+     */
+    class cGeometry_Request : public cRender_Request {
+    public:
+        cGeometry_Request(void);
+        virtual ~cGeometry_Request(void);
+
+        // draw
+        virtual void Draw(void);
+
+        // Return the texture
+        virtual unsigned int Get_State_Key(void) const;
+
+        // vertex buffer object or 0 to use the client side vertices
+        GLuint m_buffer;
+        const cSurface_Batch::Vertex* m_vertices;
+        // range of the quads
+        GLint m_first;
+        GLsizei m_count;
+        // texture id
+        GLuint m_texture_id;
+    };
+
+    /* *** *** *** *** *** *** cParticle_Request *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Draws all particles of an emitter with one texture and blend state
+     * Every particle is an instance of the same quad with its own
+     * position, rotation, scale and color. The request is sorted at its
+     * z position and every instance is drawn with its own offset to it.
+     * All of them are drawn with one instanced draw call if
+     * cParticle_Shader is available and with one call for the quads
+     * transformed on the CPU otherwise.
+     */
+    class cParticle_Request : public cRender_Request_Advanced {
+    public:
+        cParticle_Request(void);
+        virtual ~cParticle_Request(void);
+
+        struct Instance {
+            // center position
+            GLfloat m_x;
+            GLfloat m_y;
+            // z offset to the request position
+            GLfloat m_z;
+            // rotation in degrees
+            GLfloat m_rot_x;
+            GLfloat m_rot_y;
+            GLfloat m_rot_z;
+            GLfloat m_scale;
+            GLubyte m_color[4];
+        };
+        typedef vector<Instance> Instance_List;
+
+        // draw
+        virtual void Draw(void);
+
+        // Return the blend state and texture
+        virtual unsigned int Get_State_Key(void) const;
+
+        // texture id
+        GLuint m_texture_id;
+        // texture coordinates
+        float m_tex_x1;
+        float m_tex_y1;
+        float m_tex_x2;
+        float m_tex_y2;
+        // unscaled quad size
+        float m_w;
+        float m_h;
+
+        Instance_List m_instances;
+
+    private:
+        // Draw the instances as quads transformed on the CPU
+        void Draw_Quads(void);
+    };
+
+    /* *** *** *** *** *** *** cParticle_Shader *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* GLSL program drawing the instances of a particle request
+     * The quad corners are in a static buffer and the instances are
+     * streamed into a second buffer read once per instance. The fragment
+     * shader is the one of cSurface_Shader without color combination.
+     */
+    class cParticle_Shader {
+    public:
+        cParticle_Shader(void);
+        ~cParticle_Shader(void);
+
+        /* Return true if the program can be used
+         * it is created on the first call and needs OpenGL 2.0 with instanced arrays
+        */
+        bool Init(void);
+
+        // Draw the instances of the request with one call
+        void Draw(const cParticle_Request& request);
+
+    private:
+        GLuint m_program;
+        // quad corners
+        GLuint m_corner_buffer;
+        // streamed instances
+        GLuint m_instance_buffer;
+        // attribute locations
+        GLint m_pos_location;
+        GLint m_rot_location;
+        GLint m_scale_location;
+        GLint m_color_location;
+        // uniform locations
+        GLint m_half_size_location;
+        GLint m_tex_rect_location;
+        GLint m_pos_z_location;
+        // 0 if not created yet, 1 if available and -1 if not supported
+        int m_state;
     };
 
     /* *** *** *** *** *** *** cRenderQueue *** *** *** *** *** *** *** *** *** *** *** */
@@ -261,21 +661,54 @@ namespace TSC {
         */
         void Clear(bool force = 1);
 
+        // Move the remaining requests of the given queue in front of ours
+        void Take_Over(cRenderQueue& queue);
+        /* Save the camera position the requests are drawn with
+         * if not set the active camera is used when rendering
+        */
+        void Capture_Camera(void);
+
+        // camera position of the rendered queue
+        static float m_camera_x;
+        static float m_camera_y;
+
+        // batch for consecutive surface requests
+        cSurface_Batch m_surface_batch;
+
         // render data array
         RenderList m_render_data;
-        std::vector<cText_Request*> m_text_render_data;
 
-        // Z position sort
-        struct zpos_sort {
-            bool operator()(const cRender_Request* a, const cRender_Request* b) const
-            {
-                return a->m_pos_z < b->m_pos_z;
-            }
+    private:
+        // request with its sort key
+        struct Sort_Entry {
+            uint64_t m_key;
+            cRender_Request* m_request;
         };
+        typedef vector<Sort_Entry> Sort_Entry_List;
+
+        /* Sort the render data by z position, blend state, texture and submission order
+         * uses a radix sort on 64-bit keys
+        */
+        void Sort(void);
+
+        // reused sort buffers
+        Sort_Entry_List m_sort_entries;
+        Sort_Entry_List m_sort_buffer;
+
+        // captured camera position
+        bool m_camera_captured;
+        float m_captured_camera_x;
+        float m_captured_camera_y;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
+// OpenGL state of the renderer
+    extern cGL_State* pGL_State;
+// Shader for the batched surfaces
+    extern cSurface_Shader* pSurface_Shader;
+// Shader for the instanced particles
+    extern cParticle_Shader* pParticle_Shader;
 // Renderer class
     extern cRenderQueue* pRenderer;
     extern cRenderQueue* pRenderer_current;
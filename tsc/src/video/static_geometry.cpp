@@ -0,0 +1,400 @@
+/***************************************************************************
+ * static_geometry.cpp  -  Retained vertex buffers for the static level tiles
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/static_geometry.hpp"
+#include "../video/gl_surface.hpp"
+#include "../video/video.hpp"
+#include "../objects/sprite.hpp"
+#include "../user/preferences.hpp"
+#include "../core/game_core.hpp"
+#include "../core/global_basic.hpp"
+
+using namespace std;
+
+namespace TSC {
+
+/* *** *** *** *** *** cStatic_Geometry *** *** *** *** *** *** *** *** *** *** *** *** */
+
+const float cStatic_Geometry::m_chunk_size = 1024.0f;
+const float cStatic_Geometry::m_z_band = 0.001f;
+unsigned int cStatic_Geometry::m_texture_generation = 0;
+
+cStatic_Geometry::cStatic_Geometry(void)
+{
+    m_editor_enabled = editor_enabled;
+    m_generation = m_texture_generation;
+}
+
+cStatic_Geometry::~cStatic_Geometry(void)
+{
+    Clear();
+}
+
+bool cStatic_Geometry::Is_Static(const cSprite* obj)
+{
+    // derived types draw themselves
+    if (typeid(*obj) != typeid(cSprite)) {
+        return 0;
+    }
+
+    return obj->Is_Static_Collision();
+}
+
+void cStatic_Geometry::Insert(const cSprite* obj)
+{
+    if (!Is_Static(obj) || m_sprites.find(obj) != m_sprites.end()) {
+        return;
+    }
+
+    const Chunk_Key key = Get_Chunk_Key(obj);
+
+    m_chunks[key].m_sprites.push_back(obj);
+
+    Sprite_Entry& entry = m_sprites[obj];
+    entry.m_chunk = key;
+    entry.m_cached = 0;
+
+    Mark_Dirty(key);
+}
+
+void cStatic_Geometry::Remove(const cSprite* obj)
+{
+    Sprite_Map::iterator itr = m_sprites.find(obj);
+
+    if (itr == m_sprites.end()) {
+        return;
+    }
+
+    Chunk& chunk = m_chunks[itr->second.m_chunk];
+    chunk.m_sprites.erase(std::find(chunk.m_sprites.begin(), chunk.m_sprites.end(), obj));
+
+    // empty chunks are deleted by the rebuild
+    if (itr->second.m_cached || chunk.m_sprites.empty()) {
+        Mark_Dirty(itr->second.m_chunk);
+    }
+
+    m_sprites.erase(itr);
+}
+
+void cStatic_Geometry::Update(const cSprite* obj)
+{
+    Sprite_Map::iterator itr = m_sprites.find(obj);
+
+    if (itr == m_sprites.end()) {
+        Insert(obj);
+        return;
+    }
+
+    if (!Is_Static(obj)) {
+        Remove(obj);
+        return;
+    }
+
+    Sprite_Entry& entry = itr->second;
+    const Chunk_Key key = Get_Chunk_Key(obj);
+
+    // moved into another chunk
+    if (key != entry.m_chunk) {
+        Remove(obj);
+        Insert(obj);
+        return;
+    }
+
+    // only matters if drawn by the chunk now or afterwards
+    if (!entry.m_cached) {
+        cSurface_Request request;
+
+        if (!Get_Request(obj, request)) {
+            return;
+        }
+    }
+
+    Mark_Dirty(key);
+}
+
+void cStatic_Geometry::Clear(void)
+{
+    for (Chunk_Map::iterator itr = m_chunks.begin(); itr != m_chunks.end(); ++itr) {
+        Delete_Buffer(itr->second);
+    }
+
+    m_chunks.clear();
+    m_sprites.clear();
+    m_dirty_chunks.clear();
+}
+
+void cStatic_Geometry::Invalidate_All(void)
+{
+    m_texture_generation++;
+}
+
+bool cStatic_Geometry::Is_Enabled(void) const
+{
+    // debug mode draws the rects of every sprite
+    return pPreferences->m_video_batch_rendering && !game_debug;
+}
+
+void cStatic_Geometry::Draw(const GL_rect& rect, const vector<float>& dynamic_z)
+{
+    // the texture ids changed and the buffers may be lost with the context
+    if (m_generation != m_texture_generation) {
+        m_generation = m_texture_generation;
+
+        for (Chunk_Map::iterator itr = m_chunks.begin(); itr != m_chunks.end(); ++itr) {
+            Delete_Buffer(itr->second);
+            Mark_Dirty(itr->first);
+        }
+    }
+
+    // the editor draws the start state
+    if (m_editor_enabled != editor_enabled) {
+        m_editor_enabled = editor_enabled;
+
+        for (Chunk_Map::iterator itr = m_chunks.begin(); itr != m_chunks.end(); ++itr) {
+            Mark_Dirty(itr->first);
+        }
+    }
+
+    for (vector<Chunk_Key>::iterator itr = m_dirty_chunks.begin(); itr != m_dirty_chunks.end(); ++itr) {
+        Chunk_Map::iterator chunk_itr = m_chunks.find(*itr);
+
+        if (chunk_itr == m_chunks.end()) {
+            continue;
+        }
+
+        Chunk& chunk = chunk_itr->second;
+
+        if (chunk.m_sprites.empty()) {
+            Delete_Buffer(chunk);
+            m_chunks.erase(chunk_itr);
+            continue;
+        }
+
+        Build(chunk);
+    }
+
+    m_dirty_chunks.clear();
+
+    for (Chunk_Map::iterator itr = m_chunks.begin(); itr != m_chunks.end(); ++itr) {
+        Chunk& chunk = itr->second;
+
+        if (chunk.m_groups.empty() || !chunk.m_rect.Intersects(rect)) {
+            continue;
+        }
+
+        for (vector<Group>::const_iterator group_itr = chunk.m_groups.begin(); group_itr != chunk.m_groups.end(); ++group_itr) {
+            size_t first = group_itr->m_first / 4;
+            const size_t last = first + (group_itr->m_count / 4);
+
+            /* split before the quads above a dynamic object inside the z range
+             * the quads are sorted by z and every request is sorted at its first quad
+            */
+            while (first < last) {
+                size_t end = last;
+                vector<float>::const_iterator dynamic_itr = std::upper_bound(dynamic_z.begin(), dynamic_z.end(), chunk.m_quad_z[first]);
+
+                if (dynamic_itr != dynamic_z.end() && *dynamic_itr < chunk.m_quad_z[last - 1]) {
+                    end = std::upper_bound(chunk.m_quad_z.begin() + first, chunk.m_quad_z.begin() + last, *dynamic_itr) - chunk.m_quad_z.begin();
+                }
+
+                Add_Request(chunk, *group_itr, first, end);
+                first = end;
+            }
+        }
+    }
+}
+
+void cStatic_Geometry::Add_Request(const Chunk& chunk, const Group& group, size_t first_quad, size_t last_quad) const
+{
+    // create request
+    cGeometry_Request* request = new cGeometry_Request();
+
+    request->m_buffer = chunk.m_buffer;
+    request->m_vertices = chunk.m_buffer ? NULL : &chunk.m_vertices[0];
+    request->m_first = static_cast<GLint>(first_quad * 4);
+    request->m_count = static_cast<GLsizei>((last_quad - first_quad) * 4);
+    request->m_texture_id = group.m_texture_id;
+    request->m_pos_z = chunk.m_quad_z[first_quad];
+
+    // add request
+    pRenderer->Add(request);
+}
+
+cStatic_Geometry::Chunk_Key cStatic_Geometry::Get_Chunk_Key(const cSprite* obj)
+{
+    const int32_t col = static_cast<int32_t>(floor(obj->m_rect.m_x / m_chunk_size));
+    const int32_t row = static_cast<int32_t>(floor(obj->m_rect.m_y / m_chunk_size));
+
+    return (static_cast<Chunk_Key>(static_cast<uint32_t>(col)) << 32) | static_cast<uint32_t>(row);
+}
+
+bool cStatic_Geometry::Get_Request(const cSprite* obj, cSurface_Request& request)
+{
+    // the image changes
+    if (obj->m_anim_enabled) {
+        return 0;
+    }
+
+    // the same checks as cSprite::Is_Draw_Valid() without the screen
+    if (editor_enabled) {
+        if (obj->m_auto_destroy || !obj->m_start_image) {
+            return 0;
+        }
+
+        // obsolete images are marked by cSprite::Draw()
+        if (obj->m_image && obj->m_image->m_obsolete) {
+            return 0;
+        }
+
+        obj->Draw_Image_Editor(&request);
+    }
+    else {
+        if (!obj->m_active || !obj->m_image) {
+            return 0;
+        }
+
+        obj->Draw_Image_Normal(&request);
+    }
+
+    // only the default state can be drawn together
+    if (request.m_no_camera || !request.m_global_scale || request.m_shadow_pos || request.m_combine_type) {
+        return 0;
+    }
+
+    if (request.m_blend_sfactor != GL_SRC_ALPHA || request.m_blend_dfactor != GL_ONE_MINUS_SRC_ALPHA) {
+        return 0;
+    }
+
+    return 1;
+}
+
+void cStatic_Geometry::Mark_Dirty(Chunk_Key key)
+{
+    Chunk& chunk = m_chunks[key];
+
+    if (chunk.m_dirty) {
+        return;
+    }
+
+    chunk.m_dirty = 1;
+    m_dirty_chunks.push_back(key);
+}
+
+void cStatic_Geometry::Build(Chunk& chunk)
+{
+    // the render thread may still draw the old vertices
+    pVideo->Render_Finish();
+
+    chunk.m_dirty = 0;
+    chunk.m_groups.clear();
+    chunk.m_vertices.clear();
+    chunk.m_quad_z.clear();
+
+    // the requests must not move while sorting
+    m_build_requests.clear();
+    m_build_requests.reserve(chunk.m_sprites.size());
+    m_build_order.clear();
+
+    for (vector<const cSprite*>::const_iterator itr = chunk.m_sprites.begin(); itr != chunk.m_sprites.end(); ++itr) {
+        Sprite_Entry& entry = m_sprites[*itr];
+
+        m_build_requests.push_back(cSurface_Request());
+        entry.m_cached = Get_Request(*itr, m_build_requests.back());
+
+        if (!entry.m_cached) {
+            m_build_requests.pop_back();
+            continue;
+        }
+
+        m_build_order.push_back(&m_build_requests.back());
+    }
+
+    // equal z positions keep the array order like the render queue
+    std::stable_sort(m_build_order.begin(), m_build_order.end(), zpos_sort());
+
+    for (vector<const cSurface_Request*>::const_iterator itr = m_build_order.begin(); itr != m_build_order.end(); ++itr) {
+        const cSurface_Request* request = (*itr);
+
+        // new group if the texture or z band changes
+        if (chunk.m_groups.empty() || chunk.m_groups.back().m_texture_id != request->m_texture_id ||
+                floor(chunk.m_groups.back().m_pos_z / m_z_band) != floor(request->m_pos_z / m_z_band)) {
+            Group group;
+            group.m_texture_id = request->m_texture_id;
+            group.m_pos_z = request->m_pos_z;
+            group.m_first = static_cast<GLint>(chunk.m_vertices.size());
+            group.m_count = 0;
+
+            chunk.m_groups.push_back(group);
+        }
+
+        cSurface_Batch::Add_Quad(chunk.m_vertices, *request, 1);
+        chunk.m_quad_z.push_back(request->m_pos_z);
+        chunk.m_groups.back().m_count += 4;
+    }
+
+    m_build_requests.clear();
+    m_build_order.clear();
+
+    if (chunk.m_vertices.empty()) {
+        Delete_Buffer(chunk);
+        return;
+    }
+
+    // bounds of the quads as rotations can exceed the sprite rect
+    float min_x = chunk.m_vertices[0].m_x;
+    float min_y = chunk.m_vertices[0].m_y;
+    float max_x = min_x;
+    float max_y = min_y;
+
+    for (vector<cSurface_Batch::Vertex>::const_iterator itr = chunk.m_vertices.begin(); itr != chunk.m_vertices.end(); ++itr) {
+        min_x = std::min(min_x, itr->m_x);
+        min_y = std::min(min_y, itr->m_y);
+        max_x = std::max(max_x, itr->m_x);
+        max_y = std::max(max_y, itr->m_y);
+    }
+
+    chunk.m_rect = GL_rect(min_x, min_y, max_x - min_x, max_y - min_y);
+
+    // keep the quads in video memory if available (OpenGL 1.5)
+    if (GLEW_VERSION_1_5) {
+        if (!chunk.m_buffer) {
+            glGenBuffers(1, &chunk.m_buffer);
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, chunk.m_buffer);
+        glBufferData(GL_ARRAY_BUFFER, chunk.m_vertices.size() * sizeof(cSurface_Batch::Vertex), &chunk.m_vertices[0], GL_STATIC_DRAW);
+        // CEGUI and SFML use client side arrays
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        vector<cSurface_Batch::Vertex>().swap(chunk.m_vertices);
+    }
+}
+
+void cStatic_Geometry::Delete_Buffer(Chunk& chunk)
+{
+    pVideo->Render_Finish();
+
+    if (chunk.m_buffer && glIsBuffer(chunk.m_buffer)) {
+        glDeleteBuffers(1, &chunk.m_buffer);
+    }
+
+    chunk.m_buffer = 0;
+    chunk.m_groups.clear();
+    chunk.m_quad_z.clear();
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
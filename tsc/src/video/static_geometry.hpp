@@ -0,0 +1,161 @@
+/***************************************************************************
+ * static_geometry.h  -  Retained vertex buffers for the static level tiles
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_STATIC_GEOMETRY_HPP
+#define TSC_STATIC_GEOMETRY_HPP
+
+#include "../core/global_basic.hpp"
+#include "../core/global_game.hpp"
+#include "../video/renderer.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** cStatic_Geometry *** *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Keeps the quads of the static level tiles in vertex buffers
+     *
+     * The tiles are sorted into square world space chunks by their
+     * position. A chunk holds the transformed quads of its tiles in
+     * world space, ordered by the z position and split into groups of
+     * consecutive tiles with the same texture and z band. Drawing adds
+     * one request per group of the chunks on the screen and the camera
+     * is applied as a translation. A group is split where another drawn
+     * object is inside its z range so both are still drawn in z order.
+     * A chunk is only rebuilt if one of its tiles changed.
+     */
+    class cStatic_Geometry {
+    public:
+        cStatic_Geometry(void);
+        ~cStatic_Geometry(void);
+
+        // Return true if the sprite belongs into a chunk
+        static bool Is_Static(const cSprite* obj);
+
+        // Add the sprite if it is static
+        void Insert(const cSprite* obj);
+        // Remove the sprite if added
+        void Remove(const cSprite* obj);
+        /* Mark the chunk of the sprite dirty after its drawing changed
+         * moves it into the chunk of its new position and adds or removes it if it became static or not
+        */
+        void Update(const cSprite* obj);
+        // Remove all sprites and delete the buffers
+        void Clear(void);
+        /* Rebuild the chunks of all instances before their next draw
+         * must be called if the textures or the OpenGL context were recreated
+        */
+        static void Invalidate_All(void);
+
+        // Return true if the sprites should be drawn from the chunks
+        bool Is_Enabled(void) const;
+        // Return true if the sprite is drawn by its chunk
+        inline bool Is_Cached(const cSprite* obj) const
+        {
+            Sprite_Map::const_iterator itr = m_sprites.find(obj);
+            return itr != m_sprites.end() && itr->second.m_cached;
+        }
+
+        /* Rebuild the dirty chunks and add the groups of the chunks in the given rect to the renderer
+         * dynamic_z : sorted z positions of the other objects drawn
+        */
+        void Draw(const GL_rect& rect, const vector<float>& dynamic_z);
+
+        // width and height of a chunk
+        static const float m_chunk_size;
+        // z range of a group
+        static const float m_z_band;
+
+    private:
+        // chunk column and row
+        typedef uint64_t Chunk_Key;
+
+        // consecutive quads with the same texture and z band
+        struct Group {
+            GLuint m_texture_id;
+            // z position of the first quad
+            float m_pos_z;
+            GLint m_first;
+            GLsizei m_count;
+        };
+
+        struct Chunk {
+            Chunk(void)
+                : m_buffer(0), m_dirty(0) {}
+
+            vector<const cSprite*> m_sprites;
+            vector<Group> m_groups;
+            vector<cSurface_Batch::Vertex> m_vertices;
+            // z position of every quad
+            vector<float> m_quad_z;
+            // vertex buffer object or 0 if not available
+            GLuint m_buffer;
+            // bounds of the quads
+            GL_rect m_rect;
+            bool m_dirty;
+        };
+        typedef std::unordered_map<Chunk_Key, Chunk> Chunk_Map;
+
+        struct Sprite_Entry {
+            Chunk_Key m_chunk;
+            // if drawn by the chunk since the last build
+            bool m_cached;
+        };
+        typedef std::unordered_map<const cSprite*, Sprite_Entry> Sprite_Map;
+
+        // Return the chunk for the position of the sprite
+        static Chunk_Key Get_Chunk_Key(const cSprite* obj);
+        /* Fill the request for the sprite as drawn in the current mode
+         * returns false if the sprite can not be drawn from a chunk in its current state
+        */
+        static bool Get_Request(const cSprite* obj, cSurface_Request& request);
+
+        // Add the request for the given quads of the group
+        void Add_Request(const Chunk& chunk, const Group& group, size_t first_quad, size_t last_quad) const;
+        // Mark the chunk dirty
+        void Mark_Dirty(Chunk_Key key);
+        // Rebuild the quads and groups of the chunk
+        void Build(Chunk& chunk);
+        // Delete the vertex buffer of the chunk
+        void Delete_Buffer(Chunk& chunk);
+
+        Chunk_Map m_chunks;
+        Sprite_Map m_sprites;
+        // chunks to rebuild before the next draw
+        vector<Chunk_Key> m_dirty_chunks;
+        // editor mode of the last build
+        bool m_editor_enabled;
+        // texture generation of the last build
+        unsigned int m_generation;
+        // increased by Invalidate_All()
+        static unsigned int m_texture_generation;
+
+        // Z position sort
+        struct zpos_sort {
+            bool operator()(const cSurface_Request* a, const cSurface_Request* b) const
+            {
+                return a->m_pos_z < b->m_pos_z;
+            }
+        };
+
+        // reused build buffers
+        vector<cSurface_Request> m_build_requests;
+        vector<const cSurface_Request*> m_build_order;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
@@ -0,0 +1,361 @@
+/***************************************************************************
+ * texture_atlas.cpp  -  Image cache texture atlas pages
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/texture_atlas.hpp"
+#include "../video/video.hpp"
+#include "../video/gl_surface.hpp"
+#include "../video/img_manager.hpp"
+#include "../user/preferences.hpp"
+#include "../core/math/utilities.hpp"
+#include "../core/math/size.hpp"
+#include "../core/property_helper.hpp"
+#include "../core/filesystem/filesystem.hpp"
+#include "../core/filesystem/resource_manager.hpp"
+#include "../core/filesystem/relative.hpp"
+#include "../core/global_basic.hpp"
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace TSC {
+
+// table with the position of every image in the pages of a directory
+static const char* atlas_table_filename = "_atlas.txt";
+
+// Return the file name of the given page
+static fs::path Get_Atlas_Page_Filename(unsigned int num)
+{
+    return utf8_to_path("_atlas_" + int_to_string(num) + ".png");
+}
+
+/* *** *** *** *** *** cAtlas_Builder *** *** *** *** *** *** *** *** *** *** *** *** */
+
+cAtlas_Builder::cAtlas_Builder(int page_size)
+    : m_page_size(page_size)
+{
+    //
+}
+
+cAtlas_Builder::~cAtlas_Builder(void)
+{
+    for (Image_Entry_List::iterator itr = m_images.begin(); itr != m_images.end(); ++itr) {
+        delete itr->m_image;
+    }
+}
+
+bool cAtlas_Builder::Add(const std::string& name, sf::Image* texture_image, int width, int height)
+{
+    const sf::Vector2u size = texture_image->getSize();
+
+    if (static_cast<int>(size.x) > m_max_image_size || static_cast<int>(size.y) > m_max_image_size) {
+        return 0;
+    }
+
+    // one pixel border around every image
+    if (static_cast<int>(size.x) + 2 > m_page_size || static_cast<int>(size.y) + 2 > m_page_size) {
+        return 0;
+    }
+
+    Image_Entry entry;
+    entry.m_name = name;
+    entry.m_image = texture_image;
+    entry.m_width = width;
+    entry.m_height = height;
+    entry.m_page = 0;
+    entry.m_x = 0;
+    entry.m_y = 0;
+
+    m_images.push_back(entry);
+    return 1;
+}
+
+void cAtlas_Builder::Save(const fs::path& directory)
+{
+    // a single image does not save any texture bind
+    if (m_images.size() < 2) {
+        return;
+    }
+
+    std::stable_sort(m_images.begin(), m_images.end(), height_sort());
+
+    // used size of every page
+    vector<cSize_Int> page_sizes(1);
+    // shelf packing
+    int pos_x = 0;
+    int pos_y = 0;
+    int row_height = 0;
+
+    for (Image_Entry_List::iterator itr = m_images.begin(); itr != m_images.end(); ++itr) {
+        // with a one pixel border copied from the image edge against filtering bleed
+        const int cell_w = itr->m_image->getSize().x + 2;
+        const int cell_h = itr->m_image->getSize().y + 2;
+
+        // next row
+        if (pos_x + cell_w > m_page_size) {
+            pos_x = 0;
+            pos_y += row_height;
+            row_height = 0;
+        }
+        // next page
+        if (pos_y + cell_h > m_page_size) {
+            page_sizes.push_back(cSize_Int());
+            pos_x = 0;
+            pos_y = 0;
+            row_height = 0;
+        }
+
+        itr->m_page = page_sizes.size() - 1;
+        itr->m_x = pos_x + 1;
+        itr->m_y = pos_y + 1;
+
+        pos_x += cell_w;
+        row_height = std::max(row_height, cell_h);
+
+        cSize_Int& page_size = page_sizes.back();
+        page_size.m_width = std::max(page_size.m_width, pos_x);
+        page_size.m_height = std::max(page_size.m_height, pos_y + row_height);
+    }
+
+    // save pages
+    for (unsigned int page = 0; page < page_sizes.size(); page++) {
+        const unsigned int page_w = Get_Power_of_2(page_sizes[page].m_width);
+        const unsigned int page_h = Get_Power_of_2(page_sizes[page].m_height);
+        vector<unsigned char> pixels(page_w * page_h * 4, 0);
+
+        for (Image_Entry_List::const_iterator itr = m_images.begin(); itr != m_images.end(); ++itr) {
+            if (itr->m_page != page) {
+                continue;
+            }
+
+            const unsigned char* src = static_cast<const unsigned char*>(itr->m_image->getPixelsPtr());
+            const int src_w = itr->m_image->getSize().x;
+            const int src_h = itr->m_image->getSize().y;
+
+            // including the border
+            for (int y = -1; y <= src_h; y++) {
+                const int src_y = std::min(std::max(y, 0), src_h - 1);
+
+                for (int x = -1; x <= src_w; x++) {
+                    const int src_x = std::min(std::max(x, 0), src_w - 1);
+                    memcpy(&pixels[((itr->m_y + y) * page_w + (itr->m_x + x)) * 4], &src[(src_y * src_w + src_x) * 4], 4);
+                }
+            }
+        }
+
+        pVideo->Save_Surface(directory / Get_Atlas_Page_Filename(page), &pixels[0], page_w, page_h);
+    }
+
+    // save table
+    fs::ofstream ofs(directory / utf8_to_path(atlas_table_filename), ios::out | ios::trunc);
+
+    if (!ofs) {
+        cerr << "Warning: cAtlas_Builder :: Save : Could not create texture atlas table in " << path_to_utf8(directory) << endl;
+        return;
+    }
+
+    ofs << "# page x y texture_w texture_h width height filename" << endl;
+
+    for (Image_Entry_List::const_iterator itr = m_images.begin(); itr != m_images.end(); ++itr) {
+        ofs << itr->m_page << " " << itr->m_x << " " << itr->m_y << " " << itr->m_image->getSize().x << " " << itr->m_image->getSize().y << " "
+            << itr->m_width << " " << itr->m_height << " " << itr->m_name << endl;
+    }
+}
+
+/* *** *** *** *** *** cTexture_Atlas *** *** *** *** *** *** *** *** *** *** *** *** */
+
+cTexture_Atlas::cTexture_Atlas(void)
+    : cFile_parser()
+{
+    m_parse_directory = NULL;
+}
+
+cTexture_Atlas::~cTexture_Atlas(void)
+{
+    Clear();
+}
+
+cGL_Surface* cTexture_Atlas::Load_Surface(const fs::path& filename)
+{
+    // the pages are only created with the image cache
+    if (!pPreferences->m_image_cache_enabled) {
+        return NULL;
+    }
+
+    // the pages have the full texture detail, lower detail further reduces the image size
+    if (pVideo->m_texture_quality < 0.25f) {
+        return NULL;
+    }
+
+    // only game pixmaps are cached
+    fs::path rel = fs_relative(pResource_Manager->Get_Game_Data_Directory(), filename);
+
+    if (rel.begin() == rel.end() || *(rel.begin()) == fs::path("..")) {
+        return NULL;
+    }
+
+    const fs::path directory = pVideo->m_imgcache_dir / rel.parent_path();
+    Directory_Map::iterator dir_itr = m_directories.find(directory);
+
+    // read the table on first use
+    if (dir_itr == m_directories.end()) {
+        dir_itr = m_directories.insert(Directory_Map::value_type(directory, Directory())).first;
+        const fs::path table_filename = directory / utf8_to_path(atlas_table_filename);
+
+        if (File_Exists(table_filename)) {
+            m_parse_directory = &dir_itr->second;
+            Parse(table_filename);
+            m_parse_directory = NULL;
+        }
+    }
+
+    Directory& dir = dir_itr->second;
+    Entry_Map::const_iterator entry_itr = dir.m_entries.find(path_to_utf8(rel.filename()));
+
+    // has its own texture
+    if (entry_itr == dir.m_entries.end()) {
+        return NULL;
+    }
+
+    const Entry& entry = entry_itr->second;
+    Page& page = dir.m_pages[entry.m_page];
+
+    if (!Load_Page(directory, page, entry.m_page)) {
+        return NULL;
+    }
+
+    cGL_Surface* image = new cGL_Surface();
+    image->m_image = page.m_texture;
+    // the page is shared with the other images on it
+    image->m_atlas = 1;
+    image->m_auto_del_img = 0;
+    image->m_tex_w = entry.m_w;
+    image->m_tex_h = entry.m_h;
+    image->m_tex_x1 = static_cast<float>(entry.m_x) / static_cast<float>(page.m_w);
+    image->m_tex_y1 = static_cast<float>(entry.m_y) / static_cast<float>(page.m_h);
+    image->m_tex_x2 = static_cast<float>(entry.m_x + entry.m_w) / static_cast<float>(page.m_w);
+    image->m_tex_y2 = static_cast<float>(entry.m_y + entry.m_h) / static_cast<float>(page.m_h);
+    image->m_start_w = static_cast<float>(entry.m_width);
+    image->m_start_h = static_cast<float>(entry.m_height);
+    image->m_w = image->m_start_w;
+    image->m_h = image->m_start_h;
+    image->m_col_w = image->m_w;
+    image->m_col_h = image->m_h;
+
+    return image;
+}
+
+void cTexture_Atlas::Clear(void)
+{
+    pVideo->Render_Finish();
+
+    for (Directory_Map::iterator dir_itr = m_directories.begin(); dir_itr != m_directories.end(); ++dir_itr) {
+        Page_List& pages = dir_itr->second.m_pages;
+
+        for (Page_List::iterator itr = pages.begin(); itr != pages.end(); ++itr) {
+            if (itr->m_texture && glIsTexture(itr->m_texture)) {
+                glDeleteTextures(1, &itr->m_texture);
+            }
+        }
+    }
+
+    m_directories.clear();
+}
+
+bool cTexture_Atlas::HandleMessage(const std::string* parts, unsigned int count, unsigned int line)
+{
+    if (count < 8) {
+        cerr << "Warning: cTexture_Atlas : Invalid line " << line << " in " << path_to_utf8(data_file) << endl;
+        return 0;
+    }
+
+    Entry entry;
+    entry.m_page = string_to_int(parts[0]);
+    entry.m_x = string_to_int(parts[1]);
+    entry.m_y = string_to_int(parts[2]);
+    entry.m_w = string_to_int(parts[3]);
+    entry.m_h = string_to_int(parts[4]);
+    entry.m_width = string_to_int(parts[5]);
+    entry.m_height = string_to_int(parts[6]);
+
+    // the file name may contain spaces
+    std::string name = parts[7];
+
+    for (unsigned int i = 8; i < count; i++) {
+        name += " " + parts[i];
+    }
+
+    if (entry.m_page >= m_parse_directory->m_pages.size()) {
+        Page page;
+        page.m_texture = 0;
+        page.m_w = 0;
+        page.m_h = 0;
+        m_parse_directory->m_pages.resize(entry.m_page + 1, page);
+    }
+
+    m_parse_directory->m_entries[name] = entry;
+    return 1;
+}
+
+bool cTexture_Atlas::Load_Page(const fs::path& directory, Page& page, unsigned int num)
+{
+    if (page.m_texture) {
+        return 1;
+    }
+
+    sf::Image image;
+
+    if (!image.loadFromFile(path_to_utf8(directory / Get_Atlas_Page_Filename(num)))) {
+        cerr << "Warning: cTexture_Atlas : Could not load page " << num << " in " << path_to_utf8(directory) << endl;
+        return 0;
+    }
+
+    pVideo->Render_Finish();
+
+    GLuint image_num = 0;
+    glGenTextures(1, &image_num);
+
+    // if image id is 0 it failed
+    if (!image_num) {
+        cerr << "Error : GL image generation failed" << endl;
+        return 0;
+    }
+
+    // set highest texture id
+    if (pImage_Manager->m_high_texture_id < image_num) {
+        pImage_Manager->m_high_texture_id = image_num;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, image_num);
+    // same settings as cVideo::Create_Texture() without mipmaps
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    pVideo->Create_GL_Texture(image.getSize().x, image.getSize().y, image.getPixelsPtr());
+
+    page.m_texture = image_num;
+    page.m_w = image.getSize().x;
+    page.m_h = image.getSize().y;
+
+    return 1;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+cTexture_Atlas* pTexture_Atlas = NULL;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
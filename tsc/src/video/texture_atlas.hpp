@@ -0,0 +1,146 @@
+/***************************************************************************
+ * texture_atlas.h  -  Image cache texture atlas pages
+ *
+ * Copyright © 2014 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_TEXTURE_ATLAS_HPP
+#define TSC_TEXTURE_ATLAS_HPP
+
+#include "../core/global_basic.hpp"
+#include "../core/global_game.hpp"
+#include "../core/file_parser.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** cAtlas_Builder *** *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Packs the texture images of the pixmaps of one directory into
+     * atlas pages while building the image cache. The pages are saved
+     * next to the cached images together with a table of the position
+     * of every image, which cTexture_Atlas reads when loading them.
+     */
+    class cAtlas_Builder {
+    public:
+        // page_size : width and maximum height of a page
+        cAtlas_Builder(int page_size);
+        ~cAtlas_Builder(void);
+
+        /* Add the final texture image of the pixmap with the given file name
+         * width/height : drawing size of the surface as set by cVideo::Create_Texture()
+         * takes over the image if added, returns false if it is too large for the pages
+        */
+        bool Add(const std::string& name, sf::Image* texture_image, int width, int height);
+        // Pack the added images and save the pages and the table into the given cache directory
+        void Save(const boost::filesystem::path& directory);
+
+        // only images up to this size in both dimensions are packed
+        static const int m_max_image_size = 256;
+
+    private:
+        struct Image_Entry {
+            std::string m_name;
+            sf::Image* m_image;
+            // drawing size
+            int m_width;
+            int m_height;
+            // position in the pages
+            unsigned int m_page;
+            int m_x;
+            int m_y;
+        };
+        typedef vector<Image_Entry> Image_Entry_List;
+
+        // Sort by height with the highest first
+        struct height_sort {
+            bool operator()(const Image_Entry& a, const Image_Entry& b) const
+            {
+                return a.m_image->getSize().y > b.m_image->getSize().y;
+            }
+        };
+
+        const int m_page_size;
+        Image_Entry_List m_images;
+    };
+
+    /* *** *** *** *** *** cTexture_Atlas *** *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Loads surfaces from the atlas pages of the active image cache
+     * The table of a directory is read on first use and every page is
+     * uploaded once and shared by all surfaces on it, so drawing them
+     * does not need a texture bind in between.
+     */
+    class cTexture_Atlas : public cFile_parser {
+    public:
+        cTexture_Atlas(void);
+        virtual ~cTexture_Atlas(void);
+
+        /* Return a new surface for the given pixmap if it is in an atlas page
+         * the image settings are not applied
+         * returns NULL if the pixmap has its own texture
+        */
+        cGL_Surface* Load_Surface(const boost::filesystem::path& filename);
+
+        // Delete all pages and forget the tables
+        void Clear(void);
+
+        // Handle one line of a table
+        virtual bool HandleMessage(const std::string* parts, unsigned int count, unsigned int line);
+
+    private:
+        // image in a page
+        struct Entry {
+            unsigned int m_page;
+            int m_x;
+            int m_y;
+            // texture size
+            int m_w;
+            int m_h;
+            // drawing size
+            int m_width;
+            int m_height;
+        };
+        typedef std::unordered_map<std::string, Entry> Entry_Map;
+
+        struct Page {
+            // texture or 0 if not loaded
+            GLuint m_texture;
+            unsigned int m_w;
+            unsigned int m_h;
+        };
+        typedef vector<Page> Page_List;
+
+        // atlas of one cache directory
+        struct Directory {
+            Entry_Map m_entries;
+            Page_List m_pages;
+        };
+        typedef std::map<boost::filesystem::path, Directory> Directory_Map;
+
+        // Upload the given page if not loaded and return if available
+        bool Load_Page(const boost::filesystem::path& directory, Page& page, unsigned int num);
+
+        Directory_Map m_directories;
+        // directory filled by the table parser
+        Directory* m_parse_directory;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// Texture atlas pages of the image cache
+    extern cTexture_Atlas* pTexture_Atlas;
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
@@ -32,6 +32,8 @@
 #include "../core/filesystem/package_manager.hpp"
 #include "../core/filesystem/relative.hpp"
 #include "../gui/spinner.hpp"
+#include "../video/texture_atlas.hpp"
+#include "../video/particle_kernels.hpp"
 #include "../core/global_basic.hpp"
 
 using namespace std;
@@ -65,12 +67,16 @@ cVideo::cVideo(void)
     glx_context = NULL;
 #endif
     m_render_thread = boost::thread();
+    m_render_queue = NULL;
+    m_render_quit = 0;
 
     m_initialised = 0;
 }
 
 cVideo::~cVideo(void)
 {
+    Render_Thread_Stop();
+
     if (mp_window) {
         delete mp_window;
         mp_window = NULL;
@@ -321,6 +327,8 @@ void cVideo::Init_Video(bool reload_textures_from_file /* = false */, bool use_p
 
         }
 
+        debug_print("Particle kernels use %s\n", Get_Particle_Kernel_Name());
+
         m_initialised = 1;
     }
 }
@@ -448,6 +456,9 @@ void cVideo::Init_Resolution_Scale(void) const
 
 void cVideo::Init_Image_Cache(bool recreate /* = 0 */, bool draw_gui /* = 0 */)
 {
+    // the atlas pages may be recreated
+    pTexture_Atlas->Clear();
+
     m_imgcache_dir = pResource_Manager->Get_User_Imgcache_Directory();
     fs::path imgcache_dir_active = m_imgcache_dir / utf8_to_path(int_to_string(pPreferences->m_video_screen_w) + "x" + int_to_string(pPreferences->m_video_screen_h));
 
@@ -641,10 +652,78 @@ void cVideo::Init_Image_Cache(bool recreate /* = 0 */, bool draw_gui /* = 0 */)
         }
     }
 
-    // set back texture detail
-    m_texture_quality = real_texture_detail;
     // set directory after surfaces got loaded from Load_GL_Surface()
     m_imgcache_dir = imgcache_dir_active;
+
+    // pack the cached images
+    if (draw_gui) {
+        Loading_Screen_Draw_Text(_("Packing Images"));
+    }
+
+    Init_Texture_Atlas(image_files);
+
+    // set back texture detail
+    m_texture_quality = real_texture_detail;
+}
+
+void cVideo::Init_Texture_Atlas(const vector<fs::path>& settings_files)
+{
+    typedef std::map<fs::path, vector<fs::path> > Directory_Files_Map;
+    Directory_Files_Map directories;
+
+    // group by directory
+    for (vector<fs::path>::const_iterator itr = settings_files.begin(); itr != settings_files.end(); ++itr) {
+        if (itr->extension() != fs::path(".settings")) {
+            continue;
+        }
+
+        directories[itr->parent_path()].push_back(*itr);
+    }
+
+    // at most 1024 pixels
+    int page_size = 1024;
+    int page_size_h = 1024;
+    Apply_Max_Texture_Size(page_size, page_size_h);
+    page_size = std::min(page_size, page_size_h);
+
+    for (Directory_Files_Map::const_iterator dir_itr = directories.begin(); dir_itr != directories.end(); ++dir_itr) {
+        cAtlas_Builder builder(page_size);
+
+        for (vector<fs::path>::const_iterator itr = dir_itr->second.begin(); itr != dir_itr->second.end(); ++itr) {
+            fs::path filename = (*itr);
+            filename.replace_extension(".png");
+
+            // load the software image like Load_GL_Surface() from the new cache
+            cSoftware_Image software_image = Load_Image(filename, 1, 0);
+            sf::Image* p_sf_image = software_image.m_sf_image;
+            cImage_Settings_Data* settings = software_image.m_settings;
+
+            if (!p_sf_image) {
+                continue;
+            }
+
+            // only images with a fixed size and without mipmaps as these would blend the neighbours
+            if (!settings || !settings->m_width || !settings->m_height || settings->m_mipmap) {
+                delete settings;
+                delete p_sf_image;
+                continue;
+            }
+
+            cSize_Int size = settings->Get_Surface_Size(p_sf_image);
+            delete settings;
+            Apply_Max_Texture_Size(size.m_width, size.m_height);
+
+            int width = 0;
+            int height = 0;
+            p_sf_image = Create_Texture_Image(p_sf_image, size.m_width, size.m_height, width, height);
+
+            if (!builder.Add(path_to_utf8(filename.filename()), p_sf_image, width, height)) {
+                delete p_sf_image;
+            }
+        }
+
+        builder.Save(m_imgcache_dir / fs_relative(pResource_Manager->Get_Game_Data_Directory(), dir_itr->first));
+    }
 }
 
 int cVideo::Test_Video(int width, int height, int bpp, int flags /* = 0 */) const
@@ -676,51 +755,12 @@ vector<cSize_Int> cVideo::Get_Supported_Resolutions(int flags /* = 0 */) const
     return valid_resolutions;
 }
 
-void cVideo::Make_GL_Context_Current(void)
-{
-    // scoped context lock here
-#ifdef _WIN32
-    if (wglGetCurrentContext() != wm_info.hglrc) {
-        wglMakeCurrent(GetDC(wm_info.window), wm_info.hglrc);
-    }
-#elif __unix__
-    if (glx_context != NULL) {
-        // OLD glXMakeCurrent(wm_info.info.x11.gfxdisplay, wm_info.info.x11.window, glx_context);
-    }
-#elif __APPLE__
-    // party time
-#endif
-}
-
-void cVideo::Make_GL_Context_Inactive(void)
-{
-#ifdef _WIN32
-    wglMakeCurrent(NULL, NULL);
-#elif __unix__
-    // OLD glXMakeCurrent(wm_info.info.x11.gfxdisplay, None, NULL);
-#elif __APPLE__
-    // party time
-#endif
-}
-
-void cVideo::Render_From_Thread(void)
-{
-    Make_GL_Context_Current();
-
-    pRenderer_current->Render();
-    // under linux with sofware mesa 7.9 it only showed the rendered output with SDL_GL_SwapBuffers()
-
-    // update performance timer
-    //pFramerate->m_perf_timer[PERF_RENDER_GAME]->Update();
-
-    Make_GL_Context_Inactive();
-}
-
 void cVideo::Render(bool threaded /* = 0 */)
 {
     Render_Finish();
 
     if (threaded) {
+        // drawn above the game queue of the previous frame rendered by the thread
         pGuiSystem->renderGUI();
 
         // update performance timer
@@ -737,18 +777,30 @@ void cVideo::Render(bool threaded /* = 0 */)
         pRenderer_current = new_render;
 
         // move objects that should render more than once
-        if (!pRenderer->m_render_data.empty()) {
-            pRenderer_current->m_render_data.insert(pRenderer_current->m_render_data.begin(), pRenderer->m_render_data.begin(), pRenderer->m_render_data.end());
-            pRenderer->m_render_data.clear();
+        pRenderer_current->Take_Over(*pRenderer);
+        // the camera moves while the frame is rendered
+        pRenderer_current->Capture_Camera();
+
+        if (!m_render_thread.joinable()) {
+            m_render_quit = 0;
+            m_render_thread = boost::thread(&cVideo::Render_Thread_Loop, this);
+        }
+
+        // hand over the context and the frame
+        mp_window->setActive(false);
+
+        {
+            boost::lock_guard<boost::mutex> lock(m_render_mutex);
+            m_render_queue = pRenderer_current;
         }
 
-        // make main thread inactive
-        Make_GL_Context_Inactive();
-        // start render thread
-        m_render_thread = boost::thread(&cVideo::Render_From_Thread, this);
+        m_render_cond.notify_all();
     }
     // single thread mode
     else {
+        // objects left from thread rendering that should render more than once
+        pRenderer->Take_Over(*pRenderer_current);
+
         pRenderer->Render();
 
         // update performance timer
@@ -768,15 +820,72 @@ void cVideo::Render(bool threaded /* = 0 */)
 
 void cVideo::Render_Finish(void)
 {
-#ifndef TSC_RENDER_THREAD_TEST
-    return;
-#endif
-    if (m_render_thread.joinable()) {
-        m_render_thread.join();
+    // the render thread never waits for itself
+    if (!m_render_thread.joinable() || boost::this_thread::get_id() == m_render_thread.get_id()) {
+        return;
+    }
+
+    {
+        boost::unique_lock<boost::mutex> lock(m_render_mutex);
+
+        while (m_render_queue) {
+            m_render_cond.wait(lock);
+        }
     }
 
-    // todo : use opengl in only one thread
-    Make_GL_Context_Current();
+    // take back the context released by the render thread
+    mp_window->setActive(true);
+}
+
+void cVideo::Render_Thread_Stop(void)
+{
+    if (!m_render_thread.joinable()) {
+        return;
+    }
+
+    Render_Finish();
+
+    {
+        boost::lock_guard<boost::mutex> lock(m_render_mutex);
+        m_render_quit = 1;
+    }
+
+    m_render_cond.notify_all();
+    m_render_thread.join();
+    m_render_thread = boost::thread();
+}
+
+void cVideo::Render_Thread_Loop(void)
+{
+    while (1) {
+        cRenderQueue* queue = NULL;
+
+        {
+            boost::unique_lock<boost::mutex> lock(m_render_mutex);
+
+            while (!m_render_quit && !m_render_queue) {
+                m_render_cond.wait(lock);
+            }
+
+            if (m_render_quit) {
+                return;
+            }
+
+            queue = m_render_queue;
+        }
+
+        mp_window->setActive(true);
+        queue->Render();
+        // the main thread takes the context back to draw the GUI and swap the buffers
+        mp_window->setActive(false);
+
+        {
+            boost::lock_guard<boost::mutex> lock(m_render_mutex);
+            m_render_queue = NULL;
+        }
+
+        m_render_cond.notify_all();
+    }
 }
 
 void cVideo::Toggle_Fullscreen(void)
@@ -969,14 +1078,32 @@ cGL_Surface* cVideo :: Load_GL_Surface_Helper(boost::filesystem::path filename,
         }
     }
 
+    // final surface
+    cGL_Surface* image = NULL;
+
+    // on a texture atlas page
+    if (use_settings) {
+        image = pTexture_Atlas->Load_Surface(filename);
+
+        if (image) {
+            // only images with settings are packed
+            fs::path settings_file = filename;
+            settings_file.replace_extension(".settings");
+
+            cImage_Settings_Data* settings = pSettingsParser->Get(settings_file);
+            settings->Apply(image);
+            delete settings;
+
+            image->m_path = filename;
+            return image;
+        }
+    }
+
     // load software image
     cSoftware_Image software_image = Load_Image_Helper(filename, use_settings, print_errors, package);
     sf::Image* p_sf_image = software_image.m_sf_image;
     cImage_Settings_Data* settings = software_image.m_settings;
 
-    // final surface
-    cGL_Surface* image = NULL;
-
     // with settings
     if (settings) {
         // get the size
@@ -1034,38 +1161,13 @@ sf::Image* cVideo::Convert_To_Final_Software_Image(sf::Image* p_sf_image) const
     return p_sf_image;
 }
 
-cGL_Surface* cVideo::Create_Texture(sf::Image* p_sf_image, bool mipmap /* = 0 */, unsigned int force_width /* = 0 */, unsigned int force_height /* = 0 */) const
+sf::Image* cVideo::Create_Texture_Image(sf::Image* p_sf_image, unsigned int force_width, unsigned int force_height, int& width, int& height) const
 {
-    if (!p_sf_image) {
-        return NULL;
-    }
-
     // create final image
     p_sf_image = Convert_To_Final_Software_Image(p_sf_image);
 
-    /* todo : Make this a render request because it forces an early thread render finish as opengl commands are used directly.
-     * Reduces performance if the render thread is on. It's usually called from the text rendering in cTimeDisplay::Update.
-    */
-    pVideo->Render_Finish();
-
-    // create one texture
-    GLuint image_num = 0;
-    glGenTextures(1, &image_num);
-
-    // if image id is 0 it failed
-    if (!image_num) {
-        cerr << "Error : GL image generation failed" << endl;
-        delete p_sf_image;
-        return NULL;
-    }
-
-    // set highest texture id
-    if (pImage_Manager->m_high_texture_id < image_num) {
-        pImage_Manager->m_high_texture_id = image_num;
-    }
-
-    int width = p_sf_image->getSize().x;
-    int height = p_sf_image->getSize().y;
+    width = p_sf_image->getSize().x;
+    height = p_sf_image->getSize().y;
 
     // forced size is set
     if (force_width > 0 && force_height > 0) {
@@ -1104,6 +1206,43 @@ cGL_Surface* cVideo::Create_Texture(sf::Image* p_sf_image, bool mipmap /* = 0 */
         free(new_pixels);
     }
 
+    return p_sf_image;
+}
+
+cGL_Surface* cVideo::Create_Texture(sf::Image* p_sf_image, bool mipmap /* = 0 */, unsigned int force_width /* = 0 */, unsigned int force_height /* = 0 */) const
+{
+    if (!p_sf_image) {
+        return NULL;
+    }
+
+    int width = 0;
+    int height = 0;
+    // create final image
+    p_sf_image = Create_Texture_Image(p_sf_image, force_width, force_height, width, height);
+    const int texture_width = p_sf_image->getSize().x;
+    const int texture_height = p_sf_image->getSize().y;
+
+    /* todo : Make this a render request because it forces an early thread render finish as opengl commands are used directly.
+     * Reduces performance if the render thread is on. It's usually called from the text rendering in cTimeDisplay::Update.
+    */
+    pVideo->Render_Finish();
+
+    // create one texture
+    GLuint image_num = 0;
+    glGenTextures(1, &image_num);
+
+    // if image id is 0 it failed
+    if (!image_num) {
+        cerr << "Error : GL image generation failed" << endl;
+        delete p_sf_image;
+        return NULL;
+    }
+
+    // set highest texture id
+    if (pImage_Manager->m_high_texture_id < image_num) {
+        pImage_Manager->m_high_texture_id = image_num;
+    }
+
     // use the generated texture
     glBindTexture(GL_TEXTURE_2D, image_num);
 
@@ -1177,6 +1316,8 @@ void cVideo::Create_GL_Texture(unsigned int width, unsigned int height, const vo
 
 Color cVideo::Get_Pixel(int x, int y) const
 {
+    pVideo->Render_Finish();
+
     GLubyte* pixel = new GLubyte[3];
     // read it
     glReadPixels(x, y, 1, 1, GL_RGB, GL_UNSIGNED_BYTE, pixel);
@@ -2088,6 +2229,7 @@ void Loading_Screen_Draw(void)
     pVideo->Draw_Rect(NULL, 0.00001f, &black);
 
     // Render
+    pVideo->Render_Finish();
     pRenderer->Render();
     pGuiSystem->renderGUI();
     pVideo->mp_window->display();
@@ -78,6 +78,11 @@ namespace TSC {
          * draw_gui : if set use the loading screen gui for drawing
         */
         void Init_Image_Cache(bool recreate = 0, bool draw_gui = 0);
+        /* Pack the small images of every pixmaps directory into texture atlas pages
+         * must be called with the new image cache directory set
+         * settings_files : the image settings files of the pixmaps directory
+        */
+        void Init_Texture_Atlas(const vector<boost::filesystem::path>& settings_files);
 
         /* Test if the given resolution and bits per pixel are valid
          * if flags aren't set they are auto set from the preferences
@@ -91,17 +96,20 @@ namespace TSC {
         */
         vector<cSize_Int> Get_Supported_Resolutions(int flags = 0) const;
 
-        // make the opengl context active for the current thread
-        void Make_GL_Context_Current(void);
-        // make the opengl context inactive for the current thread
-        void Make_GL_Context_Inactive(void);
-
-        // Render. Should be called from a thread
-        void Render_From_Thread(void);
-        // Render game, GUI and swap the opengl buffer
+        /* Render game, GUI and swap the opengl buffer
+         * threaded : if set the game queue is handed over to the render thread
+         * and drawn while the next frame is updated, the GUI and the buffer swap
+         * of this frame then show the game queue of the previous frame
+        */
         void Render(bool threaded = 0);
-        // Finish thread rendering
+        /* Wait until the render thread finished its frame and make the
+         * opengl context current for the calling thread
+         * must be called before using opengl outside of the render queue
+         * does nothing if called from the render thread
+        */
         void Render_Finish(void);
+        // Finish and stop the render thread
+        void Render_Thread_Stop(void);
 
         // Toggle fullscreen video mode ( new mode is set to preferences )
         void Toggle_Fullscreen(void);
@@ -153,6 +161,13 @@ namespace TSC {
         */
         sf::Image* Convert_To_Final_Software_Image(sf::Image* p_sf_image) const;
 
+        /* Return the software image as uploaded by Create_Texture()
+         * surface : the source SFML image which will be auto-deleted.
+         * force_width/height : force the given width and height
+         * width/height : set to the drawing size
+        */
+        sf::Image* Create_Texture_Image(sf::Image* p_sf_image, unsigned int force_width, unsigned int force_height, int& width, int& height) const;
+
         /* Convert an SFML image to a GL image
          * surface : the source SFML image which will be auto-deleted.
          * mipmap : create texture mipmaps
@@ -242,8 +257,18 @@ namespace TSC {
         boost::thread m_render_thread;
 
     private:
+        // Render the handed over queues until stopped, runs in the render thread
+        void Render_Thread_Loop(void);
+
         // if set video is initialized successfully
         bool m_initialised;
+
+        boost::mutex m_render_mutex;
+        // signals a handed over queue or stopping to the render thread and a finished frame back
+        boost::condition_variable m_render_cond;
+        // queue handed over to the render thread or NULL if it is idle
+        cRenderQueue* m_render_queue;
+        bool m_render_quit;
     };
 
     /* Draw an Screen Fadeout Effect